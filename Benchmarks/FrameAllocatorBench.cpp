@@ -0,0 +1,107 @@
+// Heap allocations and time per simulated frame, general heap vs. FrameAllocator.
+//
+//   FrameAllocatorBench [frames]
+//
+// A frame records uniform names longer than the small-string buffer, builds a
+// visibility list and a few scratch strings, like the renderer and layers do.
+
+#include "Hazel/Core/Log.h"
+#include "Hazel/Core/FrameAllocator.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace Hazel;
+
+// Counted here rather than through HZ_TRACK_HEAP_ALLOCATIONS so the bench works in any build
+static std::atomic<uint64_t> s_Allocations{ 0 };
+
+void* operator new(size_t size)
+{
+    s_Allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+
+static const uint32_t s_ObjectCount = 2000;
+static const char* s_UniformNames[] = { "u_ViewProjection", "u_CrossSectionColor", "u_EnableClipping", "u_ShowCrossSection" };
+
+static volatile size_t s_Sink = 0;
+
+static void HeapFrame()
+{
+    std::vector<std::string> uniforms;
+    std::vector<uint32_t> visible;
+    for (uint32_t i = 0; i < s_ObjectCount; i++)
+    {
+        if (i % 3 != 0)
+            visible.push_back(i);
+        for (const char* name : s_UniformNames)
+            uniforms.push_back(name);
+    }
+
+    std::string label = "Frame statistics: " + std::to_string(visible.size()) + " visible objects";
+    s_Sink = s_Sink + uniforms.size() + label.size();
+}
+
+static void ArenaFrame()
+{
+    FrameVector<const char*> uniforms;
+    uniforms.reserve(s_ObjectCount * 4);
+    FrameVector<uint32_t> visible;
+    visible.reserve(s_ObjectCount);
+    for (uint32_t i = 0; i < s_ObjectCount; i++)
+    {
+        if (i % 3 != 0)
+            visible.push_back(i);
+        for (const char* name : s_UniformNames)
+            uniforms.push_back(FrameAllocator::CopyString(name));
+    }
+
+    FrameString label("Frame statistics: ");
+    label += std::to_string(visible.size()).c_str();
+    label += " visible objects";
+    s_Sink = s_Sink + uniforms.size() + label.size();
+
+    FrameAllocator::NextFrame();
+}
+
+static void Run(const char* name, void (*frame)(), uint32_t frames)
+{
+    // Warm up, so arena blocks are already allocated
+    for (int i = 0; i < 4; i++)
+        frame();
+
+    uint64_t allocations = s_Allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < frames; i++)
+        frame();
+    auto end = std::chrono::steady_clock::now();
+    allocations = s_Allocations.load() - allocations;
+
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    printf("%-14s %14.1f %14.4f\n", name, (double)allocations / frames, ms / frames);
+}
+
+int main(int argc, char** argv)
+{
+    Log::Init();
+
+    uint32_t frames = 1000;
+    if (argc > 1)
+        frames = (uint32_t)std::max(1, std::atoi(argv[1]));
+
+    printf("%-14s %14s %14s\n", "", "allocs/frame", "ms/frame");
+    Run("heap", HeapFrame, frames);
+    Run("frame arena", ArenaFrame, frames);
+    Log::Shutdown();
+    return 0;
+}
@@ -0,0 +1,861 @@
+// Scripted rendering scenarios on an offscreen context, writing frame-time distributions and
+// renderer counters as JSON so runs can be compared across commits.
+//
+//   HazelBench [--out results.json] [--frames N] [--warmup N] [--size WxH]
+//              [--quads N,N,...] [--mesh-segments N] [--scenario name]
+//              [--context native|egl|osmesa] [--api opengl|none] [--threaded]
+//   HazelBench --check [--threaded]
+//
+// Without a display (no DISPLAY / WAYLAND_DISPLAY) GLFW runs on its null platform and the
+// context comes from EGL, on the GPU if there is one, or failing that from OSMesa (Mesa
+// llvmpipe, on the CPU). The log names the renderer. Timesteps and input are scripted, so
+// every run records the same work and only the timings differ.
+//
+// --api none runs the scenarios on the recording backend (no GPU, CPU-side renderer cost only).
+// --check runs a quad grid there and verifies the recorded draws, binds and uniforms, returning
+// nonzero on a mismatch.
+//
+// The scenarios mirror the Sandbox layers (ExampleLayer quad grid, BrushLayer stroke,
+// CrossSectionLayer) with their input replaced by a script.
+
+#include "Hazel/Core/Log.h"
+#include "Hazel/Core/JobSystem.h"
+#include "Hazel/Core/Layer.h"
+#include "Hazel/Debug/FrameStatsRecorder.h"
+#include "Hazel/Core/Window.h"
+#include "Hazel/Renderer/GraphicsContext.h"
+#include "Hazel/Platform/Recording/RecordingRendererAPI.h"
+#include "Hazel/Platform/Recording/RecordingShader.h"
+#include "Hazel/Platform/Recording/RecordingVertexArray.h"
+#include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/RenderCommand.h"
+#include "Hazel/Renderer/GpuProfiler.h"
+#include "Hazel/Renderer/TiledCanvas.h"
+#include "Hazel/Renderer/CanvasHistory.h"
+#include "Hazel/Renderer/CanvasBrush.h"
+#include "Hazel/Renderer/OrthographicCamera.h"
+#include "Hazel/Renderer/PerspectiveCamera.h"
+#include "Hazel/Scene/Scene.h"
+#include "Hazel/Scene/Entity.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifndef HZ_BENCH_GIT_COMMIT
+    #define HZ_BENCH_GIT_COMMIT "unknown"
+#endif
+
+#ifndef HZ_BENCH_ASSET_DIR
+    #define HZ_BENCH_ASSET_DIR "assets"
+#endif
+
+using namespace Hazel;
+
+// Every scenario advances by the same simulated time per frame, whatever the frame took
+static const float s_FixedTimestep = 1.0f / 60.0f;
+
+struct BenchOptions
+{
+    std::string OutputPath = "HazelBench.json";
+    uint32_t Frames = 600;
+    uint32_t Warmup = 60;
+    uint32_t Width = 1280, Height = 720;
+    std::vector<uint32_t> QuadCounts = { 1000, 10000, 50000 };
+    uint32_t MeshSegments = 512;
+    std::string ScenarioFilter;
+    HeadlessContextAPI ContextAPI = HeadlessContextAPI::Auto;
+    RendererAPI::API API = RendererAPI::API::OpenGL;
+    bool Threaded = false;
+    bool Check = false;
+};
+
+// ---- Scenarios -------------------------------------------------------------
+
+static Ref<VertexArray> CreateQuad(float halfExtent)
+{
+    float vertices[] = {
+        -halfExtent, -halfExtent, 0.0f, 0.0f, 0.0f,
+         halfExtent, -halfExtent, 0.0f, 1.0f, 0.0f,
+         halfExtent,  halfExtent, 0.0f, 1.0f, 1.0f,
+        -halfExtent,  halfExtent, 0.0f, 0.0f, 1.0f
+    };
+    uint32_t indices[] = { 0, 1, 2, 2, 3, 0 };
+
+    Ref<VertexArray> vertexArray = VertexArray::Create();
+    Ref<VertexBuffer> vertexBuffer = VertexBuffer::Create(vertices, sizeof(vertices));
+    vertexBuffer->SetLayout({
+        { ShaderDataType::Float3, "a_Position" },
+        { ShaderDataType::Float2, "a_TexCoord" }
+    });
+    vertexArray->AddVertexBuffer(vertexBuffer);
+    vertexArray->SetIndexBuffer(IndexBuffer::Create(indices, 6));
+    return vertexArray;
+}
+
+// ExampleLayer's flat-colored quad grid, one Scene entity and one draw per quad
+class QuadGridScenario : public Layer
+{
+public:
+    QuadGridScenario(uint32_t quadCount, uint32_t width, uint32_t height)
+        : Layer("QuadGrid/" + std::to_string(quadCount)), m_QuadCount(quadCount),
+          m_Width(width), m_Height(height), m_Camera(-1.0f, 1.0f, -1.0f, 1.0f)
+    {
+    }
+
+    virtual void OnAttach() override
+    {
+        std::string vertexSrc = R"(
+            #version 330 core
+            layout(location = 0) in vec3 a_Position;
+            uniform mat4 u_ViewProjection;
+            uniform mat4 u_Transform;
+            void main()
+            {
+                gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0);
+            }
+        )";
+
+        std::string fragmentSrc = R"(
+            #version 330 core
+            layout(location = 0) out vec4 color;
+            uniform vec3 u_Color;
+            void main()
+            {
+                color = vec4(u_Color, 1.0);
+            }
+        )";
+
+        m_FlatColorShader = Shader::Create("FlatColor", vertexSrc, fragmentSrc);
+
+        m_QuadVA = CreateQuad(0.5f);
+        MeshHandle squareMesh = m_Scene.RegisterMesh(m_QuadVA);
+        ShaderHandle flatColorShader = m_Scene.RegisterShader(m_FlatColorShader);
+
+        uint32_t side = (uint32_t)std::ceil(std::sqrt((double)m_QuadCount));
+        for (uint32_t i = 0; i < m_QuadCount; i++)
+        {
+            Entity square = m_Scene.CreateEntity();
+            auto& transform = square.AddComponent<TransformComponent>();
+            transform.Translation = { (i % side) * 0.11f, (i / side) * 0.11f, 0.0f };
+            transform.Scale = glm::vec3(0.1f);
+            square.AddComponent<MeshRendererComponent>(MeshRendererComponent{ squareMesh, flatColorShader });
+        }
+
+        // Fit the whole grid, keeping the aspect ratio
+        float extent = side * 0.11f;
+        float aspect = (float)m_Width / (float)m_Height;
+        float halfHeight = extent * 0.5f + 0.1f;
+        float halfWidth = std::max(halfHeight * aspect, extent * 0.5f + 0.1f);
+        halfHeight = halfWidth / aspect;
+        m_Camera = OrthographicCamera(-halfWidth, halfWidth, -halfHeight, halfHeight);
+        m_Camera.SetPosition({ extent * 0.5f, extent * 0.5f, 0.0f });
+
+        RenderCommand::SetViewport(0, 0, m_Width, m_Height);
+        RenderCommand::SetDepthTest(false);
+    }
+
+    virtual void OnUpdate(Timestep ts) override
+    {
+        RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
+        RenderCommand::Clear();
+
+        m_Scene.OnUpdate(ts);
+
+        Renderer::BeginScene(m_Camera);
+
+        m_FlatColorShader->Bind();
+        m_FlatColorShader->SetFloat3("u_Color", m_SquareColor);
+
+        m_Scene.OnRender();
+
+        Renderer::EndScene();
+    }
+
+    const Ref<Shader>& GetShader() const { return m_FlatColorShader; }
+    const Ref<VertexArray>& GetQuad() const { return m_QuadVA; }
+private:
+    uint32_t m_QuadCount;
+    uint32_t m_Width, m_Height;
+
+    Scene m_Scene;
+    Ref<Shader> m_FlatColorShader;
+    Ref<VertexArray> m_QuadVA;
+    OrthographicCamera m_Camera;
+    glm::vec3 m_SquareColor = { 0.2f, 0.3f, 0.8f };
+};
+
+// BrushLayer with the mouse replaced by a Lissajous stroke: one capsule segment a frame into
+// the tiled canvas, each stroke an undo step, then the dirty tiles composited to the screen
+class BrushStrokeScenario : public Layer
+{
+public:
+    BrushStrokeScenario(uint32_t width, uint32_t height)
+        : Layer("BrushStroke"), m_Width(width), m_Height(height)
+    {
+    }
+
+    virtual void OnAttach() override
+    {
+        TiledCanvasSpecification canvasSpec;
+        canvasSpec.ResidentMemoryBudget = 128ull << 20;
+        m_Canvas = std::make_unique<TiledCanvas>(canvasSpec);
+        m_History = std::make_unique<CanvasHistory>(*m_Canvas);
+        m_Brush = std::make_unique<CanvasBrush>(*m_Canvas);
+
+        RenderCommand::SetDepthTest(false);
+    }
+
+    virtual void OnDetach() override
+    {
+        if (m_IsDrawing)
+            m_History->EndStep();
+        m_IsDrawing = false;
+
+        m_Brush.reset();
+        m_History.reset();
+        m_Canvas.reset();
+    }
+
+    virtual void OnUpdate(Timestep ts) override
+    {
+        m_Time += ts;
+
+        // Scripted cursor: lifts for a moment every few seconds so the stroke start path runs too
+        bool pressed = std::fmod(m_Time, 3.0f) < 2.8f;
+        float x = m_Width * (0.5f + 0.4f * std::sin(m_Time * 1.3f));
+        float y = m_Height * (0.5f + 0.4f * std::sin(m_Time * 2.1f + 0.5f));
+
+        if (pressed)
+        {
+            glm::dvec2 position = m_Canvas->ViewToCanvas({ x, y });
+            if (!m_IsDrawing)
+            {
+                m_IsDrawing = true;
+                m_History->BeginStep();
+                m_Brush->QueueSegment(position, position, m_BrushSize, m_BrushSpacing, m_BrushColor);
+            }
+            else if (position != m_LastPosition)
+            {
+                m_Brush->QueueSegment(m_LastPosition, position, m_BrushSize, m_BrushSpacing, m_BrushColor);
+            }
+            m_LastPosition = position;
+        }
+        else if (m_IsDrawing)
+        {
+            m_IsDrawing = false;
+            m_History->EndStep();
+        }
+
+        m_Brush->Flush();
+        m_History->Update();
+
+        m_Canvas->Composite(m_Width, m_Height);
+        m_Canvas->Present();
+    }
+private:
+    uint32_t m_Width, m_Height;
+
+    std::unique_ptr<TiledCanvas> m_Canvas;
+    std::unique_ptr<CanvasHistory> m_History; // Destroyed before the canvas
+    std::unique_ptr<CanvasBrush> m_Brush;
+
+    float m_Time = 0.0f;
+    bool m_IsDrawing = false;
+    glm::dvec2 m_LastPosition = { 0.0, 0.0 };
+
+    float m_BrushSize = 25.0f;
+    float m_BrushSpacing = 2.0f;
+    glm::vec3 m_BrushColor = { 0.2f, 0.6f, 1.0f };
+};
+
+// CrossSectionLayer over a generated torus instead of the cube: the clip plane sweeps through
+// the mesh and turns around the Y axis, with the blended plane drawn on top
+class CrossSectionSweepScenario : public Layer
+{
+public:
+    CrossSectionSweepScenario(uint32_t width, uint32_t height, uint32_t segments)
+        : Layer("CrossSectionSweep/" + std::to_string(segments)), m_Width(width), m_Height(height),
+          m_Segments(std::max(8u, segments)), m_Camera(45.0f, (float)width / (float)height, 0.1f, 100.0f)
+    {
+    }
+
+    virtual void OnAttach() override
+    {
+        CreateTorus(m_Segments, m_Segments / 2);
+        m_PlaneVA = CreatePlane();
+
+        m_CrossSectionShader = Shader::Create(HZ_BENCH_ASSET_DIR "/shaders/CrossSection.glsl");
+
+        m_Camera.SetPosition(m_CameraPosition);
+        m_Camera.LookAt(glm::vec3(0.0f));
+
+        RenderCommand::SetViewport(0, 0, m_Width, m_Height);
+        RenderCommand::SetDepthTest(true);
+    }
+
+    virtual void OnDetach() override
+    {
+        RenderCommand::SetDepthTest(false);
+    }
+
+    virtual void OnUpdate(Timestep ts) override
+    {
+        m_Time += ts;
+
+        // Triangle wave through the mesh every 4 seconds, normal turning once every 10
+        float phase = std::fmod(m_Time / 4.0f, 1.0f);
+        float distance = -1.5f + 3.0f * (phase < 0.5f ? phase * 2.0f : 2.0f - phase * 2.0f);
+        float angle = m_Time * glm::two_pi<float>() / 10.0f;
+        glm::vec3 normal = glm::normalize(glm::vec3(std::cos(angle), 0.3f, std::sin(angle)));
+
+        RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
+        RenderCommand::Clear();
+
+        Shader& shader = *m_CrossSectionShader;
+        {
+            GpuPassScope meshPass(Renderer::GetGpuProfiler(), "CrossSection Mesh");
+            shader.Bind();
+            UploadCommonUniforms(shader, glm::mat4(1.0f));
+            shader.SetFloat4("u_ClipPlane", glm::vec4(normal, distance));
+            shader.SetFloat3("u_Color", glm::vec3(0.3f, 0.6f, 0.9f));
+            shader.SetInt("u_EnableClipping", 1);
+            shader.SetInt("u_ShowCrossSection", 1);
+
+            m_MeshVA->Bind();
+            RenderCommand::DrawIndexed(m_MeshVA);
+        }
+
+        {
+            GpuPassScope planePass(Renderer::GetGpuProfiler(), "Clip Plane Blend");
+            RenderCommand::SetBlend(true);
+            RenderCommand::SetCullFace(false);
+
+            shader.Bind();
+            UploadCommonUniforms(shader, CalculatePlaneTransform(normal, distance));
+            shader.SetFloat4("u_ClipPlane", glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+            shader.SetFloat3("u_Color", glm::vec3(1.0f, 1.0f, 0.0f));
+            shader.SetInt("u_EnableClipping", 0);
+            shader.SetInt("u_ShowCrossSection", 0);
+
+            m_PlaneVA->Bind();
+            RenderCommand::SetDepthWrite(false);
+            RenderCommand::DrawIndexed(m_PlaneVA);
+            RenderCommand::SetDepthWrite(true);
+
+            RenderCommand::SetBlend(false);
+            RenderCommand::SetCullFace(true);
+        }
+    }
+private:
+    void UploadCommonUniforms(Shader& shader, const glm::mat4& model)
+    {
+        shader.SetMat4("u_ViewProjection", m_Camera.GetViewProjectionMatrix());
+        shader.SetMat4("u_Transform", model);
+        shader.SetMat4("u_Model", model);
+        shader.SetFloat3("u_LightPos", glm::vec3(5.0f, 5.0f, 5.0f));
+        shader.SetFloat3("u_ViewPos", m_CameraPosition);
+        shader.SetFloat3("u_CrossSectionColor", glm::vec3(1.0f, 0.8f, 0.2f));
+    }
+
+    // Position, normal and texture coordinate per vertex, matching CrossSection.glsl
+    void CreateTorus(uint32_t majorSegments, uint32_t minorSegments)
+    {
+        const float majorRadius = 1.0f, minorRadius = 0.4f;
+
+        std::vector<float> vertices;
+        vertices.reserve((size_t)(majorSegments + 1) * (minorSegments + 1) * 8);
+        for (uint32_t i = 0; i <= majorSegments; i++)
+        {
+            float u = (float)i / majorSegments;
+            float theta = u * glm::two_pi<float>();
+            for (uint32_t j = 0; j <= minorSegments; j++)
+            {
+                float v = (float)j / minorSegments;
+                float phi = v * glm::two_pi<float>();
+
+                glm::vec3 normal = { std::cos(phi) * std::cos(theta), std::sin(phi), std::cos(phi) * std::sin(theta) };
+                glm::vec3 center = { majorRadius * std::cos(theta), 0.0f, majorRadius * std::sin(theta) };
+                glm::vec3 position = center + normal * minorRadius;
+
+                vertices.insert(vertices.end(), { position.x, position.y, position.z, normal.x, normal.y, normal.z, u, v });
+            }
+        }
+
+        std::vector<uint32_t> indices;
+        indices.reserve((size_t)majorSegments * minorSegments * 6);
+        for (uint32_t i = 0; i < majorSegments; i++)
+        {
+            for (uint32_t j = 0; j < minorSegments; j++)
+            {
+                uint32_t a = i * (minorSegments + 1) + j;
+                uint32_t b = a + minorSegments + 1;
+                indices.insert(indices.end(), { a, a + 1, b, b, a + 1, b + 1 });
+            }
+        }
+
+        m_MeshVA = VertexArray::Create();
+        Ref<VertexBuffer> vertexBuffer = VertexBuffer::Create(vertices.data(), (uint32_t)(vertices.size() * sizeof(float)));
+        vertexBuffer->SetLayout({
+            { ShaderDataType::Float3, "a_Position" },
+            { ShaderDataType::Float3, "a_Normal" },
+            { ShaderDataType::Float2, "a_TexCoord" }
+        });
+        m_MeshVA->AddVertexBuffer(vertexBuffer);
+        m_MeshVA->SetIndexBuffer(IndexBuffer::Create(indices.data(), (uint32_t)indices.size()));
+    }
+
+    static Ref<VertexArray> CreatePlane()
+    {
+        float vertices[] = {
+            -2.0f, -2.0f, 0.0f,  0.0f, 0.0f, 1.0f,  0.0f, 0.0f,
+             2.0f, -2.0f, 0.0f,  0.0f, 0.0f, 1.0f,  1.0f, 0.0f,
+             2.0f,  2.0f, 0.0f,  0.0f, 0.0f, 1.0f,  1.0f, 1.0f,
+            -2.0f,  2.0f, 0.0f,  0.0f, 0.0f, 1.0f,  0.0f, 1.0f
+        };
+        uint32_t indices[] = { 0, 1, 2, 2, 3, 0 };
+
+        Ref<VertexArray> vertexArray = VertexArray::Create();
+        Ref<VertexBuffer> vertexBuffer = VertexBuffer::Create(vertices, sizeof(vertices));
+        vertexBuffer->SetLayout({
+            { ShaderDataType::Float3, "a_Position" },
+            { ShaderDataType::Float3, "a_Normal" },
+            { ShaderDataType::Float2, "a_TexCoord" }
+        });
+        vertexArray->AddVertexBuffer(vertexBuffer);
+        vertexArray->SetIndexBuffer(IndexBuffer::Create(indices, 6));
+        return vertexArray;
+    }
+
+    static glm::mat4 CalculatePlaneTransform(const glm::vec3& normal, float distance)
+    {
+        glm::vec3 up = glm::vec3(0.0f, 0.0f, 1.0f);
+        glm::mat4 rotation = glm::mat4(1.0f);
+        if (glm::length(glm::cross(up, normal)) > 0.01f)
+            rotation = glm::rotate(glm::mat4(1.0f), std::acos(glm::dot(up, normal)), glm::normalize(glm::cross(up, normal)));
+        else if (glm::dot(up, normal) < 0.0f)
+            rotation = glm::rotate(glm::mat4(1.0f), glm::pi<float>(), glm::vec3(1.0f, 0.0f, 0.0f));
+
+        return glm::translate(glm::mat4(1.0f), -normal * distance) * rotation;
+    }
+private:
+    uint32_t m_Width, m_Height;
+    uint32_t m_Segments;
+
+    Ref<Shader> m_CrossSectionShader;
+    Ref<VertexArray> m_MeshVA, m_PlaneVA;
+
+    PerspectiveCamera m_Camera;
+    glm::vec3 m_CameraPosition = { 3.0f, 3.0f, 3.0f };
+    float m_Time = 0.0f;
+};
+
+// ---- Runner ----------------------------------------------------------------
+
+struct Distribution
+{
+    float Mean = 0.0f, Min = 0.0f, Max = 0.0f;
+    FrameStatsRecorder::Percentiles Percentiles;
+};
+
+struct ScenarioResult
+{
+    std::string Name;
+    uint32_t Frames = 0;
+    double TotalSeconds = 0.0;
+    Distribution FrameMs, GpuMs;
+
+    // Per-frame averages
+    double DrawCalls = 0, Triangles = 0, ShaderBinds = 0, VertexArrayBinds = 0, TextureBinds = 0;
+    double UniformUploads = 0, BufferBytesUploaded = 0, FramebufferSwitches = 0;
+};
+
+static Distribution Summarize(const FrameStatsRecorder& recorder, float FrameStats::* field,
+                              FrameStatsRecorder::Percentiles percentiles)
+{
+    Distribution result;
+    result.Percentiles = percentiles;
+    if (recorder.GetCount() == 0)
+        return result;
+
+    double sum = 0.0;
+    result.Min = result.Max = recorder.GetFrame(0).*field;
+    for (uint32_t i = 0; i < recorder.GetCount(); i++)
+    {
+        float value = recorder.GetFrame(i).*field;
+        sum += value;
+        result.Min = std::min(result.Min, value);
+        result.Max = std::max(result.Max, value);
+    }
+    result.Mean = (float)(sum / recorder.GetCount());
+    return result;
+}
+
+static ScenarioResult RunScenario(Layer& scenario, GraphicsContext& context, const BenchOptions& options)
+{
+    using Clock = std::chrono::steady_clock;
+
+    HZ_INFO("HazelBench: {0} ({1} warm-up + {2} frames)", scenario.GetName(), options.Warmup, options.Frames);
+
+    scenario.OnAttach();
+
+    FrameStatsRecorder recorder(options.Frames);
+    Clock::time_point measureStart;
+    for (uint32_t frame = 0; frame < options.Warmup + options.Frames; frame++)
+    {
+        if (frame == options.Warmup)
+            measureStart = Clock::now();
+
+        Clock::time_point frameStart = Clock::now();
+
+        JobSystem::RunMainThreadJobs();
+        Renderer::BeginFrame();
+        scenario.OnUpdate(Timestep(s_FixedTimestep));
+        Renderer::EndFrame();
+        context.SwapBuffers();
+        Renderer::WaitAndRender();
+
+        float frameMs = std::chrono::duration<float, std::milli>(Clock::now() - frameStart).count();
+        if (frame >= options.Warmup)
+            recorder.Record(frameMs, Renderer::GetGpuProfiler().GetFrameTime(), Renderer::GetStats());
+    }
+
+    ScenarioResult result;
+    result.Name = scenario.GetName();
+    result.Frames = recorder.GetCount();
+    result.TotalSeconds = std::chrono::duration<double>(Clock::now() - measureStart).count();
+    result.FrameMs = Summarize(recorder, &FrameStats::CpuFrameMs, recorder.GetCpuFrameTimePercentiles());
+    result.GpuMs = Summarize(recorder, &FrameStats::GpuFrameMs, recorder.GetGpuFrameTimePercentiles());
+
+    for (uint32_t i = 0; i < recorder.GetCount(); i++)
+    {
+        const RendererStatistics& stats = recorder.GetFrame(i).Rendering;
+        result.DrawCalls += stats.DrawCalls;
+        result.Triangles += (double)stats.GetTriangleCount();
+        result.ShaderBinds += stats.ShaderBinds;
+        result.VertexArrayBinds += stats.VertexArrayBinds;
+        result.TextureBinds += stats.TextureBinds;
+        result.UniformUploads += stats.UniformUploads;
+        result.BufferBytesUploaded += (double)stats.BufferBytesUploaded;
+        result.FramebufferSwitches += stats.FramebufferSwitches;
+    }
+    if (double frames = recorder.GetCount())
+    {
+        for (double* counter : { &result.DrawCalls, &result.Triangles, &result.ShaderBinds, &result.VertexArrayBinds,
+                                 &result.TextureBinds, &result.UniformUploads, &result.BufferBytesUploaded, &result.FramebufferSwitches })
+            *counter /= frames;
+    }
+
+    scenario.OnDetach();
+    return result;
+}
+
+// Runs a small quad grid on the recording backend and checks one frame of the command stream
+// against what the scene must submit: the u_Color upload, then per quad the flat-color shader,
+// its two matrices, the quad and a 6-index draw
+static bool CheckQuadGridStream(GraphicsContext& context, const BenchOptions& options)
+{
+    const uint32_t quadCount = 64;
+
+    BenchOptions checkOptions = options;
+    checkOptions.Warmup = 1;
+    checkOptions.Frames = 2;
+
+    QuadGridScenario scenario(quadCount, options.Width, options.Height);
+    RunScenario(scenario, context, checkOptions);
+
+    uint32_t shaderID = static_cast<RecordingShader&>(*scenario.GetShader()).GetRendererID();
+    uint32_t quadID = static_cast<RecordingVertexArray&>(*scenario.GetQuad()).GetRendererID();
+
+    uint32_t draws = 0, shaderBinds = 0, vertexArrayBinds = 0, matrixUploads = 0, colorUploads = 0, otherUploads = 0;
+    uint32_t misplaced = 0;
+    uint32_t boundShader = 0, boundVertexArray = 0;
+    for (const RecordedCommand& command : RecordingRendererAPI::GetLastFrameCommands())
+    {
+        switch (command.Type)
+        {
+            case RecordedCommandType::BindShader:
+                shaderBinds++;
+                boundShader = command.Resource;
+                break;
+            case RecordedCommandType::BindVertexArray:
+                vertexArrayBinds++;
+                boundVertexArray = command.Resource;
+                break;
+            case RecordedCommandType::SetUniform:
+                if (command.Resource != shaderID || boundShader != shaderID)
+                    misplaced++;
+                if ((ShaderDataType)command.Args[1] == ShaderDataType::Mat4)
+                    matrixUploads++;
+                else if ((ShaderDataType)command.Args[1] == ShaderDataType::Float3)
+                    colorUploads++;
+                else
+                    otherUploads++;
+                break;
+            case RecordedCommandType::DrawIndexed:
+                draws++;
+                if (boundShader != shaderID || boundVertexArray != quadID || command.Args[0] != 6)
+                    misplaced++;
+                // Every Renderer::Submit binds again
+                boundShader = boundVertexArray = 0;
+                break;
+            default:
+                break;
+        }
+    }
+
+    bool passed = draws == quadCount && shaderBinds == quadCount + 1 && vertexArrayBinds == quadCount
+        && matrixUploads == quadCount * 2 && colorUploads == 1 && otherUploads == 0 && misplaced == 0;
+    if (!passed)
+    {
+        HZ_ERROR("HazelBench --check: {0} quads recorded {1} draws, {2} shader binds, {3} vertex array binds, "
+                 "{4} matrix / {5} color / {6} other uniforms, {7} out of place",
+                 quadCount, draws, shaderBinds, vertexArrayBinds, matrixUploads, colorUploads, otherUploads, misplaced);
+        return false;
+    }
+
+    HZ_INFO("HazelBench --check: {0} quads, command stream as expected", quadCount);
+    return true;
+}
+
+static void WriteDistribution(std::ostream& out, const char* name, const Distribution& distribution)
+{
+    out << "      \"" << name << "\": { \"mean\": " << distribution.Mean
+        << ", \"min\": " << distribution.Min
+        << ", \"p50\": " << distribution.Percentiles.P50
+        << ", \"p95\": " << distribution.Percentiles.P95
+        << ", \"p99\": " << distribution.Percentiles.P99
+        << ", \"max\": " << distribution.Max << " }";
+}
+
+static std::string EscapeJSON(const std::string& text)
+{
+    std::string escaped;
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+struct ContextInfo
+{
+    std::string Vendor, Renderer, Version;
+};
+
+static bool WriteResults(const BenchOptions& options, const ContextInfo& contextInfo, const std::vector<ScenarioResult>& results)
+{
+    std::ofstream out(options.OutputPath);
+    if (!out)
+    {
+        HZ_ERROR("HazelBench: could not write '{0}'", options.OutputPath);
+        return false;
+    }
+
+    out << "{\n";
+    out << "  \"commit\": \"" << HZ_BENCH_GIT_COMMIT << "\",\n";
+    out << "  \"gl\": { \"vendor\": \"" << EscapeJSON(contextInfo.Vendor) << "\", \"renderer\": \"" << EscapeJSON(contextInfo.Renderer)
+        << "\", \"version\": \"" << EscapeJSON(contextInfo.Version) << "\" },\n";
+    out << "  \"config\": { \"width\": " << options.Width << ", \"height\": " << options.Height
+        << ", \"frames\": " << options.Frames << ", \"warmup\": " << options.Warmup
+        << ", \"timestep\": " << s_FixedTimestep << ", \"threaded\": " << (options.Threaded ? "true" : "false") << " },\n";
+    out << "  \"scenarios\": [";
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const ScenarioResult& result = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\n";
+        out << "      \"name\": \"" << result.Name << "\",\n";
+        out << "      \"frames\": " << result.Frames << ",\n";
+        out << "      \"fps\": " << (result.TotalSeconds > 0.0 ? result.Frames / result.TotalSeconds : 0.0) << ",\n";
+        WriteDistribution(out, "frame_ms", result.FrameMs);
+        out << ",\n";
+        WriteDistribution(out, "gpu_ms", result.GpuMs);
+        out << ",\n";
+        out << "      \"per_frame\": { \"draw_calls\": " << result.DrawCalls
+            << ", \"triangles\": " << result.Triangles
+            << ", \"shader_binds\": " << result.ShaderBinds
+            << ", \"vertex_array_binds\": " << result.VertexArrayBinds
+            << ", \"texture_binds\": " << result.TextureBinds
+            << ", \"uniform_uploads\": " << result.UniformUploads
+            << ", \"buffer_bytes_uploaded\": " << result.BufferBytesUploaded
+            << ", \"framebuffer_switches\": " << result.FramebufferSwitches << " }\n";
+        out << "    }";
+    }
+
+    out << "\n  ]\n}\n";
+    return (bool)out;
+}
+
+static bool ParseOptions(int argc, char** argv, BenchOptions& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        auto takesValue = [&]() { if (!value) return false; i++; return true; };
+
+        if (std::strcmp(arg, "--out") == 0 && takesValue())
+            options.OutputPath = value;
+        else if (std::strcmp(arg, "--frames") == 0 && takesValue())
+            options.Frames = (uint32_t)std::max(1, std::atoi(value));
+        else if (std::strcmp(arg, "--warmup") == 0 && takesValue())
+            options.Warmup = (uint32_t)std::max(0, std::atoi(value));
+        else if (std::strcmp(arg, "--size") == 0 && takesValue())
+        {
+            if (std::sscanf(value, "%ux%u", &options.Width, &options.Height) != 2 || !options.Width || !options.Height)
+                return false;
+        }
+        else if (std::strcmp(arg, "--quads") == 0 && takesValue())
+        {
+            options.QuadCounts.clear();
+            for (const char* c = value; *c; )
+            {
+                options.QuadCounts.push_back((uint32_t)std::max(1, std::atoi(c)));
+                c = std::strchr(c, ',');
+                if (!c)
+                    break;
+                c++;
+            }
+        }
+        else if (std::strcmp(arg, "--mesh-segments") == 0 && takesValue())
+            options.MeshSegments = (uint32_t)std::max(8, std::atoi(value));
+        else if (std::strcmp(arg, "--scenario") == 0 && takesValue())
+            options.ScenarioFilter = value;
+        else if (std::strcmp(arg, "--context") == 0 && takesValue())
+        {
+            if (std::strcmp(value, "native") == 0)
+                options.ContextAPI = HeadlessContextAPI::Native;
+            else if (std::strcmp(value, "egl") == 0)
+                options.ContextAPI = HeadlessContextAPI::EGL;
+            else if (std::strcmp(value, "osmesa") == 0)
+                options.ContextAPI = HeadlessContextAPI::OSMesa;
+            else
+                return false;
+        }
+        else if (std::strcmp(arg, "--api") == 0 && takesValue())
+        {
+            if (std::strcmp(value, "opengl") == 0)
+                options.API = RendererAPI::API::OpenGL;
+            else if (std::strcmp(value, "none") == 0)
+                options.API = RendererAPI::API::None;
+            else
+                return false;
+        }
+        else if (std::strcmp(arg, "--threaded") == 0)
+            options.Threaded = true;
+        else if (std::strcmp(arg, "--check") == 0)
+            options.Check = true;
+        else
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Log::Init();
+
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        printf("usage: HazelBench [--out results.json] [--frames N] [--warmup N] [--size WxH]\n"
+               "                  [--quads N,N,...] [--mesh-segments N] [--scenario name]\n"
+               "                  [--context native|egl|osmesa] [--api opengl|none] [--threaded]\n"
+               "       HazelBench --check [--threaded]\n");
+        Log::Shutdown();
+        return 1;
+    }
+
+    // The stream check needs the recording backend
+    if (options.Check)
+        options.API = RendererAPI::API::None;
+
+    JobSystem::Init();
+
+    // Before the window: under None it creates no GL context
+    RendererAPI::SetAPI(options.API);
+
+    WindowProps windowProps("HazelBench", options.Width, options.Height);
+    windowProps.Headless = true;
+    windowProps.ContextAPI = options.ContextAPI;
+    Scope<Window> window(Window::Create(windowProps));
+    GraphicsContext& context = *window->GetContext();
+
+    RendererConfig config;
+    config.Threading = options.Threaded ? RenderThreadingPolicy::MultiThreaded : RenderThreadingPolicy::SingleThreaded;
+    Renderer::Init(config);
+
+    if (options.Check)
+    {
+        Renderer::StartRenderThread(&context);
+        bool passed = CheckQuadGridStream(context, options);
+        Renderer::Shutdown();
+
+        window.reset();
+        JobSystem::Shutdown();
+        Log::Shutdown();
+        return passed ? 0 : 1;
+    }
+
+    std::vector<Scope<Layer>> scenarios;
+    for (uint32_t quadCount : options.QuadCounts)
+        scenarios.push_back(std::make_unique<QuadGridScenario>(quadCount, options.Width, options.Height));
+    scenarios.push_back(std::make_unique<BrushStrokeScenario>(options.Width, options.Height));
+    scenarios.push_back(std::make_unique<CrossSectionSweepScenario>(options.Width, options.Height, options.MeshSegments));
+
+    // Read while the main thread still holds the context
+    ContextInfo contextInfo = { "Hazel", "Recording", "none" };
+    if (options.API == RendererAPI::API::OpenGL)
+    {
+        contextInfo.Vendor = (const char*)glGetString(GL_VENDOR);
+        contextInfo.Renderer = (const char*)glGetString(GL_RENDERER);
+        contextInfo.Version = (const char*)glGetString(GL_VERSION);
+    }
+
+    Renderer::StartRenderThread(&context);
+
+    std::vector<ScenarioResult> results;
+    for (Scope<Layer>& scenario : scenarios)
+    {
+        if (!options.ScenarioFilter.empty() && scenario->GetName().find(options.ScenarioFilter) == std::string::npos)
+            continue;
+        results.push_back(RunScenario(*scenario, context, options));
+    }
+
+    printf("%s / %s\n", contextInfo.Vendor.c_str(), contextInfo.Renderer.c_str());
+    printf("%-26s %10s %10s %10s %10s %10s %12s\n", "", "fps", "p50 ms", "p95 ms", "p99 ms", "gpu p50", "draws/frame");
+    for (const ScenarioResult& result : results)
+    {
+        printf("%-26s %10.1f %10.3f %10.3f %10.3f %10.3f %12.0f\n", result.Name.c_str(),
+               result.TotalSeconds > 0.0 ? result.Frames / result.TotalSeconds : 0.0,
+               result.FrameMs.Percentiles.P50, result.FrameMs.Percentiles.P95, result.FrameMs.Percentiles.P99,
+               result.GpuMs.Percentiles.P50, result.DrawCalls);
+    }
+
+    scenarios.clear();
+    Renderer::Shutdown();
+
+    bool written = WriteResults(options, contextInfo, results);
+
+    window.reset();
+    JobSystem::Shutdown();
+    glfwTerminate();
+    Log::Shutdown();
+    return written ? 0 : 1;
+}
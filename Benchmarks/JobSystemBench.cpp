@@ -0,0 +1,142 @@
+// Measures how the job system scales from 1 thread to every hardware thread.
+//
+//   JobSystemBench [maxThreads]
+//
+// Each workload is timed best-of-N for every thread count and reported as
+// milliseconds plus speedup over the single-threaded run.
+
+#include "Hazel/Core/Log.h"
+#include "Hazel/Core/JobSystem.h"
+#include "Hazel/Scene/TransformHierarchy.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Hazel;
+
+static const int s_Repetitions = 5;
+
+static double TimeBest(const std::function<void()>& fn)
+{
+    double best = 1e30;
+    for (int i = 0; i < s_Repetitions; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+struct Workload
+{
+    std::string Name;
+    std::function<void()> Setup;
+    std::function<void()> Run;
+};
+
+int main(int argc, char** argv)
+{
+    Log::Init();
+
+    uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    if (argc > 1)
+        maxThreads = (uint32_t)std::max(1, std::atoi(argv[1]));
+
+    // ALU-bound loop over a large array
+    const uint32_t elementCount = 1 << 23;
+    std::vector<float> data(elementCount);
+
+    // 64 subassemblies of 4096 parts, fully dirtied every run
+    TransformHierarchy hierarchy;
+    TransformHierarchy::NodeID root = hierarchy.CreateNode();
+    for (int a = 0; a < 64; a++)
+    {
+        TransformHierarchy::NodeID assembly = hierarchy.CreateNode(root, glm::translate(glm::mat4(1.0f), glm::vec3((float)a, 0.0f, 0.0f)));
+        for (int p = 0; p < 4096; p++)
+            hierarchy.CreateNode(assembly, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, (float)p * 0.01f, 0.0f)));
+    }
+
+    std::vector<Workload> workloads = {
+        {
+            "parallel_for (8M elements)",
+            [&]() { for (uint32_t i = 0; i < elementCount; i++) data[i] = (float)i; },
+            [&]()
+            {
+                JobSystem::ParallelFor(elementCount, 16384, [&](uint32_t begin, uint32_t end)
+                {
+                    for (uint32_t i = begin; i < end; i++)
+                        data[i] = std::sqrt(data[i]) * std::sin(data[i]) + std::cos(data[i] * 0.5f);
+                });
+            }
+        },
+        {
+            "transform hierarchy (262k nodes)",
+            []() {},
+            [&]()
+            {
+                hierarchy.SetLocalTransform(root, glm::rotate(glm::mat4(1.0f), 0.1f, glm::vec3(0.0f, 1.0f, 0.0f)));
+                hierarchy.Update();
+            }
+        },
+        {
+            "job graph (64 x 64 dependent jobs)",
+            []() {},
+            []()
+            {
+                // 64 chains; each stage fans out 64 small jobs that run after the previous stage
+                std::vector<JobCounter> stages(64);
+                std::atomic<uint32_t> sink{ 0 };
+                auto work = [&sink]()
+                {
+                    uint32_t x = 1;
+                    for (int i = 0; i < 2000; i++)
+                        x = x * 1664525u + 1013904223u;
+                    sink.fetch_add(x, std::memory_order_relaxed);
+                };
+
+                for (int j = 0; j < 64; j++)
+                    JobSystem::Schedule(work, &stages[0]);
+                for (size_t s = 1; s < stages.size(); s++)
+                {
+                    for (int j = 0; j < 64; j++)
+                        JobSystem::ScheduleAfter(stages[s - 1], work, &stages[s]);
+                }
+
+                for (JobCounter& stage : stages)
+                    JobSystem::Wait(stage);
+            }
+        },
+    };
+
+    for (Workload& workload : workloads)
+    {
+        printf("\n%s\n", workload.Name.c_str());
+        printf("%8s %12s %10s\n", "threads", "best ms", "speedup");
+
+        double baseline = 0.0;
+        for (uint32_t threads = 1; threads <= maxThreads; threads++)
+        {
+            JobSystem::Init(threads);
+            workload.Setup();
+            double ms = TimeBest(workload.Run);
+            JobSystem::Shutdown();
+
+            if (threads == 1)
+                baseline = ms;
+            printf("%8u %12.3f %9.2fx\n", threads, ms, baseline / ms);
+        }
+    }
+
+    Log::Shutdown();
+    return 0;
+}
@@ -8,6 +8,10 @@
 #include "Hazel/Core/Input.h"
 #include "Hazel/Core/KeyCodes.h"
 #include "Hazel/Core/Base.h"
+#include "Hazel/Core/JobSystem.h"
+#include "Hazel/Core/FrameAllocator.h"
+#include "Hazel/Core/AllocationTracker.h"
+#include "Hazel/Debug/ProfilerLayer.h"
 
 // ---- Entry Point ----
 // Main function
@@ -16,6 +20,7 @@
 // ---Renderer------------------------
 #include "Hazel/Renderer/Renderer.h"
 #include "Hazel/Renderer/RenderCommand.h"
+#include "Hazel/Renderer/GpuProfiler.h"
 
 #include "Hazel/Renderer/Buffer.h"
 #include "Hazel/Renderer/Shader.h"
@@ -24,3 +29,8 @@
 
 #include "Hazel/Renderer/OrthographicCamera.h"
 #include "Hazel/Renderer/PerspectiveCamera.h"
+
+// ---Scene---------------------------
+#include "Hazel/Scene/Scene.h"
+#include "Hazel/Scene/Entity.h"
+#include "Hazel/Scene/Components.h"
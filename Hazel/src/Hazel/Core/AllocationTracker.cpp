@@ -0,0 +1,55 @@
+#include "hzpch.h"
+#include "AllocationTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace Hazel {
+
+    static std::atomic<uint64_t> s_AllocationCount{ 0 };
+    static std::atomic<uint64_t> s_AllocatedBytes{ 0 };
+
+    bool AllocationTracker::IsEnabled()
+    {
+#ifdef HZ_TRACK_HEAP_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    uint64_t AllocationTracker::GetAllocationCount()
+    {
+        return s_AllocationCount.load(std::memory_order_relaxed);
+    }
+
+    uint64_t AllocationTracker::GetAllocatedBytes()
+    {
+        return s_AllocatedBytes.load(std::memory_order_relaxed);
+    }
+
+#ifdef HZ_TRACK_HEAP_ALLOCATIONS
+    static void* TrackedAllocate(size_t size)
+    {
+        s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+        s_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+        if (void* memory = std::malloc(size ? size : 1))
+            return memory;
+        throw std::bad_alloc();
+    }
+#endif
+
+}
+
+#ifdef HZ_TRACK_HEAP_ALLOCATIONS
+
+void* operator new(size_t size) { return Hazel::TrackedAllocate(size); }
+void* operator new[](size_t size) { return Hazel::TrackedAllocate(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+
+#endif
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Hazel {
+
+    // Counts global operator new calls when the engine is built with HZ_TRACK_HEAP_ALLOCATIONS;
+    // otherwise the counters stay at zero and cost nothing
+    class AllocationTracker
+    {
+    public:
+        static bool IsEnabled();
+
+        static uint64_t GetAllocationCount();
+        static uint64_t GetAllocatedBytes();
+    };
+
+}
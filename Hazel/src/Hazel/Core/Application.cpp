@@ -1,5 +1,7 @@
 #include "Hazel/Core/Application.h"
 #include "Hazel/Core/Log.h"
+#include "Hazel/Core/JobSystem.h"
+#include "Hazel/Core/Events/MouseEvent.h"
 
 #include "glad/glad.h"
 #include <GLFW/glfw3.h>
@@ -13,47 +15,260 @@ namespace Hazel
 
     #define BIND_EVENT_FN(x) std::bind(&Application::x, this, std::placeholders::_1)
 
-    Application::Application() 
+    // ImGui settles hover and layout state a frame after the input that changed it
+    static const uint32_t s_InputRedrawFrames = 3;
+
+    Application::Application(const ApplicationSpecification& specification)
+        : m_Specification(specification)
     {
+        HZ_PROFILE_FUNCTION();
+
         s_Instance = this;
-        m_Window = std::unique_ptr<Window>(Window::Create());
-        m_Window->SetEventCallback(BIND_EVENT_FN(OnEvent));
+        JobSystem::Init();
+
+        WindowProps windowProps(specification.Name, specification.WindowWidth, specification.WindowHeight);
+        windowProps.Headless = specification.Headless;
+        windowProps.ContextAPI = specification.ContextAPI;
+        m_Window = std::unique_ptr<Window>(Window::Create(windowProps));
+        m_Window->SetEventCallback([this](Event& e)
+        {
+            m_InputRecording.OnEvent(e);
+            if (e.GetEventType() == EventType::MouseMoved)
+            {
+                auto& moved = static_cast<MouseMovedEvent&>(e);
+                m_InputHistory.AddCursorSample(moved.GetX(), moved.GetY());
+            }
+            m_EventQueue.Push(e);
+            RequestRedraw(s_InputRedrawFrames);
+        });
+        if (!specification.Headless)
+            m_Window->SetVSync(specification.VSync);
+
+        // The cursor only reports when it moves; start from where it is
+        if (!specification.Headless && m_Window->GetNativeWindow())
+        {
+            double x, y;
+            glfwGetCursorPos(static_cast<GLFWwindow*>(m_Window->GetNativeWindow()), &x, &y);
+            m_InputRecording.MouseX = (float)x;
+            m_InputRecording.MouseY = (float)y;
+        }
+        PublishInput(true);
+        Input::SetState(&m_Input);
+
+        m_RenderOnDemand = specification.RenderOnDemand && !specification.Headless;
+        SetMaxFrameRate(specification.MaxFrameRate);
+
+        // Uploads and callbacks handed to the main thread need a frame to run in
+        JobSystem::SetMainThreadWakeCallback([this]() { RequestRedraw(); });
 
-        Renderer::Init();
+        Renderer::Init(specification.Rendering);
 
-        m_ImGuiLayer = new ImGuiLayer();
-        PushOverLayer(m_ImGuiLayer);
+        // The ImGui backends need a real GLFW window with input
+        if (!specification.Headless)
+        {
+            m_ImGuiLayer = new ImGuiLayer();
+            PushOverLayer(m_ImGuiLayer);
+        }
     }
 
     Application::~Application() 
     {
+        HZ_PROFILE_FUNCTION();
 
+        JobSystem::SetMainThreadWakeCallback(nullptr);
+        Input::SetState(nullptr);
+        Renderer::Shutdown();
+        JobSystem::Shutdown();
     }
 
     void Application::Run()
     {
+        HZ_PROFILE_FUNCTION();
+
+        // Layers attached so far have recorded their resource creation into the first frame
+        Renderer::StartRenderThread(m_Window->GetContext());
+
+        m_StartTime = m_LastFrameTime = std::chrono::steady_clock::now();
         while (m_Running)
         {
-            float time = (float)glfwGetTime();
-            Timestep timestep = time - m_LastFrameTime;
-            m_LastFrameTime = time;
+            if (!ShouldRenderFrame())
+            {
+                WaitForWork();
+                continue;
+            }
 
-            for (Layer* layer : m_LayerStack)
-                layer->OnUpdate(timestep);
+            HZ_PROFILE_SCOPE("RunLoop");
 
-            m_ImGuiLayer->Begin();
-            for (Layer* layer : m_LayerStack)
-                layer->OnImGuiRender();
-            m_ImGuiLayer->End();
+            m_FramePacer.Wait();
+            double deltaTime = AdvanceTime();
+            Timestep timestep((float)deltaTime);
+
+            // What arrived while the last frame presented and the pacer waited, so the frame
+            // starts from the latest input rather than from the end of the previous frame
+            m_Window->PollEvents();
+            EndPoll();
+            m_InputHistory.BeginFrame();
+            PublishInput(true);
+            ProcessEvents();
+
+            // GL work handed back from worker threads (uploads of decoded data etc.)
+            JobSystem::RunMainThreadJobs();
 
+            Renderer::BeginFrame();
+
+            if (m_Specification.FixedTimestep > 0.0)
+                RunFixedUpdates(deltaTime);
+
+            {
+                HZ_PROFILE_SCOPE("LayerStack OnUpdate");
+
+                for (Layer* layer : m_LayerStack)
+                {
+                    HZ_PROFILE_SCOPE(layer->GetUpdateScopeName());
+                    layer->OnUpdate(timestep);
+                }
+            }
+
+            if (m_ImGuiLayer)
+            {
+                HZ_PROFILE_SCOPE("LayerStack OnImGuiRender");
+
+                m_ImGuiLayer->Begin();
+                for (Layer* layer : m_LayerStack)
+                {
+                    HZ_PROFILE_SCOPE(layer->GetImGuiScopeName());
+                    layer->OnImGuiRender();
+                }
+                m_ImGuiLayer->End();
+            }
+
+            Renderer::EndFrame();
             m_Window->OnUpdate();
+            EndPoll();
+
+            // Hand the recorded frame over; the next one is recorded while it executes
+            Renderer::WaitAndRender();
         }
     }
 
+    void Application::EndPoll()
+    {
+        m_InputHistory.EndPoll(std::chrono::duration<double>(std::chrono::steady_clock::now() - m_StartTime).count());
+    }
+
+    void Application::PublishInput(bool newFrame)
+    {
+        m_Input = m_InputRecording;
+        if (newFrame)
+            m_InputRecording.ClearTransitions();
+    }
+
+    double Application::AdvanceTime()
+    {
+        // Not glfwGetTime: a headless run may never initialize GLFW. Durations stay in double
+        // (steady_clock ticks) so a viewer left running for weeks keeps full precision.
+        auto time = std::chrono::steady_clock::now();
+        double deltaTime = std::chrono::duration<double>(time - m_LastFrameTime).count();
+        m_LastFrameTime = time;
+
+        // Time spent blocked in WaitForWork isn't frame time: animation and camera movement
+        // pick up where they stopped instead of jumping
+        if (m_ResumedFromIdle && m_FrameTiming.FrameIndex > 0)
+            deltaTime = std::min(deltaTime, (double)m_FrameTiming.SmoothedDeltaTime);
+        m_ResumedFromIdle = false;
+
+        m_FrameTiming.FrameIndex++;
+        m_FrameTiming.Time = std::chrono::duration<double>(time - m_StartTime).count();
+        m_FrameTiming.DeltaTime = (float)deltaTime;
+        m_FrameTiming.SmoothedDeltaTime = m_FrameTiming.FrameIndex == 1 ? (float)deltaTime
+            : m_FrameTiming.SmoothedDeltaTime + 0.1f * ((float)deltaTime - m_FrameTiming.SmoothedDeltaTime);
+        return deltaTime;
+    }
+
+    void Application::RunFixedUpdates(double deltaTime)
+    {
+        HZ_PROFILE_FUNCTION();
+
+        // A long stall (breakpoint, window drag) is dropped rather than replayed as a burst of steps
+        double step = m_Specification.FixedTimestep;
+        m_FixedTimeAccumulator += std::min(deltaTime, 0.25);
+
+        while (m_FixedTimeAccumulator >= step)
+        {
+            for (Layer* layer : m_LayerStack)
+                layer->OnFixedUpdate(Timestep((float)step));
+            m_FixedTimeAccumulator -= step;
+        }
+
+        m_FrameTiming.InterpolationAlpha = (float)(m_FixedTimeAccumulator / step);
+    }
+
+    bool Application::ShouldRenderFrame()
+    {
+        if (m_Minimized)
+            return false;
+        if (!m_RenderOnDemand)
+            return true;
+
+        uint32_t pending = m_PendingRedraws.load(std::memory_order_relaxed);
+        while (pending > 0 && !m_PendingRedraws.compare_exchange_weak(pending, pending - 1, std::memory_order_relaxed))
+        {
+        }
+        return pending > 0;
+    }
+
+    void Application::WaitForWork()
+    {
+        HZ_PROFILE_FUNCTION();
+
+        // Minimized, nothing is drawn until the window comes back, however long that takes
+        double timeout = m_Minimized ? 0.0 : m_Specification.IdleRedrawInterval;
+        m_Window->WaitEvents(timeout);
+        EndPoll();
+        PublishInput(false);
+        ProcessEvents();
+        m_ResumedFromIdle = true;
+
+        if (!m_Minimized && timeout > 0.0
+            && std::chrono::duration<double>(std::chrono::steady_clock::now() - m_LastFrameTime).count() >= timeout)
+            RequestRedraw();
+    }
+
+    void Application::RequestRedraw(uint32_t frames)
+    {
+        uint32_t pending = m_PendingRedraws.load(std::memory_order_relaxed);
+        while (pending < frames && !m_PendingRedraws.compare_exchange_weak(pending, frames, std::memory_order_relaxed))
+        {
+        }
+
+        // The main thread may be blocked in WaitForWork
+        if (m_RenderOnDemand && !JobSystem::IsMainThread())
+            m_Window->PostEmptyEvent();
+    }
+
+    void Application::SetMaxFrameRate(double framesPerSecond)
+    {
+        m_MaxFrameRate = framesPerSecond;
+        UpdateFrameRateCap();
+    }
+
+    void Application::UpdateFrameRateCap()
+    {
+        double cap = m_MaxFrameRate;
+        double background = m_Specification.BackgroundFrameRate;
+        if (!m_Focused && background > 0.0 && (cap <= 0.0 || background < cap))
+            cap = background;
+
+        m_FramePacer.SetMaxFrameRate(cap);
+    }
+
     void Application::OnEvent(Event& e)
     {
         EventDispatcher dispatcher(e);
         dispatcher.Dispatch<WindowCloseEvent>(BIND_EVENT_FN(OnWindowClose));
+        dispatcher.Dispatch<WindowMinimizeEvent>(BIND_EVENT_FN(OnWindowMinimize));
+        dispatcher.Dispatch<WindowFocusEvent>(BIND_EVENT_FN(OnWindowFocus));
+        dispatcher.Dispatch<WindowLostFocusEvent>(BIND_EVENT_FN(OnWindowLostFocus));
 
         for (auto it = m_LayerStack.end(); it != m_LayerStack.begin(); )
         {
@@ -67,21 +282,104 @@ namespace Hazel
         // HZ_CORE_TRACE("{0}", e.ToString());
     }
 
+    void Application::ProcessEvents()
+    {
+        HZ_PROFILE_FUNCTION();
+
+        EventTypeMask coalesceMask = 0;
+        for (Layer* layer : m_LayerStack)
+            coalesceMask |= layer->GetCoalescedEvents();
+
+        m_EventQueue.Drain(coalesceMask, [this](const EventQueue::Run& run)
+        {
+            if (run.GetCount() == 1)
+                OnEvent(run[0]);
+            else
+                DispatchRun(run);
+        });
+    }
+
+    void Application::DispatchRun(const EventQueue::Run& run)
+    {
+        // Layers that opted in get one merged event, the others every sample. The run
+        // travels down the stack as a unit and stops at the first layer that handles any of it.
+        alignas(std::max_align_t) unsigned char storage[MaxEventSize];
+        Event* coalesced = run.Coalesce(storage);
+        EventTypeMask typeBit = EventTypeBit(run.GetType());
+
+        for (auto it = m_LayerStack.rbegin(); it != m_LayerStack.rend(); ++it)
+        {
+            Layer* layer = *it;
+            bool handled = false;
+            if (layer->GetCoalescedEvents() & typeBit)
+            {
+                layer->OnEvent(*coalesced);
+                handled = coalesced->Handled;
+            }
+            else
+            {
+                for (uint32_t i = 0; i < run.GetCount(); i++)
+                {
+                    layer->OnEvent(run[i]);
+                    handled |= run[i].Handled;
+                }
+            }
+
+            if (handled)
+                break;
+        }
+
+        coalesced->~Event();
+    }
+
     void Application::PushLayer(Layer* pLayer)
     {
+        HZ_PROFILE_FUNCTION();
+
         m_LayerStack.PushLayer(pLayer);
+        InternScopeNames(pLayer);
         pLayer->OnAttach();
     }
 
     void Application::PushOverLayer(Layer* pLayer)
     {
+        HZ_PROFILE_FUNCTION();
+
         m_LayerStack.PushOverlay(pLayer);
+        InternScopeNames(pLayer);
         pLayer->OnAttach();
     }
 
+    void Application::InternScopeNames(Layer* layer)
+    {
+        // Interning takes a lock and a lookup: once per layer, not per frame
+        layer->m_UpdateScopeName = Instrumentor::Intern(layer->GetName() + "::OnUpdate");
+        layer->m_ImGuiScopeName = Instrumentor::Intern(layer->GetName() + "::OnImGuiRender");
+    }
+
     bool Application::OnWindowClose(WindowCloseEvent& e)
     {
         m_Running = false;
         return true;
     }
+
+    bool Application::OnWindowMinimize(WindowMinimizeEvent& e)
+    {
+        m_Minimized = e.IsMinimized();
+        return false;
+    }
+
+    bool Application::OnWindowFocus(WindowFocusEvent& e)
+    {
+        m_Focused = true;
+        UpdateFrameRateCap();
+        return false;
+    }
+
+    bool Application::OnWindowLostFocus(WindowLostFocusEvent& e)
+    {
+        m_Focused = false;
+        UpdateFrameRateCap();
+        return false;
+    }
 }
\ No newline at end of file
@@ -2,44 +2,135 @@
 
 #include "hzpch.h"
 #include "Window.h"
+#include "FramePacer.h"
+#include "Input.h"
+#include "InputHistory.h"
 
 #include "Hazel/Core/Events/ApplicationEvent.h"
+#include "Hazel/Core/Events/EventQueue.h"
 #include "Hazel/Core/LayerStack.h"
 
 #include "Hazel/Renderer/Buffer.h"
 #include "Hazel/Renderer/Shader.h"
 #include "Hazel/Renderer/VertexArray.h"
 #include "Hazel/Renderer/OrthographicCamera.h"
+#include "Hazel/Renderer/Renderer.h"
 
 #include "Hazel/Imgui/ImGuiLayer.h"
 
+#include <atomic>
+#include <chrono>
+
 namespace Hazel 
 {
+    struct ApplicationSpecification
+    {
+        std::string Name = "Hazel Engine";
+        uint32_t WindowWidth = 1280, WindowHeight = 720;
+
+        // No display and no VSync: the loop runs as fast as the frames render, without ImGui
+        // or input. Layers end the run with Close().
+        bool Headless = false;
+        HeadlessContextAPI ContextAPI = HeadlessContextAPI::Auto;
+
+        // Frame pacing. Without VSync the cap alone sets the rate; with it, a cap below the
+        // display rate still holds frames back evenly.
+        bool VSync = true;
+        double MaxFrameRate = 0.0; // 0: uncapped
+
+        // Seconds per Layer::OnFixedUpdate step; 0 disables fixed updates
+        double FixedTimestep = 0.0;
+
+        // Render only when something invalidated the frame: input, RequestRedraw() (animation,
+        // finished loads) or a main thread job. In between the loop blocks on window events.
+        // Ignored when headless.
+        bool RenderOnDemand = false;
+        // An idle loop still renders after this many seconds without a frame; 0: never
+        double IdleRedrawInterval = 1.0;
+
+        // Frame cap while the window doesn't have focus; 0: the normal cap. Minimized windows
+        // render nothing at all.
+        double BackgroundFrameRate = 10.0;
+
+        RendererConfig Rendering;
+    };
+
     class Application 
     {
     public:
-        Application();
+        Application(const ApplicationSpecification& specification = ApplicationSpecification());
         virtual ~Application();
 
         void Run();
+        // Leaves the run loop after the current frame
+        void Close() { m_Running = false; }
         void OnEvent(Event& e);
 
         void PushLayer(Layer* pLayer);
         void PushOverLayer(Layer* pLayer);
 
         inline Window& GetWindow() { return *m_Window; }
+        inline bool IsHeadless() const { return m_Specification.Headless; }
+        inline const ApplicationSpecification& GetSpecification() const { return m_Specification; }
+        inline const FrameTiming& GetFrameTiming() const { return m_FrameTiming; }
+        // Every cursor sample since the previous frame, timed on the FrameTiming clock
+        inline const InputHistory& GetInputHistory() const { return m_InputHistory; }
+
+        void SetMaxFrameRate(double framesPerSecond);
+
+        // Asks for at least the given number of frames with RenderOnDemand. Callable from any
+        // thread; animations call it every frame they are running.
+        void RequestRedraw(uint32_t frames = 1);
         
         static inline Application& Get() { return *s_Instance; }
 
     private:
+        // Delivers everything the window queued since the last frame
+        void ProcessEvents();
+        void DispatchRun(const EventQueue::Run& run);
+
+        // Times the cursor samples the window just delivered
+        void EndPoll();
+        // Makes the input recorded so far what Input reads. Only a new frame starts over on
+        // transitions; events handled while idle see them too, and so does the next frame.
+        void PublishInput(bool newFrame);
+
+        // Starts the frame on the clock; returns seconds since the previous frame
+        double AdvanceTime();
+        void RunFixedUpdates(double deltaTime);
+
+        // False while minimized, or idle with RenderOnDemand; takes one requested frame
+        bool ShouldRenderFrame();
+        // Blocks until the window has events or someone wants a frame, then handles the events
+        void WaitForWork();
+        void UpdateFrameRateCap();
+        // Profiler scope names for the layer's per-frame calls
+        static void InternScopeNames(Layer* layer);
+
         bool OnWindowClose(WindowCloseEvent& e);
+        bool OnWindowMinimize(WindowMinimizeEvent& e);
+        bool OnWindowFocus(WindowFocusEvent& e);
+        bool OnWindowLostFocus(WindowLostFocusEvent& e);
 
     private:
+        ApplicationSpecification m_Specification;
         std::unique_ptr<Window> m_Window;
+        EventQueue m_EventQueue;
+        InputHistory m_InputHistory;
+        InputState m_InputRecording; // Built from events as they arrive
+        InputState m_Input;          // Published at frame start, read by Input
         bool m_Running = true;
         LayerStack m_LayerStack;
-        float m_LastFrameTime = 0.0f;
-        ImGuiLayer* m_ImGuiLayer;
+        FramePacer m_FramePacer;
+        FrameTiming m_FrameTiming;
+        std::chrono::steady_clock::time_point m_StartTime, m_LastFrameTime;
+        double m_FixedTimeAccumulator = 0.0;
+        double m_MaxFrameRate = 0.0;
+        bool m_RenderOnDemand = false;
+        std::atomic<uint32_t> m_PendingRedraws{ 0 };
+        bool m_ResumedFromIdle = false;
+        bool m_Minimized = false, m_Focused = true;
+        ImGuiLayer* m_ImGuiLayer = nullptr; // None when headless
 
     private:
         static Application* s_Instance;
@@ -32,6 +32,8 @@ namespace Hazel {
 
 #define BIT(x) (1 << x)
 
+#include "Hazel/Debug/Instrumentor.h"
+
 #define HZ_BIND_EVENT_FN(fn) std::bind(&##fn, this, std::placeholders::_1)
 
 namespace Hazel {
@@ -37,6 +37,47 @@ namespace Hazel {
         EVENT_CLASS_CATEGORY(EventCategoryApplication)
     };
 
+    class  WindowMinimizeEvent : public Event
+    {
+    public:
+        WindowMinimizeEvent(bool minimized)
+            : m_Minimized(minimized) {
+        }
+
+        // false when the window is restored
+        inline bool IsMinimized() const { return m_Minimized; }
+
+        std::string ToString() const override
+        {
+            std::stringstream ss;
+            ss << "WindowMinimizeEvent: " << m_Minimized;
+            return ss.str();
+        }
+
+        EVENT_CLASS_TYPE(WindowMinimize)
+        EVENT_CLASS_CATEGORY(EventCategoryApplication)
+    private:
+        bool m_Minimized;
+    };
+
+    class  WindowFocusEvent : public Event
+    {
+    public:
+        WindowFocusEvent() {}
+
+        EVENT_CLASS_TYPE(WindowFocus)
+        EVENT_CLASS_CATEGORY(EventCategoryApplication)
+    };
+
+    class  WindowLostFocusEvent : public Event
+    {
+    public:
+        WindowLostFocusEvent() {}
+
+        EVENT_CLASS_TYPE(WindowLostFocus)
+        EVENT_CLASS_CATEGORY(EventCategoryApplication)
+    };
+
     class  AppTickEvent : public Event
     {
     public:
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <new>
 #include <ostream>
 #include <string>
 
@@ -8,10 +11,10 @@
 
 namespace Hazel {
 
-    // Events in Hazel are currently blocking, meaning when an event occurs it
-    // immediately gets dispatched and must be dealt with right then an there.
-    // For the future, a better strategy might be to buffer events in an event
-    // bus and process them during the "event" part of the update stage.
+    // Events in Hazel are buffered: window callbacks copy them into an EventQueue
+    // and Application drains it in one pass at the start of the next frame, so
+    // layers see input at a fixed point of the update instead of whenever the
+    // platform layer happens to deliver it.
 
     enum class EventType
     {
@@ -23,9 +26,19 @@ namespace Hazel {
         ScenePreStart, ScenePostStart, ScenePreStop, ScenePostStop,
         EditorExitPlayMode,
         SelectionChanged,
-        AnimationGraphCompiled
+        AnimationGraphCompiled,
+        Count
     };
 
+    // One bit per EventType, for per-layer event filters
+    using EventTypeMask = uint64_t;
+    static_assert((int)EventType::Count <= 64, "EventTypeMask has run out of bits!");
+
+    constexpr EventTypeMask EventTypeBit(EventType type) { return (EventTypeMask)1 << (int)type; }
+
+    // Every event has to fit into one EventQueue slot
+    constexpr size_t MaxEventSize = 64;
+
     enum EventCategory
     {
         None = 0,
@@ -40,7 +53,8 @@ namespace Hazel {
 
 #define EVENT_CLASS_TYPE(type) static EventType GetStaticType() { return EventType::type; }\
                                 virtual EventType GetEventType() const override { return GetStaticType(); }\
-                                virtual const char* GetName() const override { return #type; }
+                                virtual const char* GetName() const override { return #type; }\
+                                virtual Event* CloneInto(void* storage) const override { return ::Hazel::CloneEvent(*this, storage); }
 
 #define EVENT_CLASS_CATEGORY(category) virtual int GetCategoryFlags() const override { return category; }
 
@@ -55,34 +69,46 @@ namespace Hazel {
         virtual int GetCategoryFlags() const = 0;
         virtual std::string ToString() const { return GetName(); }
 
+        // Copy-constructs the event into storage of at least MaxEventSize bytes
+        virtual Event* CloneInto(void* storage) const = 0;
+
         inline bool IsInCategory(EventCategory category)
         {
             return GetCategoryFlags() & category;
         }
     };
 
+    template<typename T>
+    Event* CloneEvent(const T& event, void* storage)
+    {
+        static_assert(sizeof(T) <= MaxEventSize, "Event does not fit into an EventQueue slot!");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Event is over-aligned for an EventQueue slot!");
+        return new (storage) T(event);
+    }
+
+    // Looks the event type up once; every Dispatch after that is an integer compare
+    // and a direct call of the handler, no std::function in between.
     class EventDispatcher
     {
-        template<typename T>
-        using EventFn = std::function<bool(T&)>;
     public:
         EventDispatcher(Event& event)
-            : m_Event(event)
+            : m_Event(event), m_Type(event.GetEventType())
         {
         }
 
-        template<typename T>
-        bool Dispatch(EventFn<T> func)
+        template<typename T, typename F>
+        bool Dispatch(F&& func)
         {
-            if (m_Event.GetEventType() == T::GetStaticType() && !m_Event.Handled)
+            if (m_Type == T::GetStaticType() && !m_Event.Handled)
             {
-                m_Event.Handled = func(*(T*)&m_Event);
+                m_Event.Handled = func(static_cast<T&>(m_Event));
                 return true;
             }
             return false;
         }
     private:
         Event& m_Event;
+        EventType m_Type;
     };
 
     inline std::ostream& operator<<(std::ostream& os, const Event& e)
@@ -0,0 +1,60 @@
+#include "hzpch.h"
+#include "Hazel/Core/Events/EventQueue.h"
+
+#include "Hazel/Core/Events/ApplicationEvent.h"
+#include "Hazel/Core/Events/MouseEvent.h"
+
+namespace Hazel {
+
+    EventQueue::EventQueue(uint32_t initialCapacity)
+    {
+        m_Slots[0].reserve(initialCapacity);
+        m_Slots[1].reserve(initialCapacity);
+    }
+
+    EventQueue::~EventQueue()
+    {
+        Clear(m_Slots[0]);
+        Clear(m_Slots[1]);
+    }
+
+    void EventQueue::Push(const Event& event)
+    {
+        // Slots are plain bytes, so growing the pool relocates the queued events bytewise;
+        // events only hold trivially copyable members
+        std::vector<Slot>& slots = m_Slots[m_Recording];
+        slots.emplace_back();
+
+        Slot& slot = slots.back();
+        slot.Type = event.GetEventType();
+        event.CloneInto(slot.Storage);
+    }
+
+    void EventQueue::Clear(std::vector<Slot>& slots)
+    {
+        for (Slot& slot : slots)
+            slot.Get().~Event();
+        slots.clear();
+    }
+
+    Event* EventQueue::Run::Coalesce(void* storage) const
+    {
+        HZ_CORE_ASSERT(m_Count > 0, "Empty event run!");
+
+        if (GetType() == EventType::MouseScrolled)
+        {
+            float xOffset = 0.0f, yOffset = 0.0f;
+            for (uint32_t i = 0; i < m_Count; i++)
+            {
+                auto& scrolled = static_cast<MouseScrolledEvent&>((*this)[i]);
+                xOffset += scrolled.GetXOffset();
+                yOffset += scrolled.GetYOffset();
+            }
+            return new (storage) MouseScrolledEvent(xOffset, yOffset);
+        }
+
+        // Moves and resizes carry absolute values: the newest one wins
+        return (*this)[m_Count - 1].CloneInto(storage);
+    }
+
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Hazel/Core/Events/Event.h"
+
+#include <vector>
+
+namespace Hazel {
+
+    // Per-frame event buffer. Events are copied into fixed-size slots taken from a pool
+    // that is kept between frames, so queueing an event never touches the heap once the
+    // pool has grown to the busiest frame. Pushing while the queue is being drained goes
+    // to the second slot buffer and is delivered by the same Drain call.
+    class EventQueue
+    {
+    public:
+        // Consecutive events of one of these types can be merged into a single event
+        static constexpr EventTypeMask CoalescableEvents =
+            EventTypeBit(EventType::MouseMoved) | EventTypeBit(EventType::MouseScrolled) | EventTypeBit(EventType::WindowResize);
+
+        struct Slot
+        {
+            alignas(std::max_align_t) unsigned char Storage[MaxEventSize];
+            EventType Type;
+
+            Event& Get() { return *reinterpret_cast<Event*>(Storage); }
+        };
+
+        // Events of the same type that arrived back to back
+        class Run
+        {
+        public:
+            Run(Slot* first, uint32_t count)
+                : m_First(first), m_Count(count) {}
+
+            EventType GetType() const { return m_First->Type; }
+            uint32_t GetCount() const { return m_Count; }
+            Event& operator[](uint32_t index) const { return m_First[index].Get(); }
+
+            // Builds the one event that stands for the whole run: the last position or
+            // size, or the summed scroll offsets
+            Event* Coalesce(void* storage) const;
+        private:
+            Slot* m_First;
+            uint32_t m_Count;
+        };
+    public:
+        EventQueue(uint32_t initialCapacity = 256);
+        ~EventQueue();
+
+        EventQueue(const EventQueue&) = delete;
+        EventQueue& operator=(const EventQueue&) = delete;
+
+        void Push(const Event& event);
+
+        // Hands every queued event to func(const Run&), oldest first. Consecutive events are
+        // grouped into one Run only if their type is in coalesceMask (and CoalescableEvents);
+        // everything else arrives as a Run of one.
+        template<typename F>
+        void Drain(EventTypeMask coalesceMask, F&& func)
+        {
+            coalesceMask &= CoalescableEvents;
+            while (!m_Slots[m_Recording].empty())
+            {
+                std::vector<Slot>& slots = m_Slots[m_Recording];
+                m_Recording ^= 1;
+
+                uint32_t count = (uint32_t)slots.size();
+                for (uint32_t begin = 0; begin < count; )
+                {
+                    uint32_t end = begin + 1;
+                    if (coalesceMask & EventTypeBit(slots[begin].Type))
+                    {
+                        while (end < count && slots[end].Type == slots[begin].Type)
+                            end++;
+                    }
+
+                    func(Run(&slots[begin], end - begin));
+                    begin = end;
+                }
+
+                Clear(slots);
+            }
+        }
+
+        uint32_t GetSize() const { return (uint32_t)m_Slots[m_Recording].size(); }
+        bool IsEmpty() const { return m_Slots[m_Recording].empty(); }
+    private:
+        static void Clear(std::vector<Slot>& slots);
+    private:
+        // Recording buffer, and the one being drained; both keep their capacity
+        std::vector<Slot> m_Slots[2];
+        uint32_t m_Recording = 0;
+    };
+
+}
@@ -0,0 +1,176 @@
+#include "hzpch.h"
+#include "FrameAllocator.h"
+
+#include "Hazel/Core/AllocationTracker.h"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+namespace Hazel {
+
+    /////////////////////////////////////////////////////////////////////////////
+    // LinearArena //////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////
+
+    LinearArena::LinearArena(size_t blockSize)
+        : m_BlockSize(blockSize)
+    {
+    }
+
+    LinearArena::~LinearArena()
+    {
+        for (Block& block : m_Blocks)
+            delete[] block.Data;
+    }
+
+    void* LinearArena::Allocate(size_t size, size_t alignment)
+    {
+        HZ_CORE_ASSERT((alignment & (alignment - 1)) == 0, "Alignment must be a power of two!");
+
+        while (m_CurrentBlock < m_Blocks.size())
+        {
+            Block& block = m_Blocks[m_CurrentBlock];
+            uintptr_t address = (uintptr_t)block.Data + m_Offset;
+            uintptr_t aligned = (address + alignment - 1) & ~(uintptr_t)(alignment - 1);
+            size_t end = (aligned - (uintptr_t)block.Data) + size;
+            if (end <= block.Capacity)
+            {
+                m_UsedBytes += end - m_Offset;
+                m_Offset = end;
+                return (void*)aligned;
+            }
+
+            // Too small for this request: the tail of the block is wasted until Reset()
+            m_CurrentBlock++;
+            m_Offset = 0;
+        }
+
+        size_t capacity = std::max(m_BlockSize, size + alignment);
+        m_Blocks.push_back({ new uint8_t[capacity], capacity });
+        return Allocate(size, alignment);
+    }
+
+    void LinearArena::Reset()
+    {
+        m_CurrentBlock = 0;
+        m_Offset = 0;
+        m_UsedBytes = 0;
+    }
+
+    size_t LinearArena::GetCapacity() const
+    {
+        size_t capacity = 0;
+        for (const Block& block : m_Blocks)
+            capacity += block.Capacity;
+        return capacity;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    // FrameAllocator ///////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////
+
+    struct ThreadFrameArenas
+    {
+        LinearArena Frames[FrameAllocator::FramesInFlight];
+        bool InUse = true;
+    };
+
+    struct FrameAllocatorData
+    {
+        std::mutex Mutex;
+        std::vector<Scope<ThreadFrameArenas>> Threads;
+
+        std::atomic<uint64_t> FrameIndex{ 0 };
+        uint64_t HeapAllocationsAtFrameStart = 0;
+        FrameAllocator::Statistics LastFrame;
+    };
+
+    static FrameAllocatorData s_Data;
+
+    // Hands the thread's arenas back for reuse by a later thread when it exits
+    struct ThreadArenasHandle
+    {
+        ThreadFrameArenas* Arenas = nullptr;
+
+        ~ThreadArenasHandle()
+        {
+            if (!Arenas)
+                return;
+
+            std::lock_guard<std::mutex> lock(s_Data.Mutex);
+            Arenas->InUse = false;
+        }
+    };
+
+    static thread_local ThreadArenasHandle s_ThreadArenas;
+
+    static ThreadFrameArenas& GetThreadArenas()
+    {
+        if (s_ThreadArenas.Arenas)
+            return *s_ThreadArenas.Arenas;
+
+        std::lock_guard<std::mutex> lock(s_Data.Mutex);
+        for (auto& arenas : s_Data.Threads)
+        {
+            if (!arenas->InUse)
+            {
+                arenas->InUse = true;
+                s_ThreadArenas.Arenas = arenas.get();
+                return *arenas;
+            }
+        }
+
+        s_Data.Threads.emplace_back(new ThreadFrameArenas());
+        s_ThreadArenas.Arenas = s_Data.Threads.back().get();
+        return *s_ThreadArenas.Arenas;
+    }
+
+    void* FrameAllocator::Allocate(size_t size, size_t alignment)
+    {
+        uint32_t frame = (uint32_t)(s_Data.FrameIndex.load(std::memory_order_relaxed) % FramesInFlight);
+        return GetThreadArenas().Frames[frame].Allocate(size, alignment);
+    }
+
+    const char* FrameAllocator::CopyString(std::string_view string)
+    {
+        char* copy = static_cast<char*>(Allocate(string.size() + 1, 1));
+        memcpy(copy, string.data(), string.size());
+        copy[string.size()] = '\0';
+        return copy;
+    }
+
+    void FrameAllocator::NextFrame()
+    {
+        uint64_t frameIndex = s_Data.FrameIndex.load(std::memory_order_relaxed);
+        uint32_t closing = (uint32_t)(frameIndex % FramesInFlight);
+        uint32_t recycled = (uint32_t)((frameIndex + 1) % FramesInFlight);
+
+        uint64_t heapAllocations = AllocationTracker::GetAllocationCount();
+
+        std::lock_guard<std::mutex> lock(s_Data.Mutex);
+
+        s_Data.LastFrame.BytesAllocated = 0;
+        for (auto& arenas : s_Data.Threads)
+        {
+            s_Data.LastFrame.BytesAllocated += arenas->Frames[closing].GetUsedBytes();
+            arenas->Frames[recycled].Reset();
+        }
+
+        s_Data.LastFrame.HeapAllocations = heapAllocations - s_Data.HeapAllocationsAtFrameStart;
+        s_Data.HeapAllocationsAtFrameStart = heapAllocations;
+
+        s_Data.FrameIndex.store(frameIndex + 1, std::memory_order_relaxed);
+    }
+
+    uint64_t FrameAllocator::GetFrameIndex()
+    {
+        return s_Data.FrameIndex.load(std::memory_order_relaxed);
+    }
+
+    const FrameAllocator::Statistics& FrameAllocator::GetLastFrameStatistics()
+    {
+        return s_Data.LastFrame;
+    }
+
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Hazel {
+
+    // Bump-pointer arena over fixed-size blocks. Reset() rewinds to the first block and keeps
+    // every block for reuse, so a warmed-up arena never touches the heap.
+    class LinearArena
+    {
+    public:
+        LinearArena(size_t blockSize = 256 * 1024);
+        ~LinearArena();
+
+        LinearArena(const LinearArena&) = delete;
+        LinearArena& operator=(const LinearArena&) = delete;
+
+        void* Allocate(size_t size, size_t alignment);
+        void Reset();
+
+        size_t GetUsedBytes() const { return m_UsedBytes; }
+        size_t GetCapacity() const;
+    private:
+        struct Block
+        {
+            uint8_t* Data = nullptr;
+            size_t Capacity = 0;
+        };
+
+        std::vector<Block> m_Blocks;
+        size_t m_BlockSize;
+        size_t m_CurrentBlock = 0;
+        size_t m_Offset = 0;
+        size_t m_UsedBytes = 0;
+    };
+
+    // Scratch memory that lives for one frame in flight. Every thread allocates from its own
+    // sub-arena (no locking); NextFrame() recycles the arenas of the oldest frame, which the
+    // render thread has finished with by then, so data recorded for frame N may be referenced
+    // by its render commands. Nothing is ever freed individually and destructors are not run.
+    class FrameAllocator
+    {
+    public:
+        // Recording frame N+1 while the render thread executes frame N
+        static const uint32_t FramesInFlight = 2;
+
+        struct Statistics
+        {
+            size_t BytesAllocated = 0;     // From the frame arenas, all threads
+            uint64_t HeapAllocations = 0;  // Global operator new calls, needs HZ_TRACK_HEAP_ALLOCATIONS
+        };
+
+        static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        template<typename T, typename... Args>
+        static T* New(Args&&... args)
+        {
+            return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        // Null-terminated copy, e.g. for names captured by render commands
+        static const char* CopyString(std::string_view string);
+
+        // Called by Renderer::WaitAndRender() while the render thread is idle; no job may be
+        // allocating at that point
+        static void NextFrame();
+        static uint64_t GetFrameIndex();
+
+        static const Statistics& GetLastFrameStatistics();
+    };
+
+    // Allocator for standard containers; deallocate is a no-op, so reserve() up front
+    // rather than growing repeatedly
+    template<typename T>
+    class FrameAllocatorAdaptor
+    {
+    public:
+        using value_type = T;
+
+        FrameAllocatorAdaptor() = default;
+        template<typename U>
+        FrameAllocatorAdaptor(const FrameAllocatorAdaptor<U>&) {}
+
+        T* allocate(size_t count) { return static_cast<T*>(FrameAllocator::Allocate(count * sizeof(T), alignof(T))); }
+        void deallocate(T*, size_t) {}
+
+        template<typename U>
+        bool operator==(const FrameAllocatorAdaptor<U>&) const { return true; }
+        template<typename U>
+        bool operator!=(const FrameAllocatorAdaptor<U>&) const { return false; }
+    };
+
+    template<typename T>
+    using FrameVector = std::vector<T, FrameAllocatorAdaptor<T>>;
+
+    using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocatorAdaptor<char>>;
+
+}
@@ -0,0 +1,71 @@
+#include "hzpch.h"
+#include "Hazel/Core/FramePacer.h"
+
+#include <cmath>
+#include <thread>
+
+namespace Hazel {
+
+    // Keeps the sleep statistics tracking the current timer resolution and system load
+    static const uint32_t s_MaxSleepSamples = 64;
+
+    void FramePacer::SetMaxFrameRate(double framesPerSecond)
+    {
+        m_Period = framesPerSecond > 0.0 ? 1.0 / framesPerSecond : 0.0;
+        m_NextFrame = Clock::time_point();
+    }
+
+    void FramePacer::Wait()
+    {
+        HZ_PROFILE_FUNCTION();
+
+        if (m_Period <= 0.0)
+            return;
+
+        auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(m_Period));
+        Clock::time_point now = Clock::now();
+
+        // Deadlines advance by whole periods, so delivery doesn't drift with wake-up jitter. A frame
+        // that ran more than a period late re-anchors instead of being followed by catch-up frames.
+        if (m_NextFrame == Clock::time_point() || now - m_NextFrame > period)
+            m_NextFrame = now;
+
+        Sleep(m_NextFrame);
+        m_NextFrame += period;
+    }
+
+    void FramePacer::Sleep(Clock::time_point deadline)
+    {
+        while (true)
+        {
+            Clock::time_point start = Clock::now();
+            if (std::chrono::duration<double>(deadline - start).count() <= m_SleepEstimate)
+                break;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            RecordSleep(std::chrono::duration<double>(Clock::now() - start).count());
+        }
+
+        while (Clock::now() < deadline)
+            std::this_thread::yield();
+    }
+
+    void FramePacer::RecordSleep(double seconds)
+    {
+        if (m_SleepCount == s_MaxSleepSamples)
+        {
+            m_SleepCount /= 2;
+            m_SleepM2 /= 2.0;
+        }
+
+        m_SleepCount++;
+        double delta = seconds - m_SleepMean;
+        m_SleepMean += delta / m_SleepCount;
+        m_SleepM2 += delta * (seconds - m_SleepMean);
+
+        // One standard deviation of margin: rare long sleeps cost a late frame, not a spinning core.
+        // A single sample has no spread yet, and 0/0 would leave the estimate NaN.
+        m_SleepEstimate = m_SleepCount > 1 ? m_SleepMean + std::sqrt(m_SleepM2 / (m_SleepCount - 1)) : m_SleepMean;
+    }
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace Hazel {
+
+    // Clock readings for the current frame, from a monotonic clock in double precision
+    struct FrameTiming
+    {
+        uint64_t FrameIndex = 0;
+        double Time = 0.0;               // Seconds since the application started
+        float DeltaTime = 0.0f;          // Seconds since the previous frame started
+        float SmoothedDeltaTime = 0.0f;  // Exponential moving average of DeltaTime, for display
+
+        // Fraction of a fixed step left in the accumulator after this frame's fixed updates;
+        // blend the previous and current fixed-step states by it. 0 without a fixed timestep.
+        float InterpolationAlpha = 0.0f;
+    };
+
+    // Caps the frame rate by holding the start of each frame until its deadline. Waits sleep
+    // while the deadline is further away than a sleep tends to overshoot, measured as it runs,
+    // and spin (yielding) for the rest, so frames are delivered evenly without a busy core.
+    class FramePacer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+    public:
+        // 0 or less: no cap
+        void SetMaxFrameRate(double framesPerSecond);
+        double GetMaxFrameRate() const { return m_Period > 0.0 ? 1.0 / m_Period : 0.0; }
+
+        // Blocks until the next frame may start
+        void Wait();
+    private:
+        void Sleep(Clock::time_point deadline);
+        void RecordSleep(double seconds);
+    private:
+        double m_Period = 0.0;
+        Clock::time_point m_NextFrame;
+
+        // Running mean/variance of how long a 1 ms sleep really takes (Welford)
+        double m_SleepMean = 0.002;
+        double m_SleepM2 = 0.0;
+        uint32_t m_SleepCount = 1;
+        double m_SleepEstimate = 0.002;
+    };
+
+}
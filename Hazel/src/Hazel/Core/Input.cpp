@@ -0,0 +1,81 @@
+#include "hzpch.h"
+#include "Hazel/Core/Input.h"
+
+#include "Hazel/Core/Events/KeyEvent.h"
+#include "Hazel/Core/Events/MouseEvent.h"
+
+namespace Hazel {
+
+    // Everything up and the cursor at the corner until the application publishes its state
+    static const InputState s_EmptyState;
+    const InputState* Input::s_State = &s_EmptyState;
+
+    void Input::SetState(const InputState* state)
+    {
+        s_State = state ? state : &s_EmptyState;
+    }
+
+    void InputState::OnEvent(const Event& event)
+    {
+        switch (event.GetEventType())
+        {
+        case EventType::KeyPressed:
+        {
+            auto& e = static_cast<const KeyPressedEvent&>(event);
+            uint32_t index = KeyIndex(static_cast<int>(e.GetKeyCode()));
+            // Repeats aren't transitions
+            if (e.GetRepeatCount() == 0)
+                KeysPressed[index] = true;
+            KeysDown[index] = true;
+            break;
+        }
+        case EventType::KeyReleased:
+        {
+            uint32_t index = KeyIndex(static_cast<int>(static_cast<const KeyReleasedEvent&>(event).GetKeyCode()));
+            KeysReleased[index] = true;
+            KeysDown[index] = false;
+            break;
+        }
+        case EventType::MouseButtonPressed:
+        {
+            uint32_t index = ButtonIndex(static_cast<int>(static_cast<const MouseButtonPressedEvent&>(event).GetMouseButton()));
+            ButtonsPressed[index] = true;
+            ButtonsDown[index] = true;
+            break;
+        }
+        case EventType::MouseButtonReleased:
+        {
+            uint32_t index = ButtonIndex(static_cast<int>(static_cast<const MouseButtonReleasedEvent&>(event).GetMouseButton()));
+            ButtonsReleased[index] = true;
+            ButtonsDown[index] = false;
+            break;
+        }
+        case EventType::MouseMoved:
+        {
+            auto& e = static_cast<const MouseMovedEvent&>(event);
+            MouseX = e.GetX();
+            MouseY = e.GetY();
+            break;
+        }
+        case EventType::MouseScrolled:
+        {
+            auto& e = static_cast<const MouseScrolledEvent&>(event);
+            ScrollX += e.GetXOffset();
+            ScrollY += e.GetYOffset();
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    void InputState::ClearTransitions()
+    {
+        KeysPressed.reset();
+        KeysReleased.reset();
+        ButtonsPressed.reset();
+        ButtonsReleased.reset();
+        ScrollX = ScrollY = 0.0f;
+    }
+
+}
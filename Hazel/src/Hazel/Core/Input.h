@@ -1,25 +1,63 @@
 #pragma once
 
+#include "Hazel/Core/KeyCodes.h"
+#include "Hazel/Core/Events/Event.h"
+
+#include <bitset>
+#include <utility>
+
 namespace Hazel {
 
+    // Keyboard and mouse as of the start of a frame, built from the window's events rather than
+    // asked of the window per query. Plain data: copy it to hand it to a job or to record it.
+    // Pressed/Released are the transitions since the previous frame, so a tap shorter than a
+    // frame still shows as pressed and released although the key is no longer down.
+    struct InputState
+    {
+        static const uint32_t KeyCount = 512;  // Past GLFW_KEY_LAST; also holds GLFW_KEY_UNKNOWN (-1) masked
+        static const uint32_t ButtonCount = 8; // GLFW_MOUSE_BUTTON_LAST + 1
+
+        std::bitset<KeyCount> KeysDown, KeysPressed, KeysReleased;
+        std::bitset<ButtonCount> ButtonsDown, ButtonsPressed, ButtonsReleased;
+        float MouseX = 0.0f, MouseY = 0.0f; // Window pixels, y down
+        float ScrollX = 0.0f, ScrollY = 0.0f; // Wheel offsets summed since the previous frame
+
+        // Codes out of range wrap onto slots GLFW never reports, so lookups need no check
+        static uint32_t KeyIndex(int keycode) { return (uint32_t)keycode & (KeyCount - 1); }
+        static uint32_t ButtonIndex(int button) { return (uint32_t)button & (ButtonCount - 1); }
+
+        // Folds a window event into the state; other events are ignored
+        void OnEvent(const Event& event);
+        // Forgets the transitions and wheel offsets, keeping what is held down and the cursor
+        void ClearTransitions();
+    };
+
+    // Reads the InputState the application published at the start of the frame
     class Input
     {
     public:
-        inline static bool IsKeyPressed(int keycode) { return s_Instance->IsKeyPressedImpl(keycode); }
-
-        inline static bool IsMouseButtonPressed(int button) { return s_Instance->IsMouseButtonPressedImpl(button); }
-        inline static std::pair<float, float> GetMousePosition() { return s_Instance->GetMousePositionImpl(); }
-        inline static float GetMouseX() { return s_Instance->GetMouseXImpl(); }
-        inline static float GetMouseY() { return s_Instance->GetMouseYImpl(); }
-    protected:
-        virtual bool IsKeyPressedImpl(int keycode) = 0;
-
-        virtual bool IsMouseButtonPressedImpl(int button) = 0;
-        virtual std::pair<float, float> GetMousePositionImpl() = 0;
-        virtual float GetMouseXImpl() = 0;
-        virtual float GetMouseYImpl() = 0;
+        inline static bool IsKeyPressed(int keycode) { return s_State->KeysDown[InputState::KeyIndex(keycode)]; }
+        inline static bool IsKeyPressed(KeyCode keycode) { return IsKeyPressed(static_cast<int>(keycode)); }
+        // Went down / up since the previous frame
+        inline static bool WasKeyPressed(KeyCode keycode) { return s_State->KeysPressed[InputState::KeyIndex(static_cast<int>(keycode))]; }
+        inline static bool WasKeyReleased(KeyCode keycode) { return s_State->KeysReleased[InputState::KeyIndex(static_cast<int>(keycode))]; }
+
+        inline static bool IsMouseButtonPressed(int button) { return s_State->ButtonsDown[InputState::ButtonIndex(button)]; }
+        inline static bool IsMouseButtonPressed(MouseButton button) { return IsMouseButtonPressed(static_cast<int>(button)); }
+        inline static bool WasMouseButtonPressed(MouseButton button) { return s_State->ButtonsPressed[InputState::ButtonIndex(static_cast<int>(button))]; }
+        inline static bool WasMouseButtonReleased(MouseButton button) { return s_State->ButtonsReleased[InputState::ButtonIndex(static_cast<int>(button))]; }
+
+        inline static std::pair<float, float> GetMousePosition() { return { s_State->MouseX, s_State->MouseY }; }
+        inline static float GetMouseX() { return s_State->MouseX; }
+        inline static float GetMouseY() { return s_State->MouseY; }
+        inline static std::pair<float, float> GetScrollDelta() { return { s_State->ScrollX, s_State->ScrollY }; }
+
+        inline static const InputState& GetState() { return *s_State; }
+        // The application points this at its published state, which must outlive the
+        // queries; nullptr goes back to nothing held
+        static void SetState(const InputState* state);
     private:
-        static Input* s_Instance;
+        static const InputState* s_State;
     };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,78 @@
+#include "hzpch.h"
+#include "Hazel/Core/InputHistory.h"
+
+#include <algorithm>
+
+namespace Hazel {
+
+    static const size_t s_MaxRecentSamples = 32;
+    // Velocity is measured over this much of the latest movement; a cursor without a sample
+    // for as long counts as stopped
+    static const double s_VelocityWindow = 0.03;
+    // Further ahead than this a prediction is more likely to overshoot than to help
+    static const double s_MaxPrediction = 0.05;
+
+    void InputHistory::AddCursorSample(float x, float y)
+    {
+        m_PendingSamples.push_back({ x, y, 0.0 });
+        m_Unstamped++;
+    }
+
+    void InputHistory::EndPoll(double time)
+    {
+        if (m_Unstamped > 0)
+        {
+            double interval = std::max(time - m_LastPoll, 0.0);
+            size_t first = m_PendingSamples.size() - m_Unstamped;
+            for (uint32_t i = 0; i < m_Unstamped; i++)
+            {
+                CursorSample& sample = m_PendingSamples[first + i];
+                sample.Time = m_LastPoll + interval * (i + 1) / m_Unstamped;
+                m_RecentSamples.push_back(sample);
+            }
+            m_Unstamped = 0;
+
+            if (m_RecentSamples.size() > s_MaxRecentSamples)
+                m_RecentSamples.erase(m_RecentSamples.begin(), m_RecentSamples.end() - s_MaxRecentSamples);
+        }
+
+        m_LastPoll = time;
+    }
+
+    void InputHistory::BeginFrame()
+    {
+        m_FrameSamples.swap(m_PendingSamples);
+        m_PendingSamples.clear();
+        m_Unstamped = 0;
+    }
+
+    bool InputHistory::PredictCursor(double time, float& x, float& y) const
+    {
+        if (m_RecentSamples.empty())
+            return false;
+
+        const CursorSample& latest = m_RecentSamples.back();
+        x = latest.X;
+        y = latest.Y;
+
+        // The last sample of a delivery is stamped with its time, so while the cursor moves
+        // the latest sample is about as recent as the latest poll
+        double ahead = std::min(time - latest.Time, s_MaxPrediction);
+        if (ahead <= 0.0 || m_LastPoll - latest.Time > s_VelocityWindow)
+            return true;
+
+        // The oldest sample still inside the velocity window
+        const CursorSample* from = &latest;
+        for (auto it = m_RecentSamples.rbegin() + 1; it != m_RecentSamples.rend() && latest.Time - it->Time <= s_VelocityWindow; ++it)
+            from = &*it;
+
+        double elapsed = latest.Time - from->Time;
+        if (elapsed <= 0.0)
+            return true;
+
+        x += (float)((latest.X - from->X) / elapsed * ahead);
+        y += (float)((latest.Y - from->Y) / elapsed * ahead);
+        return true;
+    }
+
+}
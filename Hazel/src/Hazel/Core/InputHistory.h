@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Hazel {
+
+    struct CursorSample
+    {
+        float X = 0.0f, Y = 0.0f; // Window pixels, y down
+        double Time = 0.0;        // Seconds on the FrameTiming::Time clock
+    };
+
+    // Every cursor position the window delivered since the previous frame, rather than the one
+    // Input::GetMousePosition reads when a layer asks. A frame's samples are what strokes and
+    // drags should follow; PredictCursor extrapolates them to when the frame is displayed.
+    class InputHistory
+    {
+    public:
+        // From the window's cursor callback
+        void AddCursorSample(float x, float y);
+
+        // After the window delivered events at time. GLFW doesn't say when a sample arrived,
+        // only that it was after the previous delivery, so the new samples are spread evenly
+        // over the time since then.
+        void EndPoll(double time);
+
+        // The samples delivered since the previous frame become this frame's
+        void BeginFrame();
+
+        // Oldest first; empty if the cursor didn't move
+        const std::vector<CursorSample>& GetCursorSamples() const { return m_FrameSamples; }
+
+        // Where the cursor will be at time, going by its velocity over the latest samples.
+        // The latest position once it has stopped; false before any sample.
+        bool PredictCursor(double time, float& x, float& y) const;
+    private:
+        std::vector<CursorSample> m_PendingSamples; // Delivered since BeginFrame
+        std::vector<CursorSample> m_FrameSamples;
+        uint32_t m_Unstamped = 0;                   // At the end of m_PendingSamples, waiting for EndPoll
+        double m_LastPoll = 0.0;
+
+        std::vector<CursorSample> m_RecentSamples;  // The latest few, across frames, for PredictCursor
+    };
+
+}
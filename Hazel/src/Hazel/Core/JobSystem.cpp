@@ -0,0 +1,419 @@
+#include "hzpch.h"
+#include "Hazel/Core/JobSystem.h"
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+namespace Hazel {
+
+    struct Job
+    {
+        JobFunction Function;
+        JobCounter* Counter = nullptr;
+    };
+
+    // Chase-Lev deque (Le et al., "Correct and Efficient Work-Stealing for Weak Memory
+    // Models"). Fixed capacity: when it is full the owner runs the job inline instead.
+    class WorkStealingQueue
+    {
+    public:
+        static const int64_t Capacity = 4096;
+
+        // Owner only
+        bool Push(Job* job)
+        {
+            int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+            int64_t top = m_Top.load(std::memory_order_acquire);
+            if (bottom - top >= Capacity)
+                return false;
+
+            m_Jobs[bottom & (Capacity - 1)].store(job, std::memory_order_relaxed);
+            m_Bottom.store(bottom + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Owner only
+        Job* Pop()
+        {
+            int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+            m_Bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_Top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Job* job = m_Jobs[bottom & (Capacity - 1)].load(std::memory_order_relaxed);
+            if (top == bottom)
+            {
+                // Last item: race the thieves for it
+                if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    job = nullptr;
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+
+        // Any thread
+        Job* Steal()
+        {
+            int64_t top = m_Top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+            if (top >= bottom)
+                return nullptr;
+
+            Job* job = m_Jobs[top & (Capacity - 1)].load(std::memory_order_relaxed);
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+            return job;
+        }
+    private:
+        // Owner and thieves hammer different ends, keep them on separate cache lines
+        alignas(64) std::atomic<int64_t> m_Top{ 0 };
+        alignas(64) std::atomic<int64_t> m_Bottom{ 0 };
+        alignas(64) std::atomic<Job*> m_Jobs[Capacity];
+    };
+
+    struct JobSystemData
+    {
+        bool Initialized = false;
+        std::atomic<bool> Running{ false };
+        std::thread::id MainThreadID;
+
+        std::vector<std::thread> Threads;
+        std::vector<Scope<WorkStealingQueue>> Queues; // [0] belongs to the main thread
+
+        std::mutex InjectionMutex;
+        std::deque<Job*> InjectionQueue;
+
+        std::mutex MainThreadMutex;
+        std::vector<Job*> MainThreadJobs;
+        JobFunction MainThreadWake;
+
+        // Jobs sitting in a deque or the injection queue; idle workers sleep while it is zero
+        std::atomic<int32_t> QueuedJobs{ 0 };
+        std::mutex SleepMutex;
+        std::condition_variable WakeCondition;
+    };
+
+    static JobSystemData s_Data;
+
+    static thread_local int32_t s_WorkerIndex = -1;
+    static thread_local uint32_t s_RandomState = 0;
+
+    static uint32_t NextRandom()
+    {
+        // xorshift32
+        uint32_t x = s_RandomState;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return s_RandomState = x;
+    }
+
+    static Job* TryGetJob()
+    {
+        if (!s_Data.Initialized)
+            return nullptr;
+
+        Job* job = nullptr;
+        if (s_WorkerIndex >= 0)
+            job = s_Data.Queues[s_WorkerIndex]->Pop();
+
+        if (!job)
+        {
+            std::lock_guard<std::mutex> lock(s_Data.InjectionMutex);
+            if (!s_Data.InjectionQueue.empty())
+            {
+                job = s_Data.InjectionQueue.front();
+                s_Data.InjectionQueue.pop_front();
+            }
+        }
+
+        if (!job)
+        {
+            uint32_t queueCount = (uint32_t)s_Data.Queues.size();
+            uint32_t start = NextRandom() % queueCount;
+            for (uint32_t i = 0; i < queueCount && !job; i++)
+            {
+                uint32_t victim = (start + i) % queueCount;
+                if ((int32_t)victim != s_WorkerIndex)
+                    job = s_Data.Queues[victim]->Steal();
+            }
+        }
+
+        if (job)
+            s_Data.QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    void JobSystem::Execute(Job* job)
+    {
+        job->Function();
+        FinishJob(job->Counter);
+        delete job;
+    }
+
+    void JobSystem::Submit(Job* job)
+    {
+        if (!s_Data.Initialized)
+        {
+            Execute(job);
+            return;
+        }
+
+        s_Data.QueuedJobs.fetch_add(1, std::memory_order_relaxed);
+        if (s_WorkerIndex < 0 || !s_Data.Queues[s_WorkerIndex]->Push(job))
+        {
+            if (s_WorkerIndex >= 0)
+            {
+                // Own deque is full: running it here is as good as any thread
+                s_Data.QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+                Execute(job);
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(s_Data.InjectionMutex);
+            s_Data.InjectionQueue.push_back(job);
+        }
+
+        // Notifying under the lock orders the increment against a worker that is about to sleep
+        std::lock_guard<std::mutex> lock(s_Data.SleepMutex);
+        s_Data.WakeCondition.notify_one();
+    }
+
+    void JobSystem::FinishJob(JobCounter* counter)
+    {
+        if (!counter)
+            return;
+
+        // Not the last job: nobody can be waiting on the counter yet, so just decrement
+        uint32_t pending = counter->m_Pending.load(std::memory_order_relaxed);
+        while (pending > 1)
+        {
+            if (counter->m_Pending.compare_exchange_weak(pending, pending - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+                return;
+        }
+
+        // Last job: decrement under the lock so a waiter cannot destroy the counter while
+        // this thread is still collecting its continuations (see Wait)
+        std::vector<std::pair<JobFunction, JobCounter*>> continuations;
+        {
+            std::lock_guard<std::mutex> lock(counter->m_ContinuationMutex);
+            if (counter->m_Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                continuations.swap(counter->m_Continuations);
+        }
+
+        for (auto& [function, continuationCounter] : continuations)
+            Submit(new Job{ std::move(function), continuationCounter });
+    }
+
+    void JobSystem::WorkerLoop(uint32_t index)
+    {
+        HZ_PROFILE_THREAD(Instrumentor::Intern("Job Worker " + std::to_string(index)));
+
+        s_WorkerIndex = (int32_t)index;
+        s_RandomState = 0x9E3779B9u * (index + 1);
+
+        while (s_Data.Running.load(std::memory_order_relaxed))
+        {
+            if (Job* job = TryGetJob())
+            {
+                Execute(job);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(s_Data.SleepMutex);
+            s_Data.WakeCondition.wait(lock, []()
+            {
+                return s_Data.QueuedJobs.load(std::memory_order_relaxed) > 0 || !s_Data.Running.load(std::memory_order_relaxed);
+            });
+        }
+    }
+
+    void JobSystem::Init(uint32_t threadCount)
+    {
+        HZ_CORE_ASSERT(!s_Data.Initialized, "JobSystem already initialized!");
+
+        if (threadCount == 0)
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        uint32_t workerThreads = threadCount - 1;
+
+        HZ_PROFILE_THREAD("Main Thread");
+
+        s_Data.MainThreadID = std::this_thread::get_id();
+        s_WorkerIndex = 0;
+        s_RandomState = 0x9E3779B9u;
+
+        for (uint32_t i = 0; i < workerThreads + 1; i++)
+            s_Data.Queues.emplace_back(new WorkStealingQueue());
+
+        s_Data.Running = true;
+        s_Data.Initialized = true;
+        for (uint32_t i = 0; i < workerThreads; i++)
+            s_Data.Threads.emplace_back(WorkerLoop, i + 1);
+
+        HZ_CORE_INFO("JobSystem: {0} worker threads", workerThreads);
+    }
+
+    void JobSystem::Shutdown()
+    {
+        if (!s_Data.Initialized)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(s_Data.SleepMutex);
+            s_Data.Running = false;
+        }
+        s_Data.WakeCondition.notify_all();
+
+        for (std::thread& thread : s_Data.Threads)
+            thread.join();
+        s_Data.Threads.clear();
+
+        // Finish whatever is left so counters held by the caller still reach zero
+        while (Job* job = TryGetJob())
+            Execute(job);
+        RunMainThreadJobs();
+
+        s_Data.Queues.clear();
+        s_Data.QueuedJobs = 0;
+        s_Data.Initialized = false;
+        s_WorkerIndex = -1;
+    }
+
+    bool JobSystem::IsInitialized()
+    {
+        return s_Data.Initialized;
+    }
+
+    bool JobSystem::IsMainThread()
+    {
+        return !s_Data.Initialized || std::this_thread::get_id() == s_Data.MainThreadID;
+    }
+
+    uint32_t JobSystem::GetThreadCount()
+    {
+        return s_Data.Initialized ? (uint32_t)s_Data.Queues.size() : 1;
+    }
+
+    void JobSystem::Schedule(const JobFunction& job, JobCounter* counter)
+    {
+        if (counter)
+            counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+        Submit(new Job{ job, counter });
+    }
+
+    void JobSystem::ScheduleAfter(JobCounter& dependency, const JobFunction& job, JobCounter* counter)
+    {
+        if (counter)
+            counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+        {
+            std::lock_guard<std::mutex> lock(dependency.m_ContinuationMutex);
+            if (!dependency.IsDone())
+            {
+                dependency.m_Continuations.emplace_back(job, counter);
+                return;
+            }
+        }
+
+        Submit(new Job{ job, counter });
+    }
+
+    void JobSystem::ScheduleOnMainThread(const JobFunction& job, JobCounter* counter)
+    {
+        if (counter)
+            counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+        JobFunction wake;
+        {
+            std::lock_guard<std::mutex> lock(s_Data.MainThreadMutex);
+            s_Data.MainThreadJobs.push_back(new Job{ job, counter });
+            wake = s_Data.MainThreadWake;
+        }
+
+        if (wake)
+            wake();
+    }
+
+    void JobSystem::RunMainThreadJobs()
+    {
+        HZ_CORE_ASSERT(IsMainThread(), "Main thread jobs must run on the main thread!");
+
+        std::vector<Job*> jobs;
+        {
+            std::lock_guard<std::mutex> lock(s_Data.MainThreadMutex);
+            jobs.swap(s_Data.MainThreadJobs);
+        }
+
+        for (Job* job : jobs)
+            Execute(job);
+    }
+
+    void JobSystem::SetMainThreadWakeCallback(const JobFunction& callback)
+    {
+        std::lock_guard<std::mutex> lock(s_Data.MainThreadMutex);
+        s_Data.MainThreadWake = callback;
+    }
+
+    void JobSystem::Wait(JobCounter& counter)
+    {
+        while (!counter.IsDone())
+        {
+            // Main thread jobs are left for RunMainThreadJobs: running them here would change
+            // the caller's state under it, in the middle of whatever it is waiting inside of
+            if (Job* job = TryGetJob())
+                Execute(job);
+            else
+                std::this_thread::yield();
+        }
+
+        // The last FinishJob may still hold the lock; don't let the caller free the counter under it
+        std::lock_guard<std::mutex> lock(counter.m_ContinuationMutex);
+    }
+
+    bool JobSystem::RunPendingJob()
+    {
+        if (!s_Data.Initialized)
+            return false;
+
+        Job* job = TryGetJob();
+        if (!job)
+            return false;
+
+        Execute(job);
+        return true;
+    }
+
+    void JobSystem::ParallelFor(uint32_t count, uint32_t grain, const std::function<void(uint32_t, uint32_t)>& fn)
+    {
+        if (count == 0)
+            return;
+
+        grain = std::max(1u, grain);
+        if (!s_Data.Initialized || count <= grain)
+        {
+            fn(0, count);
+            return;
+        }
+
+        // Queue every piece but the first, which the caller runs itself
+        JobCounter counter;
+        for (uint32_t begin = grain; begin < count; begin += grain)
+        {
+            uint32_t end = std::min(count, begin + grain);
+            Schedule([&fn, begin, end]() { fn(begin, end); }, &counter);
+        }
+
+        fn(0, grain);
+        Wait(counter);
+    }
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace Hazel {
+
+    using JobFunction = std::function<void()>;
+
+    struct Job;
+
+    // Number of outstanding jobs that share it. Jobs scheduled with ScheduleAfter start
+    // once it reaches zero; JobSystem::Wait blocks on it while helping with other work.
+    class JobCounter
+    {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+    private:
+        std::atomic<uint32_t> m_Pending{ 0 };
+
+        std::mutex m_ContinuationMutex;
+        std::vector<std::pair<JobFunction, JobCounter*>> m_Continuations;
+
+        friend class JobSystem;
+    };
+
+    // Work-stealing job system. Every worker (the main thread included, as worker 0) owns a
+    // Chase-Lev deque: it pushes and pops at the bottom, idle workers steal from the top.
+    // Threads that are not workers hand jobs over through a shared injection queue.
+    class JobSystem
+    {
+    public:
+        // threadCount includes the calling thread; 0 uses every hardware thread
+        static void Init(uint32_t threadCount = 0);
+        static void Shutdown();
+
+        static bool IsInitialized();
+        static bool IsMainThread();
+
+        // Worker threads plus the main thread
+        static uint32_t GetThreadCount();
+
+        // Without Init() jobs run inline on the calling thread
+        static void Schedule(const JobFunction& job, JobCounter* counter = nullptr);
+        static void ScheduleAfter(JobCounter& dependency, const JobFunction& job, JobCounter* counter = nullptr);
+
+        // For work that must touch the GL context; run by Application::Run at the start of a
+        // frame (tools without an Application call RunMainThreadJobs at their own frame start)
+        static void ScheduleOnMainThread(const JobFunction& job, JobCounter* counter = nullptr);
+        static void RunMainThreadJobs();
+        // Called from the scheduling thread after each ScheduleOnMainThread, so a main thread
+        // that is blocked waiting for window events can be woken
+        static void SetMainThreadWakeCallback(const JobFunction& callback);
+
+        // Runs other pool jobs until counter reaches zero. Never runs main thread jobs, so the
+        // counter must not wait on one when called from the main thread.
+        static void Wait(JobCounter& counter);
+        // Runs one queued pool job on the calling thread, if there is one; for waiting on
+        // something a counter doesn't track. Never runs main thread jobs either.
+        static bool RunPendingJob();
+
+        // Calls fn(begin, end) over [0, count) in pieces of at most grain items and returns
+        // when all of them are done
+        static void ParallelFor(uint32_t count, uint32_t grain, const std::function<void(uint32_t, uint32_t)>& fn);
+    private:
+        static void Submit(Job* job);
+        static void Execute(Job* job);
+        static void FinishJob(JobCounter* counter);
+        static void WorkerLoop(uint32_t index);
+    };
+
+}
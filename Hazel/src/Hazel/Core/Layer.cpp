@@ -1,6 +1,7 @@
 ﻿#include "Layer.h"
 
 Hazel::Layer::Layer(const std::string& name)
+    : m_DebugName(name)
 {
 }
 
@@ -13,11 +13,25 @@ namespace Hazel {
         virtual void OnAttach() {} // 应用添加此层时执行
         virtual void OnDetach() {} // 应用分离此层时执行
         virtual void OnUpdate(Timestep ts) {} // 更新层, 由应用层每帧调用
+        virtual void OnFixedUpdate(Timestep ts) {} // 固定步长更新, 启用 FixedTimestep 时每帧调用 0~N 次, 在 OnUpdate 之前
         virtual void OnEvent(Event& event) {}// 每层处理事件
         virtual void OnImGuiRender() {}      // 每层渲染imgui
         inline const std::string& GetName() const { return m_DebugName; }
+
+        // 连续到达的同类事件 (MouseMoved/MouseScrolled/WindowResize) 合并为一个再交给此层
+        inline void SetCoalescedEvents(EventTypeMask mask) { m_CoalescedEvents = mask; }
+        inline EventTypeMask GetCoalescedEvents() const { return m_CoalescedEvents; }
+
+        // 每帧调用的 profiler 作用域名, 压入应用时生成一次
+        inline const char* GetUpdateScopeName() const { return m_UpdateScopeName; }
+        inline const char* GetImGuiScopeName() const { return m_ImGuiScopeName; }
     protected:
         std::string m_DebugName;
+        EventTypeMask m_CoalescedEvents = 0;
+    private:
+        friend class Application;
+        const char* m_UpdateScopeName = "Layer::OnUpdate";
+        const char* m_ImGuiScopeName = "Layer::OnImGuiRender";
     };
 
 }
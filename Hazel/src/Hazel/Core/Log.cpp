@@ -1,4 +1,6 @@
 #include "Hazel/Core/Log.h"
+#include "spdlog/async.h"
+#include "spdlog/sinks/rotating_file_sink.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 
 namespace Hazel 
@@ -6,14 +8,53 @@ namespace Hazel
     std::shared_ptr<spdlog::logger> Log::s_CoreLogger;
     std::shared_ptr<spdlog::logger> Log::s_ClientLogger;    
 
-    void Log::Init() 
+    static std::shared_ptr<spdlog::logger> CreateLogger(const std::string& name, const std::vector<spdlog::sink_ptr>& sinks,
+                                                        const LogSpecification& specification)
     {
-        spdlog::set_pattern("%^[%T] %n: %v%$");
-        s_CoreLogger = spdlog::stdout_color_mt("HAZEL");
-        s_CoreLogger->set_level(spdlog::level::trace);
+        std::shared_ptr<spdlog::logger> logger;
+        if (specification.Async)
+        {
+            auto policy = specification.Overflow == LogOverflowPolicy::Block ? spdlog::async_overflow_policy::block
+                                                                             : spdlog::async_overflow_policy::overrun_oldest;
+            logger = std::make_shared<spdlog::async_logger>(name, sinks.begin(), sinks.end(), spdlog::thread_pool(), policy);
+        }
+        else
+        {
+            logger = std::make_shared<spdlog::logger>(name, sinks.begin(), sinks.end());
+        }
 
-        s_ClientLogger = spdlog::stdout_color_mt("client");
-        s_ClientLogger->set_level(spdlog::level::trace);
+        // Runtime filtering on top of the compile-time HZ_LOG_LEVEL
+        logger->set_level(spdlog::level::trace);
+        logger->flush_on(spdlog::level::err);
+        spdlog::register_logger(logger);
+        return logger;
+    }
+
+    void Log::Init(const LogSpecification& specification) 
+    {
+        // One set of sinks shared by both loggers, so the file sees a single ordered stream
+        std::vector<spdlog::sink_ptr> sinks;
+        sinks.push_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+        sinks.back()->set_pattern("%^[%T] %n: %v%$");
+        if (!specification.FilePath.empty())
+        {
+            sinks.push_back(std::make_shared<spdlog::sinks::rotating_file_sink_mt>(specification.FilePath, specification.MaxFileSize, specification.MaxFiles));
+            sinks.back()->set_pattern("[%Y-%m-%d %T.%e] [%t] %n %l: %v");
+        }
+
+        // The ring is allocated here, once; one thread keeps messages in submission order
+        if (specification.Async)
+            spdlog::init_thread_pool(specification.QueueSize, 1);
+
+        s_CoreLogger = CreateLogger("HAZEL", sinks, specification);
+        s_ClientLogger = CreateLogger("client", sinks, specification);
+    }
+
+    void Log::Shutdown()
+    {
+        s_CoreLogger.reset();
+        s_ClientLogger.reset();
+        spdlog::shutdown();
     }
 
     std::shared_ptr<spdlog::logger>& Log::GetCoreLogger() 
@@ -25,4 +66,4 @@ namespace Hazel
     {
         return s_ClientLogger;
     }   
-}
\ No newline at end of file
+}
@@ -1,14 +1,67 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include "spdlog/spdlog.h"
 
+// Compile-time minimum level: macros below it expand to nothing, arguments included.
+// Release builds keep info and up unless HZ_LOG_LEVEL says otherwise.
+#define HZ_LOG_LEVEL_TRACE    0
+#define HZ_LOG_LEVEL_DEBUG    1
+#define HZ_LOG_LEVEL_INFO     2
+#define HZ_LOG_LEVEL_WARN     3
+#define HZ_LOG_LEVEL_ERROR    4
+#define HZ_LOG_LEVEL_CRITICAL 5
+#define HZ_LOG_LEVEL_OFF      6
+
+#ifndef HZ_LOG_LEVEL
+    #ifdef NDEBUG
+        #define HZ_LOG_LEVEL HZ_LOG_LEVEL_INFO
+    #else
+        #define HZ_LOG_LEVEL HZ_LOG_LEVEL_TRACE
+    #endif
+#endif
+
 namespace Hazel
  {
+    enum class LogOverflowPolicy
+    {
+        // The logging thread waits for room: nothing is lost, a burst can stall the caller
+        Block = 0,
+        // The oldest queued message is dropped: callers never wait
+        OverwriteOldest
+    };
+
+    struct LogSpecification
+    {
+        // Messages are formatted and written by a background thread; callers only copy them
+        // into a ring preallocated at Init. Call Log::Shutdown() before exiting so the tail of
+        // the queue is written.
+#ifdef HZ_LOG_ASYNC
+        bool Async = true;
+#else
+        bool Async = false;
+#endif
+        uint32_t QueueSize = 8192; // Messages
+        LogOverflowPolicy Overflow = LogOverflowPolicy::Block;
+
+        // Also written to this file, rotated at MaxFileSize keeping MaxFiles old ones. Empty: console only.
+#ifdef HZ_LOG_FILE
+        std::string FilePath = HZ_LOG_FILE;
+#else
+        std::string FilePath;
+#endif
+        size_t MaxFileSize = 5 * 1024 * 1024;
+        uint32_t MaxFiles = 3;
+    };
+
     class Log
     {
     public:
-        static void Init();
+        static void Init(const LogSpecification& specification = LogSpecification());
+        // Writes out what is still queued and stops the logging thread
+        static void Shutdown();
+
         static std::shared_ptr<spdlog::logger>& GetCoreLogger() ;
         static std::shared_ptr<spdlog::logger>& GetClientLogger() ;
     private:
@@ -17,17 +70,55 @@ namespace Hazel
     };
 }
 
-// Core log macros
+// Unevaluated, so nothing is formatted or computed, but arguments still count as used
+#define HZ_LOG_DISCARDED(...) ((void)sizeof((__VA_ARGS__, 0)))
+
+// Core and client log macros
+
+#if HZ_LOG_LEVEL <= HZ_LOG_LEVEL_TRACE
+    #define HZ_CORE_TRACE(...)    ::Hazel::Log::GetCoreLogger()->trace(__VA_ARGS__)
+    #define HZ_TRACE(...)         ::Hazel::Log::GetClientLogger()->trace(__VA_ARGS__)
+#else
+    #define HZ_CORE_TRACE(...)    HZ_LOG_DISCARDED(__VA_ARGS__)
+    #define HZ_TRACE(...)         HZ_LOG_DISCARDED(__VA_ARGS__)
+#endif
+
+#if HZ_LOG_LEVEL <= HZ_LOG_LEVEL_DEBUG
+    #define HZ_CORE_DEBUG(...)    ::Hazel::Log::GetCoreLogger()->debug(__VA_ARGS__)
+    #define HZ_DEBUG(...)         ::Hazel::Log::GetClientLogger()->debug(__VA_ARGS__)
+#else
+    #define HZ_CORE_DEBUG(...)    HZ_LOG_DISCARDED(__VA_ARGS__)
+    #define HZ_DEBUG(...)         HZ_LOG_DISCARDED(__VA_ARGS__)
+#endif
+
+#if HZ_LOG_LEVEL <= HZ_LOG_LEVEL_INFO
+    #define HZ_CORE_INFO(...)     ::Hazel::Log::GetCoreLogger()->info(__VA_ARGS__)
+    #define HZ_INFO(...)          ::Hazel::Log::GetClientLogger()->info(__VA_ARGS__)
+#else
+    #define HZ_CORE_INFO(...)     HZ_LOG_DISCARDED(__VA_ARGS__)
+    #define HZ_INFO(...)          HZ_LOG_DISCARDED(__VA_ARGS__)
+#endif
+
+#if HZ_LOG_LEVEL <= HZ_LOG_LEVEL_WARN
+    #define HZ_CORE_WARN(...)     ::Hazel::Log::GetCoreLogger()->warn(__VA_ARGS__)
+    #define HZ_WARN(...)          ::Hazel::Log::GetClientLogger()->warn(__VA_ARGS__)
+#else
+    #define HZ_CORE_WARN(...)     HZ_LOG_DISCARDED(__VA_ARGS__)
+    #define HZ_WARN(...)          HZ_LOG_DISCARDED(__VA_ARGS__)
+#endif
 
-#define HZ_CORE_TRACE(...)    ::Hazel::Log::GetCoreLogger()->trace(__VA_ARGS__)
-#define HZ_CORE_INFO(...)     ::Hazel::Log::GetCoreLogger()->info(__VA_ARGS__)
-#define HZ_CORE_WARN(...)     ::Hazel::Log::GetCoreLogger()->warn(__VA_ARGS__)
-#define HZ_CORE_ERROR(...)    ::Hazel::Log::GetCoreLogger()->error(__VA_ARGS__)
-#define HZ_CORE_CRITICAL(...)    ::Hazel::Log::GetCoreLogger()->critical(__VA_ARGS__) 
+#if HZ_LOG_LEVEL <= HZ_LOG_LEVEL_ERROR
+    #define HZ_CORE_ERROR(...)    ::Hazel::Log::GetCoreLogger()->error(__VA_ARGS__)
+    #define HZ_ERROR(...)         ::Hazel::Log::GetClientLogger()->error(__VA_ARGS__)
+#else
+    #define HZ_CORE_ERROR(...)    HZ_LOG_DISCARDED(__VA_ARGS__)
+    #define HZ_ERROR(...)         HZ_LOG_DISCARDED(__VA_ARGS__)
+#endif
 
-// Client log macros
-#define HZ_TRACE(...)          ::Hazel::Log::GetClientLogger()->trace(__VA_ARGS__)
-#define HZ_INFO(...)          ::Hazel::Log::GetClientLogger()->info(__VA_ARGS__)
-#define HZ_WARN(...)          ::Hazel::Log::GetClientLogger()->warn(__VA_ARGS__)
-#define HZ_ERROR(...)          ::Hazel::Log::GetClientLogger()->error(__VA_ARGS__)
-#define HZ_CRITICAL(...)          ::Hazel::Log::GetClientLogger()->critical(__VA_ARGS__)
+#if HZ_LOG_LEVEL <= HZ_LOG_LEVEL_CRITICAL
+    #define HZ_CORE_CRITICAL(...) ::Hazel::Log::GetCoreLogger()->critical(__VA_ARGS__)
+    #define HZ_CRITICAL(...)      ::Hazel::Log::GetClientLogger()->critical(__VA_ARGS__)
+#else
+    #define HZ_CORE_CRITICAL(...) HZ_LOG_DISCARDED(__VA_ARGS__)
+    #define HZ_CRITICAL(...)      HZ_LOG_DISCARDED(__VA_ARGS__)
+#endif
@@ -0,0 +1,17 @@
+#include "hzpch.h"
+#include "Window.h"
+
+#include "Hazel/Platform/WindowsWindow.h"
+#include "Hazel/Platform/HeadlessWindow.h"
+
+namespace Hazel {
+
+    Window* Window::Create(const WindowProps& props)
+    {
+        if (props.Headless)
+            return new HeadlessWindow(props);
+
+        return new WindowsWindow(props);
+    }
+
+}
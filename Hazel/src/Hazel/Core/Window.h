@@ -5,11 +5,26 @@
 
 namespace Hazel
 {
+    class GraphicsContext;
+
+    // Where a headless window's GL context comes from. Auto: the platform's own when a display
+    // is available, otherwise EGL (a GPU without a display), falling back to OSMesa (software).
+    enum class HeadlessContextAPI
+    {
+        Auto = 0, Native, EGL, OSMesa
+    };
+
     struct WindowProps
     {
         std::string Title;
         unsigned int Width;
         unsigned int Height;
+
+        // Nothing is shown and nothing throttles the frame rate: an invisible surface (none
+        // at all with RendererAPI::None) whose size only matters for the default framebuffer
+        bool Headless = false;
+        HeadlessContextAPI ContextAPI = HeadlessContextAPI::Auto;
+
         WindowProps(const std::string& title = "Hazel Engine",
             unsigned int width = 1280,
             unsigned int height = 720) :Title(title), Width(width), Height(height)
@@ -24,6 +39,15 @@ namespace Hazel
         virtual ~Window() {}
         virtual void OnUpdate() = 0;
 
+        // Delivers the events that arrived since the last delivery, without presenting
+        virtual void PollEvents() {}
+
+        // Blocks until an event arrives or timeout seconds pass (0: no timeout) and delivers
+        // what arrived, without presenting. Returns at once for windows without events.
+        virtual void WaitEvents(double timeout) {}
+        // Wakes a WaitEvents in progress; callable from any thread
+        virtual void PostEmptyEvent() {}
+
         virtual unsigned int GetWidth() const = 0;
         virtual unsigned int GetHeight() const = 0;
 
@@ -32,6 +56,7 @@ namespace Hazel
         virtual bool IsVSync() const = 0;
 
         virtual void* GetNativeWindow() const = 0;
+        virtual GraphicsContext* GetContext() const = 0;
         
         static Window* Create(const WindowProps& props = WindowProps());
     };
@@ -0,0 +1,139 @@
+#include "hzpch.h"
+#include "Hazel/Debug/FrameStatsRecorder.h"
+
+#include <cmath>
+#include <fstream>
+
+namespace Hazel {
+
+    FrameStatsRecorder::FrameStatsRecorder(uint32_t capacity)
+        : m_Frames(std::max(1u, capacity))
+    {
+        m_SortScratch.reserve(m_Frames.size());
+    }
+
+    void FrameStatsRecorder::Record(float cpuFrameMs, float gpuFrameMs, const RendererStatistics& rendering)
+    {
+        FrameStats& frame = m_Frames[m_Next];
+        frame.FrameIndex = m_FrameIndex++;
+        frame.CpuFrameMs = cpuFrameMs;
+        frame.GpuFrameMs = gpuFrameMs;
+        frame.Rendering = rendering;
+
+        m_Next = (m_Next + 1) % GetCapacity();
+        m_Count = std::min(m_Count + 1, GetCapacity());
+    }
+
+    void FrameStatsRecorder::Clear()
+    {
+        m_Next = 0;
+        m_Count = 0;
+    }
+
+    FrameStatsRecorder::Percentiles FrameStatsRecorder::ComputePercentiles(float FrameStats::* field) const
+    {
+        Percentiles result;
+        if (m_Count == 0)
+            return result;
+
+        m_SortScratch.clear();
+        for (uint32_t i = 0; i < m_Count; i++)
+            m_SortScratch.push_back(GetFrame(i).*field);
+
+        // Nearest-rank; each nth_element only reorders what the previous one left above its pick
+        auto rank = [this](float percentile)
+        {
+            size_t position = (size_t)std::ceil(percentile * m_SortScratch.size());
+            return std::max<size_t>(position, 1) - 1;
+        };
+
+        auto begin = m_SortScratch.begin();
+        size_t p50 = rank(0.50f), p95 = rank(0.95f), p99 = rank(0.99f);
+        std::nth_element(begin, begin + p50, m_SortScratch.end());
+        result.P50 = m_SortScratch[p50];
+        if (p95 > p50)
+            std::nth_element(begin + p50 + 1, begin + p95, m_SortScratch.end());
+        result.P95 = m_SortScratch[p95];
+        if (p99 > p95)
+            std::nth_element(begin + p95 + 1, begin + p99, m_SortScratch.end());
+        result.P99 = m_SortScratch[p99];
+        return result;
+    }
+
+    FrameStatsRecorder::Percentiles FrameStatsRecorder::GetCpuFrameTimePercentiles() const
+    {
+        return ComputePercentiles(&FrameStats::CpuFrameMs);
+    }
+
+    FrameStatsRecorder::Percentiles FrameStatsRecorder::GetGpuFrameTimePercentiles() const
+    {
+        return ComputePercentiles(&FrameStats::GpuFrameMs);
+    }
+
+    bool FrameStatsRecorder::WriteToFile(const std::string& filepath) const
+    {
+        std::ofstream out(filepath);
+        if (!out)
+        {
+            HZ_CORE_ERROR("Could not write frame statistics to '{0}'", filepath);
+            return false;
+        }
+
+        bool json = filepath.size() >= 5 && filepath.compare(filepath.size() - 5, 5, ".json") == 0;
+        bool written = json ? WriteJSON(out) : WriteCSV(out);
+        if (written)
+            HZ_CORE_INFO("Wrote {0} frames of statistics to '{1}'", m_Count, filepath);
+        return written;
+    }
+
+    bool FrameStatsRecorder::WriteCSV(std::ostream& out) const
+    {
+        out << "frame,cpu_ms,gpu_ms,draw_calls,indices,triangles,shader_binds,vertex_array_binds,"
+               "texture_binds,uniform_uploads,buffer_bytes_uploaded,framebuffer_switches\n";
+
+        for (uint32_t i = 0; i < m_Count; i++)
+        {
+            const FrameStats& frame = GetFrame(i);
+            const RendererStatistics& stats = frame.Rendering;
+            out << frame.FrameIndex << ',' << frame.CpuFrameMs << ',' << frame.GpuFrameMs << ','
+                << stats.DrawCalls << ',' << stats.Indices << ',' << stats.GetTriangleCount() << ','
+                << stats.ShaderBinds << ',' << stats.VertexArrayBinds << ',' << stats.TextureBinds << ','
+                << stats.UniformUploads << ',' << stats.BufferBytesUploaded << ',' << stats.FramebufferSwitches << '\n';
+        }
+        return (bool)out;
+    }
+
+    bool FrameStatsRecorder::WriteJSON(std::ostream& out) const
+    {
+        Percentiles cpu = GetCpuFrameTimePercentiles();
+        Percentiles gpu = GetGpuFrameTimePercentiles();
+
+        out << "{\n";
+        out << "  \"cpu_ms\": { \"p50\": " << cpu.P50 << ", \"p95\": " << cpu.P95 << ", \"p99\": " << cpu.P99 << " },\n";
+        out << "  \"gpu_ms\": { \"p50\": " << gpu.P50 << ", \"p95\": " << gpu.P95 << ", \"p99\": " << gpu.P99 << " },\n";
+        out << "  \"frames\": [";
+
+        for (uint32_t i = 0; i < m_Count; i++)
+        {
+            const FrameStats& frame = GetFrame(i);
+            const RendererStatistics& stats = frame.Rendering;
+            out << (i == 0 ? "\n" : ",\n")
+                << "    { \"frame\": " << frame.FrameIndex
+                << ", \"cpu_ms\": " << frame.CpuFrameMs
+                << ", \"gpu_ms\": " << frame.GpuFrameMs
+                << ", \"draw_calls\": " << stats.DrawCalls
+                << ", \"indices\": " << stats.Indices
+                << ", \"triangles\": " << stats.GetTriangleCount()
+                << ", \"shader_binds\": " << stats.ShaderBinds
+                << ", \"vertex_array_binds\": " << stats.VertexArrayBinds
+                << ", \"texture_binds\": " << stats.TextureBinds
+                << ", \"uniform_uploads\": " << stats.UniformUploads
+                << ", \"buffer_bytes_uploaded\": " << stats.BufferBytesUploaded
+                << ", \"framebuffer_switches\": " << stats.FramebufferSwitches << " }";
+        }
+
+        out << "\n  ]\n}\n";
+        return (bool)out;
+    }
+
+}
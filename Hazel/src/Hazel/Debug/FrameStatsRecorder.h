@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Hazel/Renderer/Renderer.h"
+
+#include <string>
+#include <vector>
+
+namespace Hazel {
+
+    struct FrameStats
+    {
+        uint64_t FrameIndex = 0;
+        float CpuFrameMs = 0.0f;
+        float GpuFrameMs = 0.0f;
+        RendererStatistics Rendering;
+    };
+
+    // Ring of the most recent per-frame statistics, with frame-time percentiles and
+    // CSV/JSON export
+    class FrameStatsRecorder
+    {
+    public:
+        struct Percentiles
+        {
+            float P50 = 0.0f;
+            float P95 = 0.0f;
+            float P99 = 0.0f;
+        };
+    public:
+        FrameStatsRecorder(uint32_t capacity = 3600);
+
+        void Record(float cpuFrameMs, float gpuFrameMs, const RendererStatistics& rendering);
+        void Clear();
+
+        uint32_t GetCount() const { return m_Count; }
+        uint32_t GetCapacity() const { return (uint32_t)m_Frames.size(); }
+
+        // 0 is the oldest frame still held, GetCount() - 1 the newest
+        const FrameStats& GetFrame(uint32_t index) const { return m_Frames[(m_Next + GetCapacity() - m_Count + index) % GetCapacity()]; }
+
+        // Over every frame held
+        Percentiles GetCpuFrameTimePercentiles() const;
+        Percentiles GetGpuFrameTimePercentiles() const;
+
+        // Format follows the extension: ".json" writes JSON, anything else CSV
+        bool WriteToFile(const std::string& filepath) const;
+    private:
+        Percentiles ComputePercentiles(float FrameStats::* field) const;
+
+        bool WriteCSV(std::ostream& out) const;
+        bool WriteJSON(std::ostream& out) const;
+    private:
+        std::vector<FrameStats> m_Frames;
+        uint32_t m_Next = 0;
+        uint32_t m_Count = 0;
+        uint64_t m_FrameIndex = 0;
+
+        mutable std::vector<float> m_SortScratch;
+    };
+
+}
@@ -0,0 +1,245 @@
+#include "hzpch.h"
+#include "Hazel/Debug/Instrumentor.h"
+
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace Hazel {
+
+    std::atomic<bool> Instrumentor::s_SessionActive{ false };
+
+    struct ProfileEvent
+    {
+        const char* Name;
+        int64_t Start;
+        int64_t End;
+    };
+
+    // Written by its own thread (or the one recording into the track) only, read by the writer thread only
+    struct ProfileThreadBuffer
+    {
+        static const uint32_t Capacity = 1 << 15;
+
+        uint32_t ThreadID = 0;
+        std::atomic<const char*> Name{ nullptr };
+        std::atomic<uint64_t> Dropped{ 0 };
+
+        alignas(64) std::atomic<uint64_t> Head{ 0 };
+        alignas(64) std::atomic<uint64_t> Tail{ 0 };
+        ProfileEvent Events[Capacity];
+    };
+
+    struct InstrumentorData
+    {
+        std::mutex SessionMutex; // Begin/EndSession
+
+        // Buffers are never freed, so a thread that exits mid-session still gets flushed
+        std::mutex BufferMutex;
+        std::vector<Scope<ProfileThreadBuffer>> Buffers;
+
+        std::string SessionName;
+        std::ofstream Output;
+        int64_t SessionStart = 0;
+        bool FirstEvent = true;
+
+        std::thread Writer;
+        std::mutex WriterMutex;
+        std::condition_variable WriterCondition;
+        bool StopWriter = false;
+
+        std::mutex InternMutex;
+        std::unordered_set<std::string> InternedNames;
+    };
+
+    static InstrumentorData s_Data;
+    static thread_local ProfileThreadBuffer* s_ThreadBuffer = nullptr;
+
+    static ProfileThreadBuffer* AddBuffer()
+    {
+        std::lock_guard<std::mutex> lock(s_Data.BufferMutex);
+        s_Data.Buffers.emplace_back(new ProfileThreadBuffer());
+        s_Data.Buffers.back()->ThreadID = (uint32_t)s_Data.Buffers.size() - 1;
+        return s_Data.Buffers.back().get();
+    }
+
+    static ProfileThreadBuffer* GetThreadBuffer()
+    {
+        if (!s_ThreadBuffer)
+            s_ThreadBuffer = AddBuffer();
+        return s_ThreadBuffer;
+    }
+
+    static void WriteEscaped(std::string& out, const char* text)
+    {
+        for (const char* c = text; *c; c++)
+        {
+            if (*c == '"' || *c == '\\')
+                out += '\\';
+            out += *c;
+        }
+    }
+
+    static void WriteEvent(std::string& out, const ProfileEvent& event, uint32_t threadID)
+    {
+        char numbers[96];
+        snprintf(numbers, sizeof(numbers), "\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+            threadID, (event.Start - s_Data.SessionStart) / 1000.0, (event.End - event.Start) / 1000.0);
+
+        out += s_Data.FirstEvent ? "\n" : ",\n";
+        s_Data.FirstEvent = false;
+        out += "{\"cat\":\"function\",\"name\":\"";
+        WriteEscaped(out, event.Name);
+        out += numbers;
+    }
+
+    // Writer thread (and EndSession after it has stopped)
+    static void FlushBuffers()
+    {
+        std::string out;
+        {
+            std::lock_guard<std::mutex> lock(s_Data.BufferMutex);
+            for (auto& buffer : s_Data.Buffers)
+            {
+                uint64_t tail = buffer->Tail.load(std::memory_order_relaxed);
+                uint64_t head = buffer->Head.load(std::memory_order_acquire);
+                for (; tail < head; tail++)
+                    WriteEvent(out, buffer->Events[tail & (ProfileThreadBuffer::Capacity - 1)], buffer->ThreadID);
+                buffer->Tail.store(tail, std::memory_order_release);
+            }
+        }
+
+        if (!out.empty())
+            s_Data.Output << out;
+    }
+
+    static void WriterLoop()
+    {
+        HZ_PROFILE_THREAD("Profiler");
+
+        std::unique_lock<std::mutex> lock(s_Data.WriterMutex);
+        while (!s_Data.StopWriter)
+        {
+            s_Data.WriterCondition.wait_for(lock, std::chrono::milliseconds(50));
+
+            lock.unlock();
+            FlushBuffers();
+            lock.lock();
+        }
+    }
+
+    void Instrumentor::BeginSession(const std::string& name, const std::string& filepath)
+    {
+        std::lock_guard<std::mutex> sessionLock(s_Data.SessionMutex);
+        if (s_SessionActive)
+        {
+            HZ_CORE_ERROR("Instrumentor::BeginSession('{0}') while session '{1}' is still open", name, s_Data.SessionName);
+            return;
+        }
+
+        s_Data.Output.open(filepath);
+        if (!s_Data.Output.is_open())
+        {
+            HZ_CORE_ERROR("Instrumentor could not open results file '{0}'", filepath);
+            return;
+        }
+
+        {
+            // Leftovers from scopes that closed after the previous session ended
+            std::lock_guard<std::mutex> lock(s_Data.BufferMutex);
+            for (auto& buffer : s_Data.Buffers)
+            {
+                buffer->Tail.store(buffer->Head.load(std::memory_order_acquire), std::memory_order_release);
+                buffer->Dropped = 0;
+            }
+        }
+
+        s_Data.SessionName = name;
+        s_Data.SessionStart = Now();
+        s_Data.FirstEvent = true;
+        s_Data.Output << "{\"otherData\":{},\"traceEvents\":[";
+
+        s_Data.StopWriter = false;
+        s_Data.Writer = std::thread(WriterLoop);
+        s_SessionActive = true;
+    }
+
+    void Instrumentor::EndSession()
+    {
+        std::lock_guard<std::mutex> sessionLock(s_Data.SessionMutex);
+        if (!s_SessionActive)
+            return;
+
+        s_SessionActive = false;
+        {
+            std::lock_guard<std::mutex> lock(s_Data.WriterMutex);
+            s_Data.StopWriter = true;
+        }
+        s_Data.WriterCondition.notify_all();
+        s_Data.Writer.join();
+
+        FlushBuffers();
+
+        uint64_t dropped = 0;
+        std::string out;
+        {
+            std::lock_guard<std::mutex> lock(s_Data.BufferMutex);
+            for (auto& buffer : s_Data.Buffers)
+            {
+                dropped += buffer->Dropped.load(std::memory_order_relaxed);
+                if (const char* threadName = buffer->Name.load(std::memory_order_relaxed))
+                {
+                    out += s_Data.FirstEvent ? "\n" : ",\n";
+                    s_Data.FirstEvent = false;
+                    out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" + std::to_string(buffer->ThreadID) + ",\"args\":{\"name\":\"";
+                    WriteEscaped(out, threadName);
+                    out += "\"}}";
+                }
+            }
+        }
+
+        s_Data.Output << out << "\n]}\n";
+        s_Data.Output.close();
+
+        if (dropped > 0)
+            HZ_CORE_WARN("Instrumentor: session '{0}' dropped {1} events, the writer could not keep up", s_Data.SessionName, dropped);
+    }
+
+    void Instrumentor::Record(const char* name, int64_t start, int64_t end)
+    {
+        Record(GetThreadBuffer(), name, start, end);
+    }
+
+    void Instrumentor::Record(ProfileTrack* buffer, const char* name, int64_t start, int64_t end)
+    {
+        uint64_t head = buffer->Head.load(std::memory_order_relaxed);
+        if (head - buffer->Tail.load(std::memory_order_acquire) >= ProfileThreadBuffer::Capacity)
+        {
+            buffer->Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer->Events[head & (ProfileThreadBuffer::Capacity - 1)] = { name, start, end };
+        buffer->Head.store(head + 1, std::memory_order_release);
+    }
+
+    void Instrumentor::SetThreadName(const char* name)
+    {
+        GetThreadBuffer()->Name.store(name, std::memory_order_relaxed);
+    }
+
+    ProfileTrack* Instrumentor::CreateTrack(const char* name)
+    {
+        ProfileThreadBuffer* track = AddBuffer();
+        track->Name.store(name, std::memory_order_relaxed);
+        return track;
+    }
+
+    const char* Instrumentor::Intern(std::string_view name)
+    {
+        std::lock_guard<std::mutex> lock(s_Data.InternMutex);
+        return s_Data.InternedNames.emplace(name).first->c_str();
+    }
+
+}
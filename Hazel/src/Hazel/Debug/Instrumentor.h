@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Hazel {
+
+    struct ProfileThreadBuffer;
+    using ProfileTrack = ProfileThreadBuffer;
+
+    // Scoped CPU profiler. Every thread records finished scopes into its own fixed-size
+    // single-producer ring; a background thread drains the rings and streams them to a
+    // Chrome trace JSON file (chrome://tracing, ui.perfetto.dev) while the session runs.
+    // Scopes are only recorded between BeginSession and EndSession.
+    class Instrumentor
+    {
+    public:
+        static void BeginSession(const std::string& name, const std::string& filepath);
+        static void EndSession();
+
+        static bool IsSessionActive() { return s_SessionActive.load(std::memory_order_relaxed); }
+
+        // Nanoseconds on the steady clock
+        static int64_t Now()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // name is not copied: pass a string literal or the result of Intern()
+        static void Record(const char* name, int64_t start, int64_t end);
+
+        // Label for the calling thread in the trace viewer; same lifetime rule as Record
+        static void SetThreadName(const char* name);
+
+        // A lane of its own in the trace for events that are not CPU scopes of the recording
+        // thread, e.g. GPU timings. Only one thread at a time may record into a track.
+        static ProfileTrack* CreateTrack(const char* name);
+        static void Record(ProfileTrack* track, const char* name, int64_t start, int64_t end);
+
+        // Copy of name that stays valid until the process exits
+        static const char* Intern(std::string_view name);
+    private:
+        static std::atomic<bool> s_SessionActive;
+    };
+
+    class ProfileTimer
+    {
+    public:
+        ProfileTimer(const char* name)
+            : m_Name(name), m_Start(Instrumentor::IsSessionActive() ? Instrumentor::Now() : -1)
+        {
+        }
+
+        ~ProfileTimer()
+        {
+            if (m_Start >= 0)
+                Instrumentor::Record(m_Name, m_Start, Instrumentor::Now());
+        }
+
+        ProfileTimer(const ProfileTimer&) = delete;
+        ProfileTimer& operator=(const ProfileTimer&) = delete;
+    private:
+        const char* m_Name;
+        int64_t m_Start;
+    };
+
+}
+
+#ifndef HZ_PROFILE
+    #define HZ_PROFILE 0
+#endif
+
+#if HZ_PROFILE
+    #if defined(_MSC_VER)
+        #define HZ_FUNC_SIG __FUNCSIG__
+    #elif defined(__GNUC__) || defined(__clang__)
+        #define HZ_FUNC_SIG __PRETTY_FUNCTION__
+    #else
+        #define HZ_FUNC_SIG __func__
+    #endif
+
+    #define HZ_PROFILE_BEGIN_SESSION(name, filepath) ::Hazel::Instrumentor::BeginSession(name, filepath)
+    #define HZ_PROFILE_END_SESSION() ::Hazel::Instrumentor::EndSession()
+    #define HZ_PROFILE_SCOPE_LINE2(name, line) ::Hazel::ProfileTimer profileTimer##line(name)
+    #define HZ_PROFILE_SCOPE_LINE(name, line) HZ_PROFILE_SCOPE_LINE2(name, line)
+    #define HZ_PROFILE_SCOPE(name) HZ_PROFILE_SCOPE_LINE(name, __LINE__)
+    #define HZ_PROFILE_FUNCTION() HZ_PROFILE_SCOPE(HZ_FUNC_SIG)
+    #define HZ_PROFILE_THREAD(name) ::Hazel::Instrumentor::SetThreadName(name)
+#else
+    #define HZ_PROFILE_BEGIN_SESSION(name, filepath)
+    #define HZ_PROFILE_END_SESSION()
+    #define HZ_PROFILE_SCOPE(name)
+    #define HZ_PROFILE_FUNCTION()
+    #define HZ_PROFILE_THREAD(name)
+#endif
@@ -0,0 +1,108 @@
+#include "hzpch.h"
+#include "Hazel/Debug/ProfilerLayer.h"
+
+#include "Hazel/Core/Application.h"
+#include "Hazel/Renderer/GpuProfiler.h"
+#include "Hazel/Renderer/Renderer.h"
+
+#include <imgui.h>
+
+namespace Hazel {
+
+    static const uint32_t s_PlotFrames = 240;
+
+    struct PlotSource
+    {
+        const FrameStatsRecorder* Recorder;
+        uint32_t First;
+        float FrameStats::* Field;
+    };
+
+    static float GetPlotValue(void* data, int index)
+    {
+        const PlotSource& source = *static_cast<const PlotSource*>(data);
+        return source.Recorder->GetFrame(source.First + (uint32_t)index).*source.Field;
+    }
+
+    ProfilerLayer::ProfilerLayer(const std::string& statsFilepath)
+        : Layer("Profiler"), m_StatsFilepath(statsFilepath)
+    {
+    }
+
+    void ProfilerLayer::OnDetach()
+    {
+        if (!m_StatsFilepath.empty())
+            m_Recorder.WriteToFile(m_StatsFilepath);
+    }
+
+    void ProfilerLayer::OnUpdate(Timestep ts)
+    {
+        // ts and GetStats() both describe the previous frame; the GPU time lags a few frames
+        m_Recorder.Record(ts.GetMilliseconds(), Renderer::GetGpuProfiler().GetFrameTime(), Renderer::GetStats());
+    }
+
+    void ProfilerLayer::OnImGuiRender()
+    {
+        ImGui::Begin("Profiler");
+
+        uint32_t count = m_Recorder.GetCount();
+        if (count > 0)
+        {
+            const FrameStats& last = m_Recorder.GetFrame(count - 1);
+            FrameStatsRecorder::Percentiles cpu = m_Recorder.GetCpuFrameTimePercentiles();
+            FrameStatsRecorder::Percentiles gpu = m_Recorder.GetGpuFrameTimePercentiles();
+
+            ImGui::Text("CPU frame: %6.2f ms   p50 %6.2f  p95 %6.2f  p99 %6.2f", last.CpuFrameMs, cpu.P50, cpu.P95, cpu.P99);
+            ImGui::Text("GPU frame: %6.2f ms   p50 %6.2f  p95 %6.2f  p99 %6.2f", last.GpuFrameMs, gpu.P50, gpu.P95, gpu.P99);
+            ImGui::TextDisabled("over the last %u frames", count);
+
+            const FrameTiming& timing = Application::Get().GetFrameTiming();
+            float smoothedMs = timing.SmoothedDeltaTime * 1000.0f;
+            ImGui::Text("Smoothed:  %6.2f ms   %6.1f fps", smoothedMs, smoothedMs > 0.0f ? 1000.0f / smoothedMs : 0.0f);
+
+            uint32_t plotCount = std::min(count, s_PlotFrames);
+            PlotSource cpuSource = { &m_Recorder, count - plotCount, &FrameStats::CpuFrameMs };
+            PlotSource gpuSource = { &m_Recorder, count - plotCount, &FrameStats::GpuFrameMs };
+            float scale = std::max(16.7f, cpu.P99 * 1.5f);
+            ImGui::PlotLines("##CpuFrameTimes", GetPlotValue, &cpuSource, (int)plotCount, 0, "CPU ms", 0.0f, scale, ImVec2(0.0f, 60.0f));
+            ImGui::PlotLines("##GpuFrameTimes", GetPlotValue, &gpuSource, (int)plotCount, 0, "GPU ms", 0.0f, scale, ImVec2(0.0f, 60.0f));
+
+            ImGui::Separator();
+            const RendererStatistics& stats = last.Rendering;
+            ImGui::Text("Draw calls:      %u", stats.DrawCalls);
+            ImGui::Text("Triangles:       %llu", (unsigned long long)stats.GetTriangleCount());
+            ImGui::Text("Shader binds:    %u", stats.ShaderBinds);
+            ImGui::Text("VAO binds:       %u", stats.VertexArrayBinds);
+            ImGui::Text("Texture binds:   %u", stats.TextureBinds);
+            ImGui::Text("Uniform uploads: %u", stats.UniformUploads);
+            ImGui::Text("Bytes uploaded:  %llu", (unsigned long long)stats.BufferBytesUploaded);
+            ImGui::Text("FB switches:     %u", stats.FramebufferSwitches);
+        }
+
+        ImGui::Separator();
+        if (ImGui::BeginTable("GpuPasses", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV))
+        {
+            ImGui::TableSetupColumn("Pass");
+            ImGui::TableSetupColumn("GPU ms");
+            ImGui::TableSetupColumn("avg ms");
+            ImGui::TableHeadersRow();
+
+            for (const GpuProfiler::PassTiming& pass : Renderer::GetGpuProfiler().GetPassTimings())
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Indent(pass.Depth * 12.0f);
+                ImGui::TextUnformatted(pass.Name);
+                ImGui::Unindent(pass.Depth * 12.0f);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", pass.LastMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", pass.AverageMs);
+            }
+            ImGui::EndTable();
+        }
+
+        ImGui::End();
+    }
+
+}
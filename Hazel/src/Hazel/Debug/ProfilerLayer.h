@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Hazel/Core/Layer.h"
+#include "Hazel/Debug/FrameStatsRecorder.h"
+
+namespace Hazel {
+
+    // ImGui overlay with CPU/GPU frame-time history and percentiles, the GPU time of every
+    // profiled render pass (see GpuProfiler) and the renderer counters of the last frame.
+    // With a statistics path the recorded frames are written there when the layer detaches.
+    class ProfilerLayer : public Layer
+    {
+    public:
+        ProfilerLayer(const std::string& statsFilepath = std::string());
+
+        virtual void OnDetach() override;
+        virtual void OnUpdate(Timestep ts) override;
+        virtual void OnImGuiRender() override;
+
+        const FrameStatsRecorder& GetRecorder() const { return m_Recorder; }
+    private:
+        FrameStatsRecorder m_Recorder;
+        std::string m_StatsFilepath;
+    };
+
+}
@@ -10,7 +10,17 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
     Hazel::Log::Init();
 
     // Let the actual project to implement the CreateApplication() and return the app*
+    HZ_PROFILE_BEGIN_SESSION("Startup", "HazelProfile-Startup.json");
     auto app = Hazel::CreateApplication();
+    HZ_PROFILE_END_SESSION();
+
+    HZ_PROFILE_BEGIN_SESSION("Runtime", "HazelProfile-Runtime.json");
     app->Run();
+    HZ_PROFILE_END_SESSION();
+
+    HZ_PROFILE_BEGIN_SESSION("Shutdown", "HazelProfile-Shutdown.json");
     delete app;
+    HZ_PROFILE_END_SESSION();
+
+    Hazel::Log::Shutdown();
 }
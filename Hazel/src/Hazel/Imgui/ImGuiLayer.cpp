@@ -6,11 +6,42 @@
 #include "backends/imgui_impl_opengl3.h"
 
 #include "Hazel/Core/Application.h"
+#include "Hazel/Core/FrameAllocator.h"
+#include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/GpuProfiler.h"
 
 #include <GLFW/glfw3.h>
 
 namespace Hazel {
 
+    // ImDrawData only points at draw lists ImGui rebuilds next frame, so the render thread
+    // gets its own copies of the frame it is about to draw. Lives in frame memory.
+    struct ImGuiDrawDataSnapshot
+    {
+        ImDrawData DrawData;
+        FrameVector<ImDrawList*> CmdLists;
+
+        ImGuiDrawDataSnapshot(const ImDrawData* source)
+            : DrawData(*source)
+        {
+            CmdLists.reserve(source->CmdListsCount);
+            for (int i = 0; i < source->CmdListsCount; i++)
+                CmdLists.push_back(source->CmdLists[i]->CloneOutput());
+            DrawData.CmdLists = CmdLists.data();
+        }
+
+        ~ImGuiDrawDataSnapshot()
+        {
+            for (ImDrawList* list : CmdLists)
+                IM_DELETE(list);
+        }
+    };
+
+    static bool UseRenderThread()
+    {
+        return Renderer::GetConfig().Threading == RenderThreadingPolicy::MultiThreaded;
+    }
+
     ImGuiLayer::ImGuiLayer()
         : Layer("ImGuiLayer")
     {
@@ -25,7 +56,9 @@ namespace Hazel {
         io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;       // Enable Keyboard Controls
         //io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;      // Enable Gamepad Controls
         io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;           // Enable Docking
-        io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;         // Enable Multi-Viewport / Platform Windows
+        // Platform windows need their own contexts made current on the main thread
+        if (!UseRenderThread())
+            io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;     // Enable Multi-Viewport / Platform Windows
         //io.ConfigFlags |= ImGuiConfigFlags_ViewportsNoTaskBarIcons;
         //io.ConfigFlags |= ImGuiConfigFlags_ViewportsNoMerge;
 
@@ -47,6 +80,10 @@ namespace Hazel {
         // Setup Platform/Renderer bindings
         ImGui_ImplGlfw_InitForOpenGL(window, true);
         ImGui_ImplOpenGL3_Init("#version 410");
+
+        // The context still belongs to this thread: create the font texture and shaders now
+        // instead of lazily in ImGui_ImplOpenGL3_NewFrame
+        ImGui_ImplOpenGL3_CreateDeviceObjects();
     }
 
     void ImGuiLayer::OnDetach()
@@ -58,7 +95,8 @@ namespace Hazel {
     
     void ImGuiLayer::Begin()
     {
-        ImGui_ImplOpenGL3_NewFrame();
+        if (!UseRenderThread())
+            ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
     }
@@ -71,7 +109,22 @@ namespace Hazel {
 
         // Rendering
         ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        {
+            GpuPassScope gpuPass(Renderer::GetGpuProfiler(), "ImGui");
+            if (UseRenderThread())
+            {
+                ImGuiDrawDataSnapshot* snapshot = FrameAllocator::New<ImGuiDrawDataSnapshot>(ImGui::GetDrawData());
+                Renderer::Submit([snapshot]()
+                {
+                    ImGui_ImplOpenGL3_RenderDrawData(&snapshot->DrawData);
+                    snapshot->~ImGuiDrawDataSnapshot();
+                });
+            }
+            else
+            {
+                ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+            }
+        }
 
         if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
         {
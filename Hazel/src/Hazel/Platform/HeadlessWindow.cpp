@@ -0,0 +1,137 @@
+#include "hzpch.h"
+#include "glad/glad.h"
+
+#include "HeadlessWindow.h"
+
+#include "Hazel/Core/Log.h"
+#include "Hazel/Platform/OpenGL/OpenGLContext.h"
+#include "Hazel/Platform/Recording/RecordingContext.h"
+#include "Hazel/Renderer/Renderer.h"
+
+#include <GLFW/glfw3.h>
+
+#include <cstdlib>
+
+namespace Hazel {
+
+    static const char* GetContextAPIName(HeadlessContextAPI api)
+    {
+        switch (api)
+        {
+            case HeadlessContextAPI::Auto:   return "auto";
+            case HeadlessContextAPI::Native: return "native";
+            case HeadlessContextAPI::EGL:    return "egl";
+            case HeadlessContextAPI::OSMesa: return "osmesa";
+        }
+        return "unknown";
+    }
+
+    HeadlessWindow::HeadlessWindow(const WindowProps& props)
+    {
+        Init(props);
+    }
+
+    HeadlessWindow::~HeadlessWindow()
+    {
+        Shutdown();
+    }
+
+    void HeadlessWindow::Init(const WindowProps& props)
+    {
+        m_Width = props.Width;
+        m_Height = props.Height;
+
+        if (Renderer::GetAPI() == RendererAPI::API::None)
+        {
+            HZ_CORE_INFO("Creating headless window {0} ({1}, {2}) without a context", props.Title, props.Width, props.Height);
+            m_Context = new RecordingContext();
+            return;
+        }
+
+        bool hasDisplay = std::getenv("DISPLAY") || std::getenv("WAYLAND_DISPLAY");
+
+#ifdef GLFW_PLATFORM_NULL
+        // GLFW 3.4+: no display server needed at all
+        if (!hasDisplay)
+            glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#endif
+
+        int success = glfwInit();
+        HZ_CORE_ASSERT(success, "Could not intialize GLFW!");
+
+        // Without a display, EGL first: on a GPU node without one it gives a hardware context,
+        // where OSMesa always rasterizes on the CPU. OSMesa only if EGL can't make a context.
+        std::vector<HeadlessContextAPI> attempts = { props.ContextAPI };
+        if (props.ContextAPI == HeadlessContextAPI::Auto)
+            attempts = hasDisplay ? std::vector<HeadlessContextAPI>{ HeadlessContextAPI::Native }
+                                  : std::vector<HeadlessContextAPI>{ HeadlessContextAPI::EGL, HeadlessContextAPI::OSMesa };
+
+        HeadlessContextAPI contextAPI = attempts.front();
+        for (HeadlessContextAPI attempt : attempts)
+        {
+            contextAPI = attempt;
+            HZ_CORE_INFO("Creating headless window {0} ({1}, {2}), {3} context", props.Title, props.Width, props.Height, GetContextAPIName(contextAPI));
+
+            m_Window = CreateGLFWWindow(props, contextAPI);
+            if (m_Window)
+                break;
+            HZ_CORE_WARN("Headless window: no OpenGL 4.5 context from {0}", GetContextAPIName(contextAPI));
+        }
+        HZ_CORE_ASSERT(m_Window, "Could not create an OpenGL 4.5 context!");
+
+        m_Context = new OpenGLContext(m_Window);
+        m_Context->Init();
+
+        // Which device actually renders decides the timings; say so when it's the CPU
+        std::string renderer = (const char*)glGetString(GL_RENDERER);
+        bool software = renderer.find("llvmpipe") != std::string::npos || renderer.find("softpipe") != std::string::npos
+            || renderer.find("swrast") != std::string::npos;
+        if (software)
+            HZ_CORE_WARN("Headless window: {0} context renders in software ({1})", GetContextAPIName(contextAPI), renderer);
+        else
+            HZ_CORE_INFO("Headless window: {0} context on {1}", GetContextAPIName(contextAPI), renderer);
+
+        SetVSync(false);
+    }
+
+    GLFWwindow* HeadlessWindow::CreateGLFWWindow(const WindowProps& props, HeadlessContextAPI contextAPI)
+    {
+        if (contextAPI == HeadlessContextAPI::EGL)
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+        else if (contextAPI == HeadlessContextAPI::OSMesa)
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+
+        // Direct state access and timestamp queries; EGL and OSMesa only go past 3.0 when asked
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+        GLFWwindow* window = glfwCreateWindow((int)props.Width, (int)props.Height, props.Title.c_str(), nullptr, nullptr);
+        glfwDefaultWindowHints();
+        return window;
+    }
+
+    void HeadlessWindow::Shutdown()
+    {
+        delete m_Context;
+        if (m_Window)
+            glfwDestroyWindow(m_Window);
+    }
+
+    void HeadlessWindow::SetVSync(bool enabled)
+    {
+        if (enabled)
+            HZ_CORE_WARN("Headless window: VSync stays off, there is no display to wait for");
+        if (!m_Window)
+            return;
+
+        // Swaps still happen when the caller presents the default framebuffer; don't let the
+        // driver's default interval pace them
+        Renderer::Submit([]()
+        {
+            glfwSwapInterval(0);
+        });
+    }
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "Hazel/Core/Window.h"
+#include "Hazel/Renderer/GraphicsContext.h"
+
+struct GLFWwindow;
+
+namespace Hazel {
+
+    // Window for batch rendering on machines without a display: an invisible GLFW window whose
+    // context can come from EGL or OSMesa, and no window at all with RendererAPI::None. There is
+    // no input and no presentation; VSync is always off.
+    class HeadlessWindow : public Window
+    {
+    public:
+        HeadlessWindow(const WindowProps& props);
+        virtual ~HeadlessWindow();
+
+        // Nothing to poll or present
+        void OnUpdate() override {}
+
+        inline unsigned int GetWidth() const override { return m_Width; }
+        inline unsigned int GetHeight() const override { return m_Height; }
+
+        // Never produces events
+        inline void SetEventCallback(const EventCallbackFn& callback) override {}
+        void SetVSync(bool enabled) override;
+        bool IsVSync() const override { return false; }
+
+        // nullptr with RendererAPI::None
+        inline virtual void* GetNativeWindow() const override { return m_Window; }
+        inline virtual GraphicsContext* GetContext() const override { return m_Context; }
+    private:
+        void Init(const WindowProps& props);
+        void Shutdown();
+
+        // nullptr if contextAPI can't make a 4.5 core context
+        static GLFWwindow* CreateGLFWWindow(const WindowProps& props, HeadlessContextAPI contextAPI);
+    private:
+        GLFWwindow* m_Window = nullptr;
+        GraphicsContext* m_Context = nullptr;
+        unsigned int m_Width, m_Height;
+    };
+
+}
@@ -1,6 +1,9 @@
 #include "hzpch.h"
 #include "OpenGLBuffer.h"
 
+#include "Hazel/Core/FrameAllocator.h"
+#include "Hazel/Renderer/Renderer.h"
+
 #include <glad/glad.h>
 
 namespace Hazel {
@@ -10,10 +13,28 @@ namespace Hazel {
     /////////////////////////////////////////////////////////////////////////////
 
     OpenGLVertexBuffer::OpenGLVertexBuffer(float* vertices, uint32_t size)
+        : m_Size(size)
+    {
+        // The caller's array may be gone by the time the render thread uploads it
+        std::vector<uint8_t> data((uint8_t*)vertices, (uint8_t*)vertices + size);
+        Renderer::GetRecordingStats().BufferBytesUploaded += size;
+        Renderer::Submit([this, data = std::move(data)]()
+        {
+            glCreateBuffers(1, &m_RendererID);
+            glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+            glBufferData(GL_ARRAY_BUFFER, data.size(), data.data(), GL_STATIC_DRAW);
+        });
+    }
+
+    OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size)
+        : m_Size(size)
     {
-        glCreateBuffers(1, &m_RendererID);
-        glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-        glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+        Renderer::Submit([this, size]()
+        {
+            glCreateBuffers(1, &m_RendererID);
+            glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+            glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+        });
     }
 
     OpenGLVertexBuffer::~OpenGLVertexBuffer()
@@ -23,12 +44,32 @@ namespace Hazel {
 
     void OpenGLVertexBuffer::Bind() const
     {
-        glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+        Renderer::Submit([this]()
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+        });
     }
 
     void OpenGLVertexBuffer::Unbind() const
     {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        Renderer::Submit([]()
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        });
+    }
+
+    void OpenGLVertexBuffer::SetData(const void* data, uint32_t size)
+    {
+        HZ_CORE_ASSERT(size <= m_Size, "Data is larger than the vertex buffer!");
+
+        // Per-frame data: the copy lives in the frame arena until the render thread is done with it
+        void* copy = FrameAllocator::Allocate(size);
+        memcpy(copy, data, size);
+        Renderer::GetRecordingStats().BufferBytesUploaded += size;
+        Renderer::Submit([this, copy, size]()
+        {
+            glNamedBufferSubData(m_RendererID, 0, size, copy);
+        });
     }
 
     /////////////////////////////////////////////////////////////////////////////
@@ -38,9 +79,14 @@ namespace Hazel {
     OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t* indices, uint32_t count)
         : m_Count(count)
     {
-        glCreateBuffers(1, &m_RendererID);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+        std::vector<uint32_t> data(indices, indices + count);
+        Renderer::GetRecordingStats().BufferBytesUploaded += count * sizeof(uint32_t);
+        Renderer::Submit([this, data = std::move(data)]()
+        {
+            glCreateBuffers(1, &m_RendererID);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, data.size() * sizeof(uint32_t), data.data(), GL_STATIC_DRAW);
+        });
     }
 
     OpenGLIndexBuffer::~OpenGLIndexBuffer()
@@ -50,12 +96,18 @@ namespace Hazel {
 
     void OpenGLIndexBuffer::Bind() const
     {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+        Renderer::Submit([this]()
+        {
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+        });
     }
 
     void OpenGLIndexBuffer::Unbind() const
     {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        Renderer::Submit([]()
+        {
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        });
     }
 
-}
\ No newline at end of file
+}
@@ -8,6 +8,7 @@ namespace Hazel {
     {
     public:
         OpenGLVertexBuffer(float* vertices, uint32_t size);
+        OpenGLVertexBuffer(uint32_t size);
         virtual ~OpenGLVertexBuffer();
 
         virtual void Bind() const override;
@@ -16,8 +17,10 @@ namespace Hazel {
         virtual const BufferLayout& GetLayout() const override { return m_Layout; }
         virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
 
+        virtual void SetData(const void* data, uint32_t size) override;
     private:
-        uint32_t m_RendererID;
+        uint32_t m_RendererID = 0;
+        uint32_t m_Size;
         BufferLayout m_Layout;
     };
 
@@ -32,7 +35,7 @@ namespace Hazel {
 
         virtual uint32_t GetCount() const { return m_Count; }
     private:
-        uint32_t m_RendererID;
+        uint32_t m_RendererID = 0;
         uint32_t m_Count;
     };
 
@@ -2,6 +2,8 @@
 #include "OpenGLContext.h"
 #include <glad/glad.h>
 
+#include "Hazel/Renderer/Renderer.h"
+
 #include <GLFW/glfw3.h>
 
 namespace Hazel {
@@ -26,7 +28,21 @@ namespace Hazel {
 
     void OpenGLContext::SwapBuffers()
     {
-        glfwSwapBuffers(m_WindowHandle);
+        GLFWwindow* window = m_WindowHandle;
+        Renderer::Submit([window]()
+        {
+            glfwSwapBuffers(window);
+        });
+    }
+
+    void OpenGLContext::MakeCurrent()
+    {
+        glfwMakeContextCurrent(m_WindowHandle);
+    }
+
+    void OpenGLContext::ReleaseCurrent()
+    {
+        glfwMakeContextCurrent(nullptr);
     }
 
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "hzpch.h"
 #include "Hazel/Platform/OpenGL/OpenGLFramebuffer.h"
 
+#include "Hazel/Core/JobSystem.h"
+#include "Hazel/Renderer/Renderer.h"
+
 #include <glad/glad.h>
 
 namespace Hazel {
@@ -108,6 +111,7 @@ namespace Hazel {
 				m_DepthAttachmentSpecification = spec;
 		}
 
+		UpdateStorageSize();
 		Invalidate();
 	}
 
@@ -116,9 +120,29 @@ namespace Hazel {
 		glDeleteFramebuffers(1, &m_RendererID);
 		glDeleteTextures(m_ColorAttachments.size(), m_ColorAttachments.data());
 		glDeleteTextures(1, &m_DepthAttachment);
+
+		// Readbacks still in flight are dropped without invoking their callbacks
+		if (m_ReadbackCount)
+			Renderer::RT_RemoveReadbackSource(this);
+		for (auto& readback : m_Readbacks)
+		{
+			if (readback.Fence)
+				glDeleteSync((GLsync)readback.Fence);
+			if (readback.PixelPackBuffer)
+				glDeleteBuffers(1, &readback.PixelPackBuffer);
+		}
 	}
 
 	void OpenGLFramebuffer::Invalidate()
+	{
+		uint32_t width = m_StorageWidth, height = m_StorageHeight;
+		Renderer::Submit([this, width, height]()
+		{
+			RT_Invalidate(width, height);
+		});
+	}
+
+	void OpenGLFramebuffer::RT_Invalidate(uint32_t width, uint32_t height)
 	{
 		if (m_RendererID)
 		{
@@ -147,10 +171,10 @@ namespace Hazel {
 				switch (m_ColorAttachmentSpecifications[i].TextureFormat)
 				{
 					case FramebufferTextureFormat::RGBA8:
-						Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_RGBA8, GL_RGBA, m_Specification.Width, m_Specification.Height, i);
+						Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_RGBA8, GL_RGBA, width, height, i);
 						break;
 					case FramebufferTextureFormat::RED_INTEGER:
-						Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_R32I, GL_RED_INTEGER, m_Specification.Width, m_Specification.Height, i);
+						Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_R32I, GL_RED_INTEGER, width, height, i);
 						break;
 				}
 			}
@@ -163,7 +187,7 @@ namespace Hazel {
 			switch (m_DepthAttachmentSpecification.TextureFormat)
 			{
 				case FramebufferTextureFormat::DEPTH24STENCIL8:
-					Utils::AttachDepthTexture(m_DepthAttachment, m_Specification.Samples, GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL_ATTACHMENT, m_Specification.Width, m_Specification.Height);
+					Utils::AttachDepthTexture(m_DepthAttachment, m_Specification.Samples, GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL_ATTACHMENT, width, height);
 					break;
 			}
 		}
@@ -187,13 +211,35 @@ namespace Hazel {
 
 	void OpenGLFramebuffer::Bind()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
-		glViewport(0, 0, m_Specification.Width, m_Specification.Height);
+		Renderer::GetRecordingStats().FramebufferSwitches++;
+		uint32_t width = m_Specification.Width, height = m_Specification.Height;
+		Renderer::Submit([this, width, height]()
+		{
+			if (m_ReadbackCount)
+				RT_PollReadbacks();
+
+			glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
+			glViewport(0, 0, width, height);
+		});
 	}
 
 	void OpenGLFramebuffer::Unbind()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		Renderer::GetRecordingStats().FramebufferSwitches++;
+		Renderer::Submit([]()
+		{
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		});
+	}
+
+	void OpenGLFramebuffer::BindColorAttachment(uint32_t index, uint32_t slot)
+	{
+		HZ_CORE_ASSERT(index < m_ColorAttachmentSpecifications.size(), "");
+		Renderer::GetRecordingStats().TextureBinds++;
+		Renderer::Submit([this, index, slot]()
+		{
+			glBindTextureUnit(slot, m_ColorAttachments[index]);
+		});
 	}
 
 	void OpenGLFramebuffer::Resize(uint32_t width, uint32_t height)
@@ -203,14 +249,40 @@ namespace Hazel {
 			HZ_CORE_WARN("Attempted to rezize framebuffer to {0}, {1}", width, height);
 			return;
 		}
+		if (width == m_Specification.Width && height == m_Specification.Height)
+			return;
+
 		m_Specification.Width = width;
 		m_Specification.Height = height;
-		
+
+		// Over-allocated storage is kept while the new size still fits and is not much smaller;
+		// Bind() only narrows the viewport to the new sub-rect.
+		if (m_Specification.Overallocate
+			&& width <= m_StorageWidth && height <= m_StorageHeight
+			&& width * 2 > m_StorageWidth && height * 2 > m_StorageHeight)
+			return;
+
+		UpdateStorageSize();
 		Invalidate();
 	}
 
+	void OpenGLFramebuffer::UpdateStorageSize()
+	{
+		if (m_Specification.Overallocate)
+		{
+			m_StorageWidth = std::min(Framebuffer::GetStorageBucket(m_Specification.Width), s_MaxFramebufferSize);
+			m_StorageHeight = std::min(Framebuffer::GetStorageBucket(m_Specification.Height), s_MaxFramebufferSize);
+		}
+		else
+		{
+			m_StorageWidth = m_Specification.Width;
+			m_StorageHeight = m_Specification.Height;
+		}
+	}
+
 	int OpenGLFramebuffer::ReadPixel(uint32_t attachmentIndex, int x, int y)
 	{
+		HZ_CORE_ASSERT(Renderer::IsRenderThread(), "ReadPixel would stall a frame behind the render thread, use ReadPixelsAsync");
 		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "");
 
 		glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
@@ -220,13 +292,175 @@ namespace Hazel {
 
 	}
 
+	void OpenGLFramebuffer::CheckReadbackRect(uint32_t attachmentIndex, const FramebufferRect& rect) const
+	{
+		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachmentSpecifications.size(), "");
+		HZ_CORE_ASSERT(m_Specification.Samples == 1, "Cannot read back a multisampled framebuffer");
+		HZ_CORE_ASSERT(rect.X >= 0 && rect.Y >= 0 && rect.Width > 0 && rect.Height > 0
+			&& rect.X + rect.Width <= m_Specification.Width && rect.Y + rect.Height <= m_Specification.Height,
+			"Readback rect is outside the framebuffer");
+	}
+
+	void OpenGLFramebuffer::ReadPixelsAsync(uint32_t attachmentIndex, const FramebufferRect& rect, const ReadPixelsCallback& callback)
+	{
+		CheckReadbackRect(attachmentIndex, rect);
+		Renderer::Submit([this, attachmentIndex, rect, callback]()
+		{
+			RT_ReadPixelsAsync(attachmentIndex, rect, callback, nullptr);
+		});
+	}
+
+	void OpenGLFramebuffer::ReadPixelsBufferAsync(uint32_t attachmentIndex, const FramebufferRect& rect, const ReadPixelsBufferCallback& callback)
+	{
+		CheckReadbackRect(attachmentIndex, rect);
+		Renderer::Submit([this, attachmentIndex, rect, callback]()
+		{
+			RT_ReadPixelsAsync(attachmentIndex, rect, nullptr, callback);
+		});
+	}
+
+	void OpenGLFramebuffer::RT_ReadPixelsAsync(uint32_t attachmentIndex, const FramebufferRect& rect, const ReadPixelsCallback& callback, const ReadPixelsBufferCallback& bufferCallback)
+	{
+		RT_PollReadbacks();
+
+		// Ring is full: add a slot rather than wait on the oldest. It goes in at the head, so the
+		// slots in flight stay in submission order behind it.
+		if (m_ReadbackCount == m_Readbacks.size())
+			m_Readbacks.emplace(m_Readbacks.begin() + m_ReadbackHead);
+
+		bool integer = m_ColorAttachmentSpecifications[attachmentIndex].TextureFormat == FramebufferTextureFormat::RED_INTEGER;
+		GLenum format = integer ? GL_RED_INTEGER : GL_RGBA;
+		GLenum type = integer ? GL_INT : GL_UNSIGNED_BYTE;
+
+		PendingReadback& readback = m_Readbacks[m_ReadbackHead];
+		readback.Rect = rect;
+		readback.Callback = callback;
+		readback.BufferCallback = bufferCallback;
+		readback.Size = rect.Width * rect.Height * 4;
+
+		if (!readback.PixelPackBuffer)
+			glCreateBuffers(1, &readback.PixelPackBuffer);
+		if (readback.Capacity < readback.Size)
+		{
+			glNamedBufferData(readback.PixelPackBuffer, readback.Size, nullptr, GL_STREAM_READ);
+			readback.Capacity = readback.Size;
+		}
+
+		GLint previousReadFramebuffer = 0;
+		glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousReadFramebuffer);
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, m_RendererID);
+		glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.PixelPackBuffer);
+		glReadPixels(rect.X, rect.Y, rect.Width, rect.Height, format, type, nullptr);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, previousReadFramebuffer);
+
+		readback.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		m_ReadbackHead = (m_ReadbackHead + 1) % (uint32_t)m_Readbacks.size();
+		if (m_ReadbackCount++ == 0)
+			Renderer::RT_AddReadbackSource(this);
+	}
+
+	void OpenGLFramebuffer::PollReadbacks()
+	{
+		Renderer::Submit([this]()
+		{
+			RT_PollReadbacks();
+		});
+	}
+
+	void OpenGLFramebuffer::RT_PollReadbacks()
+	{
+		while (m_ReadbackCount > 0)
+		{
+			uint32_t size = (uint32_t)m_Readbacks.size();
+			uint32_t oldest = (m_ReadbackHead + size - m_ReadbackCount) % size;
+			PendingReadback& readback = m_Readbacks[oldest];
+
+			GLenum status = glClientWaitSync((GLsync)readback.Fence, 0, 0);
+			if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+				break;
+
+			CompleteReadback(readback);
+			if (--m_ReadbackCount == 0)
+				Renderer::RT_RemoveReadbackSource(this);
+		}
+	}
+
+	void OpenGLFramebuffer::CompleteReadback(PendingReadback& readback)
+	{
+		glDeleteSync((GLsync)readback.Fence);
+		readback.Fence = nullptr;
+
+		const void* pixels = glMapNamedBufferRange(readback.PixelPackBuffer, 0, readback.Size, GL_MAP_READ_BIT);
+		if (pixels)
+		{
+			bool multiThreaded = Renderer::GetConfig().Threading == RenderThreadingPolicy::MultiThreaded;
+			if (readback.BufferCallback)
+			{
+				// The one copy out of the mapping is the buffer handed over
+				std::vector<uint8_t> buffer((const uint8_t*)pixels, (const uint8_t*)pixels + readback.Size);
+				if (multiThreaded)
+				{
+					JobSystem::ScheduleOnMainThread([callback = readback.BufferCallback, rect = readback.Rect, buffer = std::move(buffer)]() mutable
+					{
+						callback(std::move(buffer), rect);
+					});
+				}
+				else
+				{
+					readback.BufferCallback(std::move(buffer), readback.Rect);
+				}
+			}
+			else if (readback.Callback && multiThreaded)
+			{
+				// Deliver on the main thread that asked for it; the mapping does not outlive this call
+				std::vector<uint8_t> copy((const uint8_t*)pixels, (const uint8_t*)pixels + readback.Size);
+				JobSystem::ScheduleOnMainThread([callback = readback.Callback, rect = readback.Rect, copy = std::move(copy)]()
+				{
+					callback(copy.data(), rect);
+				});
+			}
+			else if (readback.Callback)
+			{
+				readback.Callback(pixels, readback.Rect);
+			}
+			glUnmapNamedBuffer(readback.PixelPackBuffer);
+		}
+		else
+		{
+			HZ_CORE_ERROR("Failed to map pixel pack buffer for framebuffer readback");
+		}
+
+		readback.Callback = nullptr;
+		readback.BufferCallback = nullptr;
+	}
+
 	void OpenGLFramebuffer::ClearAttachment(uint32_t attachmentIndex, int value)
 	{
-		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "");
+		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachmentSpecifications.size(), "");
 
-		auto& spec = m_ColorAttachmentSpecifications[attachmentIndex];
-		glClearTexImage(m_ColorAttachments[attachmentIndex], 0,
-			Utils::HazelFBTextureFormatToGL(spec.TextureFormat), GL_INT, &value);
+		Renderer::Submit([this, attachmentIndex, value]()
+		{
+			auto& spec = m_ColorAttachmentSpecifications[attachmentIndex];
+			glClearTexImage(m_ColorAttachments[attachmentIndex], 0,
+				Utils::HazelFBTextureFormatToGL(spec.TextureFormat), GL_INT, &value);
+		});
+	}
+
+	void OpenGLFramebuffer::CopyColorAttachment(uint32_t attachmentIndex, const Ref<Framebuffer>& destination, const FramebufferRect& rect)
+	{
+		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachmentSpecifications.size(), "");
+		HZ_CORE_ASSERT(m_Specification.Samples == 1 && destination->GetSpecification().Samples == 1, "Cannot copy a multisampled framebuffer");
+
+		Renderer::Submit([this, attachmentIndex, destination, rect]()
+		{
+			glCopyImageSubData(m_ColorAttachments[attachmentIndex], GL_TEXTURE_2D, 0, rect.X, rect.Y, 0,
+				destination->GetColorAttachmentRendererID(attachmentIndex), GL_TEXTURE_2D, 0, rect.X, rect.Y, 0,
+				rect.Width, rect.Height, 1);
+		});
 	}
 
 }
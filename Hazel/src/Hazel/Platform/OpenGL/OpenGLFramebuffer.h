@@ -14,24 +14,65 @@ namespace Hazel {
 
 		virtual void Bind() override;
 		virtual void Unbind() override;
+		virtual void BindColorAttachment(uint32_t index, uint32_t slot) override;
 
 		virtual void Resize(uint32_t width, uint32_t height) override;
 		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
 
+		virtual void ReadPixelsAsync(uint32_t attachmentIndex, const FramebufferRect& rect, const ReadPixelsCallback& callback) override;
+		virtual void ReadPixelsBufferAsync(uint32_t attachmentIndex, const FramebufferRect& rect, const ReadPixelsBufferCallback& callback) override;
+		virtual void PollReadbacks() override;
+
 		virtual void ClearAttachment(uint32_t attachmentIndex, int value) override;
+		virtual void CopyColorAttachment(uint32_t attachmentIndex, const Ref<Framebuffer>& destination, const FramebufferRect& rect) override;
 
 		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override { HZ_CORE_ASSERT(index < m_ColorAttachments.size(),""); return m_ColorAttachments[index]; }
 
 		virtual const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
+
+		virtual uint32_t GetStorageWidth() const override { return m_StorageWidth; }
+		virtual uint32_t GetStorageHeight() const override { return m_StorageHeight; }
 	private:
-		uint32_t m_RendererID = 0;
+		void UpdateStorageSize();
+
+		// Render thread side of Invalidate/ReadPixelsAsync/PollReadbacks
+		void RT_Invalidate(uint32_t width, uint32_t height);
+		void RT_ReadPixelsAsync(uint32_t attachmentIndex, const FramebufferRect& rect, const ReadPixelsCallback& callback, const ReadPixelsBufferCallback& bufferCallback);
+		void RT_PollReadbacks();
+
+		struct PendingReadback
+		{
+			uint32_t PixelPackBuffer = 0;
+			uint32_t Capacity = 0;
+			uint32_t Size = 0;
+			void* Fence = nullptr; // GLsync
+			FramebufferRect Rect;
+			ReadPixelsCallback Callback;             // One of these
+			ReadPixelsBufferCallback BufferCallback;
+		};
+
+		void CheckReadbackRect(uint32_t attachmentIndex, const FramebufferRect& rect) const;
+		void CompleteReadback(PendingReadback& readback);
+	private:
+		// Main thread: requested size and storage decisions
 		FramebufferSpecification m_Specification;
+		uint32_t m_StorageWidth = 0, m_StorageHeight = 0;
+
+		// Render thread: GL objects and the readback ring
+		uint32_t m_RendererID = 0;
 
 		std::vector<FramebufferTextureSpecification> m_ColorAttachmentSpecifications;
 		FramebufferTextureSpecification m_DepthAttachmentSpecification = FramebufferTextureFormat::None;
 
 		std::vector<uint32_t> m_ColorAttachments;
 		uint32_t m_DepthAttachment = 0;
+
+		// Ring of pixel-pack buffers, completed strictly in submission order. Starts at
+		// s_InitialReadbackRingSize and grows when a readback finds it full, rather than waiting.
+		static const uint32_t s_InitialReadbackRingSize = 3;
+		std::vector<PendingReadback> m_Readbacks = std::vector<PendingReadback>(s_InitialReadbackRingSize);
+		uint32_t m_ReadbackHead = 0;  // next slot to submit into
+		uint32_t m_ReadbackCount = 0; // slots in flight
 	};
 
 }
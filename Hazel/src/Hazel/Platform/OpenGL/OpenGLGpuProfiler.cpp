@@ -0,0 +1,206 @@
+#include "hzpch.h"
+#include "OpenGLGpuProfiler.h"
+
+#include "Hazel/Renderer/Renderer.h"
+
+#include <glad/glad.h>
+
+#include <cstring>
+
+namespace Hazel {
+
+    static const float s_AverageWeight = 0.1f;
+
+    OpenGLGpuProfiler::OpenGLGpuProfiler()
+    {
+        Renderer::Submit([this]()
+        {
+            for (FrameQueries& frame : m_Frames)
+                glCreateQueries(GL_TIMESTAMP, (GLsizei)std::size(frame.Queries), frame.Queries);
+        });
+    }
+
+    OpenGLGpuProfiler::~OpenGLGpuProfiler()
+    {
+        for (FrameQueries& frame : m_Frames)
+            glDeleteQueries((GLsizei)std::size(frame.Queries), frame.Queries);
+    }
+
+    void OpenGLGpuProfiler::BeginFrame()
+    {
+        Renderer::Submit([this]() { RT_BeginFrame(); });
+    }
+
+    void OpenGLGpuProfiler::EndFrame()
+    {
+        Renderer::Submit([this]() { RT_EndFrame(); });
+    }
+
+    void OpenGLGpuProfiler::BeginPass(const char* name)
+    {
+        Renderer::Submit([this, name]() { RT_BeginPass(name); });
+    }
+
+    void OpenGLGpuProfiler::EndPass()
+    {
+        Renderer::Submit([this]() { RT_EndPass(); });
+    }
+
+    std::vector<GpuProfiler::PassTiming> OpenGLGpuProfiler::GetPassTimings() const
+    {
+        std::lock_guard<std::mutex> lock(m_ResultMutex);
+        return m_Results;
+    }
+
+    float OpenGLGpuProfiler::GetFrameTime() const
+    {
+        std::lock_guard<std::mutex> lock(m_ResultMutex);
+        return m_FrameTime;
+    }
+
+    void OpenGLGpuProfiler::RT_BeginFrame()
+    {
+        FrameQueries& frame = m_Frames[m_FrameIndex % s_FrameCount];
+
+        // Still not finished after a full trip around the ring: give up on it rather than wait
+        if (frame.Pending && !RT_TryResolve(frame))
+            HZ_CORE_WARN("GpuProfiler: timings of a frame were not ready after {0} frames, dropped", s_FrameCount);
+
+        frame.Pending = false;
+        frame.PassCount = 0;
+        frame.QueriesUsed = 2;
+        m_OpenPasses.clear();
+        m_InFrame = true;
+
+        glQueryCounter(frame.Queries[0], GL_TIMESTAMP);
+
+        GLint64 gpuNow = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+        frame.GpuSyncTime = gpuNow;
+        frame.CpuSyncTime = Instrumentor::Now();
+    }
+
+    void OpenGLGpuProfiler::RT_EndFrame()
+    {
+        if (!m_InFrame)
+            return;
+
+        HZ_CORE_ASSERT(m_OpenPasses.empty(), "GpuProfiler: BeginPass without EndPass!");
+        while (!m_OpenPasses.empty())
+            RT_EndPass();
+
+        FrameQueries& frame = m_Frames[m_FrameIndex % s_FrameCount];
+        glQueryCounter(frame.Queries[1], GL_TIMESTAMP);
+        frame.Pending = true;
+        m_InFrame = false;
+        m_FrameIndex++;
+
+        // Collect every older frame the GPU is done with; frames finish in order, so stop
+        // at the first one that is not
+        for (uint32_t age = s_FrameCount - 1; age > 0; age--)
+        {
+            FrameQueries& older = m_Frames[(m_FrameIndex + s_FrameCount - 1 - age) % s_FrameCount];
+            if (older.Pending && !RT_TryResolve(older))
+                break;
+        }
+    }
+
+    void OpenGLGpuProfiler::RT_BeginPass(const char* name)
+    {
+        if (!m_InFrame)
+            return;
+
+        FrameQueries& frame = m_Frames[m_FrameIndex % s_FrameCount];
+        if (frame.PassCount == s_MaxPasses)
+        {
+            // Keep the nesting balanced; RT_EndPass skips the placeholder
+            m_OpenPasses.push_back(UINT32_MAX);
+            return;
+        }
+
+        PassRecord& pass = frame.Passes[frame.PassCount];
+        pass.Name = name;
+        pass.Depth = (uint32_t)m_OpenPasses.size();
+        pass.BeginQuery = frame.Queries[frame.QueriesUsed++];
+        pass.EndQuery = frame.Queries[frame.QueriesUsed++];
+        glQueryCounter(pass.BeginQuery, GL_TIMESTAMP);
+
+        m_OpenPasses.push_back(frame.PassCount++);
+    }
+
+    void OpenGLGpuProfiler::RT_EndPass()
+    {
+        if (!m_InFrame)
+            return;
+
+        HZ_CORE_ASSERT(!m_OpenPasses.empty(), "GpuProfiler: EndPass without BeginPass!");
+        if (m_OpenPasses.empty())
+            return;
+
+        uint32_t passIndex = m_OpenPasses.back();
+        m_OpenPasses.pop_back();
+        if (passIndex != UINT32_MAX)
+            glQueryCounter(m_Frames[m_FrameIndex % s_FrameCount].Passes[passIndex].EndQuery, GL_TIMESTAMP);
+    }
+
+    bool OpenGLGpuProfiler::RT_TryResolve(FrameQueries& frame)
+    {
+        // Timestamps complete in submission order: once the last one is there, all are
+        GLint available = 0;
+        glGetQueryObjectiv(frame.Queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            return false;
+
+        auto readTimestamp = [](uint32_t query)
+        {
+            GLuint64 time = 0;
+            glGetQueryObjectui64v(query, GL_QUERY_RESULT, &time);
+            return (int64_t)time;
+        };
+
+        int64_t frameBegin = readTimestamp(frame.Queries[0]);
+        int64_t frameEnd = readTimestamp(frame.Queries[1]);
+
+        bool tracing = Instrumentor::IsSessionActive();
+        if (tracing && !m_Track)
+            m_Track = Instrumentor::CreateTrack("GPU");
+        int64_t gpuToCpu = frame.CpuSyncTime - frame.GpuSyncTime;
+
+        std::lock_guard<std::mutex> lock(m_ResultMutex);
+
+        std::vector<PassTiming> results(frame.PassCount);
+        for (uint32_t i = 0; i < frame.PassCount; i++)
+        {
+            const PassRecord& pass = frame.Passes[i];
+            int64_t begin = readTimestamp(pass.BeginQuery);
+            int64_t end = readTimestamp(pass.EndQuery);
+
+            PassTiming& timing = results[i];
+            timing.Name = pass.Name;
+            timing.Depth = pass.Depth;
+            timing.LastMs = (float)(end - begin) / 1e6f;
+            timing.AverageMs = timing.LastMs;
+
+            for (const PassTiming& previous : m_Results)
+            {
+                if (previous.Name == pass.Name || std::strcmp(previous.Name, pass.Name) == 0)
+                {
+                    timing.AverageMs = previous.AverageMs + (timing.LastMs - previous.AverageMs) * s_AverageWeight;
+                    break;
+                }
+            }
+
+            if (tracing)
+                Instrumentor::Record(m_Track, pass.Name, begin + gpuToCpu, end + gpuToCpu);
+        }
+
+        if (tracing)
+            Instrumentor::Record(m_Track, "GPU Frame", frameBegin + gpuToCpu, frameEnd + gpuToCpu);
+
+        m_Results.swap(results);
+        m_FrameTime = (float)(frameEnd - frameBegin) / 1e6f;
+        frame.Pending = false;
+        return true;
+    }
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Hazel/Renderer/GpuProfiler.h"
+#include "Hazel/Debug/Instrumentor.h"
+
+#include <mutex>
+
+namespace Hazel {
+
+    class OpenGLGpuProfiler : public GpuProfiler
+    {
+    public:
+        OpenGLGpuProfiler();
+        virtual ~OpenGLGpuProfiler();
+
+        virtual void BeginFrame() override;
+        virtual void EndFrame() override;
+
+        virtual void BeginPass(const char* name) override;
+        virtual void EndPass() override;
+
+        virtual std::vector<PassTiming> GetPassTimings() const override;
+        virtual float GetFrameTime() const override;
+    private:
+        // Frames whose queries can be outstanding at once; must exceed the frames the
+        // render thread and the driver keep in flight
+        static const uint32_t s_FrameCount = 5;
+        static const uint32_t s_MaxPasses = 32;
+
+        struct PassRecord
+        {
+            const char* Name;
+            uint32_t Depth;
+            uint32_t BeginQuery;
+            uint32_t EndQuery;
+        };
+
+        struct FrameQueries
+        {
+            // [0]/[1] bracket the frame, the rest are handed out to passes
+            uint32_t Queries[2 + 2 * s_MaxPasses] = {};
+            uint32_t QueriesUsed = 0;
+
+            PassRecord Passes[s_MaxPasses];
+            uint32_t PassCount = 0;
+
+            bool Pending = false;
+
+            // GPU and CPU clocks sampled together, to place the frame in the trace
+            int64_t GpuSyncTime = 0;
+            int64_t CpuSyncTime = 0;
+        };
+
+        void RT_BeginFrame();
+        void RT_EndFrame();
+        void RT_BeginPass(const char* name);
+        void RT_EndPass();
+
+        bool RT_TryResolve(FrameQueries& frame);
+    private:
+        // Render thread
+        FrameQueries m_Frames[s_FrameCount];
+        uint32_t m_FrameIndex = 0;
+        bool m_InFrame = false;
+        std::vector<uint32_t> m_OpenPasses;
+        ProfileTrack* m_Track = nullptr;
+
+        // Written by the render thread, read by the main thread
+        mutable std::mutex m_ResultMutex;
+        std::vector<PassTiming> m_Results;
+        float m_FrameTime = 0.0f;
+    };
+
+}
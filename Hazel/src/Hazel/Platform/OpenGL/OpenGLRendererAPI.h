@@ -2,6 +2,8 @@
 
 #include "Hazel/Renderer/RendererAPI.h"
 
+#include <deque>
+
 namespace Hazel {
 
     class OpenGLRendererAPI : public RendererAPI
@@ -11,7 +13,18 @@ namespace Hazel {
         virtual void SetClearColor(const glm::vec4& color) override;
         virtual void Clear() override;
 
+        virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+        virtual void SetDepthTest(bool enabled) override;
+        virtual void SetDepthWrite(bool enabled) override;
+        virtual void SetBlend(bool enabled) override;
+        virtual void SetCullFace(bool enabled) override;
+
         virtual void DrawIndexed(const std::shared_ptr<VertexArray>& vertexArray) override;
+        virtual void DrawIndexedInstanced(const std::shared_ptr<VertexArray>& vertexArray, uint32_t instanceCount) override;
+
+        virtual void WaitForFramesInFlight(uint32_t maxFramesInFlight) override;
+    private:
+        std::deque<void*> m_FrameFences; // GLsync, oldest first
     };
 
 
@@ -6,6 +6,9 @@
 
 #include <glad/glad.h>
 
+#include "Hazel/Core/FrameAllocator.h"
+#include "Hazel/Renderer/Renderer.h"
+
 #include <glm/gtc/type_ptr.hpp>
 
 namespace Hazel {
@@ -23,9 +26,14 @@ namespace Hazel {
 
     OpenGLShader::OpenGLShader(const std::string& filepath)
     {
+        HZ_PROFILE_FUNCTION();
+
         std::string source = ReadFile(filepath);
         auto shaderSources = PreProcess(source);
-        Compile(shaderSources);
+        Renderer::Submit([this, shaderSources]()
+        {
+            Compile(shaderSources);
+        });
 
         // Extract name from filepath
         auto lastSlash = filepath.find_last_of("/\\");
@@ -41,7 +49,10 @@ namespace Hazel {
         std::unordered_map<GLenum, std::string> sources;
         sources[GL_VERTEX_SHADER] = vertexSrc;
         sources[GL_FRAGMENT_SHADER] = fragmentSrc;
-        Compile(sources);
+        Renderer::Submit([this, sources]()
+        {
+            Compile(sources);
+        });
     }
 
     OpenGLShader::~OpenGLShader()
@@ -95,6 +106,8 @@ namespace Hazel {
 
     void OpenGLShader::Compile(const std::unordered_map<GLenum, std::string>& shaderSources)
     {
+        HZ_PROFILE_FUNCTION();
+
         GLuint program = glCreateProgram();
         HZ_CORE_ASSERT(shaderSources.size() <= 2, "We only support 2 shaders for now");
         std::array<GLenum, 2> glShaderIDs;
@@ -166,54 +179,89 @@ namespace Hazel {
 
     void OpenGLShader::Bind() const
     {
-        glUseProgram(m_RendererID);
+        Renderer::GetRecordingStats().ShaderBinds++;
+        Renderer::Submit([this]()
+        {
+            glUseProgram(m_RendererID);
+        });
     }
 
     void OpenGLShader::Unbind() const
     {
-        glUseProgram(0);
+        Renderer::Submit([]()
+        {
+            glUseProgram(0);
+        });
     }
 
-    void OpenGLShader::UploadUniformInt(const std::string& name, int value)
+    void OpenGLShader::UploadUniformInt(std::string_view name, int value)
     {
-        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-        glUniform1i(location, value);
+        Renderer::GetRecordingStats().UniformUploads++;
+        Renderer::Submit([this, name = FrameAllocator::CopyString(name), value]()
+        {
+            GLint location = glGetUniformLocation(m_RendererID, name);
+            glUniform1i(location, value);
+        });
     }
 
-    void OpenGLShader::UploadUniformFloat(const std::string& name, float value)
+    void OpenGLShader::UploadUniformFloat(std::string_view name, float value)
     {
-        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-        glUniform1f(location, value);
+        Renderer::GetRecordingStats().UniformUploads++;
+        Renderer::Submit([this, name = FrameAllocator::CopyString(name), value]()
+        {
+            GLint location = glGetUniformLocation(m_RendererID, name);
+            glUniform1f(location, value);
+        });
     }
 
-    void OpenGLShader::UploadUniformFloat2(const std::string& name, const glm::vec2& value)
+    void OpenGLShader::UploadUniformFloat2(std::string_view name, const glm::vec2& value)
     {
-        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-        glUniform2f(location, value.x, value.y);
+        Renderer::GetRecordingStats().UniformUploads++;
+        Renderer::Submit([this, name = FrameAllocator::CopyString(name), value]()
+        {
+            GLint location = glGetUniformLocation(m_RendererID, name);
+            glUniform2f(location, value.x, value.y);
+        });
     }
 
-    void OpenGLShader::UploadUniformFloat3(const std::string& name, const glm::vec3& value)
+    void OpenGLShader::UploadUniformFloat3(std::string_view name, const glm::vec3& value)
     {
-        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-        glUniform3f(location, value.x, value.y, value.z);
+        Renderer::GetRecordingStats().UniformUploads++;
+        Renderer::Submit([this, name = FrameAllocator::CopyString(name), value]()
+        {
+            GLint location = glGetUniformLocation(m_RendererID, name);
+            glUniform3f(location, value.x, value.y, value.z);
+        });
     }
 
-    void OpenGLShader::UploadUniformFloat4(const std::string& name, const glm::vec4& value)
+    void OpenGLShader::UploadUniformFloat4(std::string_view name, const glm::vec4& value)
     {
-        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-        glUniform4f(location, value.x, value.y, value.z, value.w);
+        Renderer::GetRecordingStats().UniformUploads++;
+        Renderer::Submit([this, name = FrameAllocator::CopyString(name), value]()
+        {
+            GLint location = glGetUniformLocation(m_RendererID, name);
+            glUniform4f(location, value.x, value.y, value.z, value.w);
+        });
     }
 
-    void OpenGLShader::UploadUniformMat3(const std::string& name, const glm::mat3& matrix)
+    void OpenGLShader::UploadUniformMat3(std::string_view name, const glm::mat3& matrix)
     {
-        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-        glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+        Renderer::GetRecordingStats().UniformUploads++;
+        Renderer::Submit([this, name = FrameAllocator::CopyString(name), matrix]()
+        {
+            GLint location = glGetUniformLocation(m_RendererID, name);
+            glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+        });
     }
 
-    void OpenGLShader::UploadUniformMat4(const std::string& name, const glm::mat4& matrix)
+    void OpenGLShader::UploadUniformMat4(std::string_view name, const glm::mat4& matrix)
     {
-        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+        Renderer::GetRecordingStats().UniformUploads++;
+        Renderer::Submit([this, name = FrameAllocator::CopyString(name), matrix]()
+        {
+            GLint location = glGetUniformLocation(m_RendererID, name);
+            glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+        });
     }
 
 }
\ No newline at end of file
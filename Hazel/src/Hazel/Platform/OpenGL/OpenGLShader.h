@@ -3,6 +3,8 @@
 #include "Hazel/Renderer/Shader.h"
 #include <glm/glm.hpp>
 
+#include <string_view>
+
 // TODO: REMOVE!
 typedef unsigned int GLenum;
 
@@ -21,15 +23,24 @@ namespace Hazel {
 
         virtual const std::string& GetName() const override { return m_Name; }
 
-        void UploadUniformInt(const std::string& name, int value);
+        virtual void SetInt(std::string_view name, int value) override { UploadUniformInt(name, value); }
+        virtual void SetFloat(std::string_view name, float value) override { UploadUniformFloat(name, value); }
+        virtual void SetFloat2(std::string_view name, const glm::vec2& value) override { UploadUniformFloat2(name, value); }
+        virtual void SetFloat3(std::string_view name, const glm::vec3& value) override { UploadUniformFloat3(name, value); }
+        virtual void SetFloat4(std::string_view name, const glm::vec4& value) override { UploadUniformFloat4(name, value); }
+        virtual void SetMat3(std::string_view name, const glm::mat3& matrix) override { UploadUniformMat3(name, matrix); }
+        virtual void SetMat4(std::string_view name, const glm::mat4& matrix) override { UploadUniformMat4(name, matrix); }
+
+        // Names are copied into frame memory, string literals cost no heap allocation
+        void UploadUniformInt(std::string_view name, int value);
 
-        void UploadUniformFloat(const std::string& name, float value);
-        void UploadUniformFloat2(const std::string& name, const glm::vec2& value);
-        void UploadUniformFloat3(const std::string& name, const glm::vec3& value);
-        void UploadUniformFloat4(const std::string& name, const glm::vec4& value);
+        void UploadUniformFloat(std::string_view name, float value);
+        void UploadUniformFloat2(std::string_view name, const glm::vec2& value);
+        void UploadUniformFloat3(std::string_view name, const glm::vec3& value);
+        void UploadUniformFloat4(std::string_view name, const glm::vec4& value);
 
-        void UploadUniformMat3(const std::string& name, const glm::mat3& matrix);
-        void UploadUniformMat4(const std::string& name, const glm::mat4& matrix);
+        void UploadUniformMat3(std::string_view name, const glm::mat3& matrix);
+        void UploadUniformMat4(std::string_view name, const glm::mat4& matrix);
 
     private:
         std::string ReadFile(const std::string& filepath);
@@ -37,7 +48,7 @@ namespace Hazel {
         void Compile(const std::unordered_map<GLenum, std::string>& shaderSources);
 
     private:
-        uint32_t m_RendererID;
+        uint32_t m_RendererID = 0;
         std::string m_Name;
     };
 
@@ -1,6 +1,9 @@
 #include "hzpch.h"
 #include "OpenGLTexture.h"
 
+#include "Hazel/Core/FrameAllocator.h"
+#include "Hazel/Renderer/Renderer.h"
+
 #include "stb_image/stb_image.h"
 
 #include <glad/glad.h>
@@ -13,22 +16,31 @@ namespace Hazel {
         m_InternalFormat = GL_RGBA8;
         m_DataFormat = GL_RGBA;
 
-        glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-        glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
+        Renderer::Submit([this]()
+        {
+            glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+            glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
 
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        });
     }
 
     OpenGLTexture2D::OpenGLTexture2D(const std::string& path)
         : m_Path(path)
     {
+        HZ_PROFILE_FUNCTION();
+
         int width, height, channels;
         stbi_set_flip_vertically_on_load(1);
-        stbi_uc* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+        stbi_uc* data = nullptr;
+        {
+            HZ_PROFILE_SCOPE("stbi_load - OpenGLTexture2D::OpenGLTexture2D(const std::string&)");
+            data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+        }
         HZ_CORE_ASSERT(data, "Failed to load image!");
         m_Width = width;
         m_Height = height;
@@ -50,20 +62,27 @@ namespace Hazel {
 
         HZ_CORE_ASSERT(internalFormat & dataFormat, "Format is not support");
 
-        // 创建纹理对象 (DSA: Direct State Access, 直接状态访问，不需要先 Bind)
-        glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-        // 为纹理分配不可变的显存空间 (Sized Internal Format 指定了显存中的格式)
-        glTextureStorage2D(m_RendererID, 1, internalFormat, m_Width, m_Height);
+        // Decoded on the calling thread; the pixels are freed once the render thread has uploaded them
+        Renderer::GetRecordingStats().BufferBytesUploaded += (uint64_t)width * height * channels;
+        Renderer::Submit([this, data]()
+        {
+            HZ_PROFILE_SCOPE("OpenGLTexture2D upload");
+
+            // 创建纹理对象 (DSA: Direct State Access, 直接状态访问，不需要先 Bind)
+            glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+            // 为纹理分配不可变的显存空间 (Sized Internal Format 指定了显存中的格式)
+            glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
 
-        // 设置缩小过滤器 (Minification Filter): 当纹理被缩小时如何采样 (线性插值)
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        // 设置放大过滤器 (Magnification Filter): 当纹理被放大时如何采样 (最近邻插值，像素风)
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            // 设置缩小过滤器 (Minification Filter): 当纹理被缩小时如何采样 (线性插值)
+            glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            // 设置放大过滤器 (Magnification Filter): 当纹理被放大时如何采样 (最近邻插值，像素风)
+            glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-        // 上传纹理数据到显存 (指定位置 offset 0,0 和大小 width,height)
-        glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, data);
+            // 上传纹理数据到显存 (指定位置 offset 0,0 和大小 width,height)
+            glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
 
-        stbi_image_free(data);
+            stbi_image_free(data);
+        });
     }
 
     OpenGLTexture2D::~OpenGLTexture2D()
@@ -75,11 +94,39 @@ namespace Hazel {
     {
         uint32_t bpp = m_DataFormat == GL_RGBA ? 4 : 3;
         HZ_CORE_ASSERT(size == m_Width * m_Height * bpp, "Data must be entire texture!");
-        glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+
+        std::vector<uint8_t> pixels((uint8_t*)data, (uint8_t*)data + size);
+        Renderer::GetRecordingStats().BufferBytesUploaded += size;
+        Renderer::Submit([this, pixels = std::move(pixels)]()
+        {
+            glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, pixels.data());
+        });
+    }
+
+    void OpenGLTexture2D::SetData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    {
+        HZ_CORE_ASSERT(x + width <= m_Width && y + height <= m_Height, "Region is outside the texture!");
+
+        // Small edits happen every frame: the copy goes to the frame arena, not the heap
+        uint32_t bpp = m_DataFormat == GL_RGBA ? 4 : 3;
+        uint32_t size = width * height * bpp;
+        void* pixels = FrameAllocator::Allocate(size);
+        memcpy(pixels, data, size);
+        Renderer::GetRecordingStats().BufferBytesUploaded += size;
+        Renderer::Submit([this, pixels, x, y, width, height]()
+        {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTextureSubImage2D(m_RendererID, 0, x, y, width, height, m_DataFormat, GL_UNSIGNED_BYTE, pixels);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        });
     }
 
     void OpenGLTexture2D::Bind(uint32_t slot) const
     {
-        glBindTextureUnit(slot, m_RendererID);
+        Renderer::GetRecordingStats().TextureBinds++;
+        Renderer::Submit([this, slot]()
+        {
+            glBindTextureUnit(slot, m_RendererID);
+        });
     }
 }
\ No newline at end of file
@@ -16,12 +16,13 @@ namespace Hazel {
         virtual uint32_t GetHeight() const override { return m_Height; }
 
         virtual void SetData(void* data, uint32_t size) override;
+        virtual void SetData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
 
         virtual void Bind(uint32_t slot = 0) const override;
     private:
         std::string m_Path;
         uint32_t m_Width, m_Height;
-        uint32_t m_RendererID;
+        uint32_t m_RendererID = 0;
         GLenum m_InternalFormat, m_DataFormat;
     };
 
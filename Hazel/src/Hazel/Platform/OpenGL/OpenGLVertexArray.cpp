@@ -1,6 +1,8 @@
 #include "hzpch.h"
 #include "OpenGLVertexArray.h"
 
+#include "Hazel/Renderer/Renderer.h"
+
 #include <glad/glad.h>
 
 namespace Hazel {
@@ -28,7 +30,10 @@ namespace Hazel {
 
     OpenGLVertexArray::OpenGLVertexArray()
     {
-        glCreateVertexArrays(1, &m_RendererID);
+        Renderer::Submit([this]()
+        {
+            glCreateVertexArrays(1, &m_RendererID);
+        });
     }
 
     OpenGLVertexArray::~OpenGLVertexArray()
@@ -38,42 +43,60 @@ namespace Hazel {
 
     void OpenGLVertexArray::Bind() const
     {
-        glBindVertexArray(m_RendererID);
+        Renderer::GetRecordingStats().VertexArrayBinds++;
+        Renderer::Submit([this]()
+        {
+            glBindVertexArray(m_RendererID);
+        });
     }
 
     void OpenGLVertexArray::Unbind() const
     {
-        glBindVertexArray(0);
+        Renderer::Submit([]()
+        {
+            glBindVertexArray(0);
+        });
     }
 
     void OpenGLVertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer>& vertexBuffer)
     {
         HZ_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout!");
 
-        glBindVertexArray(m_RendererID);
-        vertexBuffer->Bind();
+        BufferLayout layout = vertexBuffer->GetLayout();
+        uint32_t firstIndex = m_VertexAttribIndex;
+        m_VertexAttribIndex += (uint32_t)layout.GetElements().size();
 
-        uint32_t index = 0;
-        const auto& layout = vertexBuffer->GetLayout();
-        for (const auto& element : layout)
+        Renderer::Submit([this, vertexBuffer, layout, firstIndex]()
         {
-            glEnableVertexAttribArray(index);
-            glVertexAttribPointer(index,
-                element.GetComponentCount(),
-                ShaderDataTypeToOpenGLBaseType(element.Type),
-                element.Normalized ? GL_TRUE : GL_FALSE,
-                layout.GetStride(),
-                (const void*)element.Offset);
-            index++;
-        }
+            glBindVertexArray(m_RendererID);
+            vertexBuffer->Bind();
+
+            GLuint divisor = layout.GetStepRate() == VertexStepRate::PerInstance ? 1 : 0;
+            uint32_t index = firstIndex;
+            for (const auto& element : layout)
+            {
+                glEnableVertexAttribArray(index);
+                glVertexAttribPointer(index,
+                    element.GetComponentCount(),
+                    ShaderDataTypeToOpenGLBaseType(element.Type),
+                    element.Normalized ? GL_TRUE : GL_FALSE,
+                    layout.GetStride(),
+                    (const void*)(uintptr_t)element.Offset);
+                glVertexAttribDivisor(index, divisor);
+                index++;
+            }
+        });
 
         m_VertexBuffers.push_back(vertexBuffer);
     }
 
     void OpenGLVertexArray::SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer)
     {
-        glBindVertexArray(m_RendererID);
-        indexBuffer->Bind();
+        Renderer::Submit([this, indexBuffer]()
+        {
+            glBindVertexArray(m_RendererID);
+            indexBuffer->Bind();
+        });
 
         m_IndexBuffer = indexBuffer;
     }
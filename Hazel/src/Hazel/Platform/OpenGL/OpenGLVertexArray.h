@@ -19,7 +19,8 @@ namespace Hazel {
         virtual const std::vector<std::shared_ptr<VertexBuffer>>& GetVertexBuffers() const { return m_VertexBuffers; }
         virtual const std::shared_ptr<IndexBuffer>& GetIndexBuffer() const { return m_IndexBuffer; }
     private:
-        uint32_t m_RendererID;
+        uint32_t m_RendererID = 0;
+        uint32_t m_VertexAttribIndex = 0; // Next free attribute location, across all buffers
         std::vector<std::shared_ptr<VertexBuffer>> m_VertexBuffers;
         std::shared_ptr<IndexBuffer> m_IndexBuffer;
     };
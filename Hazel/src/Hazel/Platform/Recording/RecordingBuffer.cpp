@@ -0,0 +1,57 @@
+#include "hzpch.h"
+#include "RecordingBuffer.h"
+#include "RecordingRendererAPI.h"
+
+#include "Hazel/Renderer/Renderer.h"
+
+namespace Hazel {
+
+    /////////////////////////////////////////////////////////////////////////////
+    // VertexBuffer /////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////
+
+    // Data is kept (as the GL backend keeps it until the upload), so tests can inspect it
+
+    RecordingVertexBuffer::RecordingVertexBuffer(float* vertices, uint32_t size)
+        : m_RendererID(RecordingRendererAPI::AllocateID()), m_Data((uint8_t*)vertices, (uint8_t*)vertices + size)
+    {
+        Renderer::GetRecordingStats().BufferBytesUploaded += size;
+        Renderer::Submit([id = m_RendererID, size]()
+        {
+            RecordingRendererAPI::Record(RecordedCommandType::UploadData, id, size);
+        });
+    }
+
+    RecordingVertexBuffer::RecordingVertexBuffer(uint32_t size)
+        : m_RendererID(RecordingRendererAPI::AllocateID()), m_Data(size)
+    {
+    }
+
+    void RecordingVertexBuffer::SetData(const void* data, uint32_t size)
+    {
+        HZ_CORE_ASSERT(size <= m_Data.size(), "Data is larger than the vertex buffer!");
+
+        memcpy(m_Data.data(), data, size);
+        Renderer::GetRecordingStats().BufferBytesUploaded += size;
+        Renderer::Submit([id = m_RendererID, size]()
+        {
+            RecordingRendererAPI::Record(RecordedCommandType::UploadData, id, size);
+        });
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    // IndexBuffer //////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////
+
+    RecordingIndexBuffer::RecordingIndexBuffer(uint32_t* indices, uint32_t count)
+        : m_RendererID(RecordingRendererAPI::AllocateID()), m_Indices(indices, indices + count)
+    {
+        uint32_t size = count * sizeof(uint32_t);
+        Renderer::GetRecordingStats().BufferBytesUploaded += size;
+        Renderer::Submit([id = m_RendererID, size]()
+        {
+            RecordingRendererAPI::Record(RecordedCommandType::UploadData, id, size);
+        });
+    }
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Hazel/Renderer/Buffer.h"
+
+#include <vector>
+
+namespace Hazel {
+
+    class RecordingVertexBuffer : public VertexBuffer
+    {
+    public:
+        RecordingVertexBuffer(float* vertices, uint32_t size);
+        RecordingVertexBuffer(uint32_t size);
+
+        virtual void Bind() const override {}
+        virtual void Unbind() const override {}
+
+        virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+        virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+
+        virtual void SetData(const void* data, uint32_t size) override;
+
+        uint32_t GetRendererID() const { return m_RendererID; }
+        const std::vector<uint8_t>& GetData() const { return m_Data; }
+    private:
+        uint32_t m_RendererID;
+        BufferLayout m_Layout;
+        std::vector<uint8_t> m_Data;
+    };
+
+    class RecordingIndexBuffer : public IndexBuffer
+    {
+    public:
+        RecordingIndexBuffer(uint32_t* indices, uint32_t count);
+
+        virtual void Bind() const override {}
+        virtual void Unbind() const override {}
+
+        virtual uint32_t GetCount() const override { return (uint32_t)m_Indices.size(); }
+
+        uint32_t GetRendererID() const { return m_RendererID; }
+        const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
+    private:
+        uint32_t m_RendererID;
+        std::vector<uint32_t> m_Indices;
+    };
+
+}
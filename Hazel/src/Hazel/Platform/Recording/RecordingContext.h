@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Hazel/Renderer/GraphicsContext.h"
+
+namespace Hazel {
+
+    // RendererAPI::None has no context to own: the render thread runs without one
+    class RecordingContext : public GraphicsContext
+    {
+    public:
+        virtual void Init() override {}
+        virtual void SwapBuffers() override {}
+
+        virtual void MakeCurrent() override {}
+        virtual void ReleaseCurrent() override {}
+    };
+
+}
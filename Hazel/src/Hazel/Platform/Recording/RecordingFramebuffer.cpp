@@ -0,0 +1,218 @@
+#include "hzpch.h"
+#include "RecordingFramebuffer.h"
+#include "RecordingRendererAPI.h"
+
+#include "Hazel/Core/JobSystem.h"
+#include "Hazel/Renderer/Renderer.h"
+
+namespace Hazel {
+
+	// Matches the GL backend, so resize warnings and storage sizes are the same
+	static const uint32_t s_MaxFramebufferSize = 8192;
+
+	RecordingFramebuffer::RecordingFramebuffer(const FramebufferSpecification& spec)
+		: m_RendererID(RecordingRendererAPI::AllocateID()), m_Specification(spec)
+	{
+		for (auto attachment : m_Specification.Attachments.Attachments)
+		{
+			if (attachment.TextureFormat != FramebufferTextureFormat::DEPTH24STENCIL8)
+				m_ColorAttachments.push_back({ attachment.TextureFormat, RecordingRendererAPI::AllocateID() });
+		}
+
+		UpdateStorageSize();
+	}
+
+	RecordingFramebuffer::~RecordingFramebuffer()
+	{
+		// Readbacks still in flight are dropped without invoking their callbacks
+		if (!m_Readbacks.empty())
+			Renderer::RT_RemoveReadbackSource(this);
+	}
+
+	void RecordingFramebuffer::Bind()
+	{
+		Renderer::GetRecordingStats().FramebufferSwitches++;
+		uint32_t width = m_Specification.Width, height = m_Specification.Height;
+		Renderer::Submit([this, width, height]()
+		{
+			if (!m_Readbacks.empty())
+				RT_PollReadbacks();
+
+			RecordingRendererAPI::Record(RecordedCommandType::BindFramebuffer, m_RendererID);
+			RecordingRendererAPI::Record(RecordedCommandType::SetViewport, 0, 0, 0, width, height);
+		});
+	}
+
+	void RecordingFramebuffer::Unbind()
+	{
+		Renderer::GetRecordingStats().FramebufferSwitches++;
+		Renderer::Submit([]()
+		{
+			RecordingRendererAPI::Record(RecordedCommandType::BindFramebuffer, 0);
+		});
+	}
+
+	void RecordingFramebuffer::BindColorAttachment(uint32_t index, uint32_t slot)
+	{
+		HZ_CORE_ASSERT(index < m_ColorAttachments.size(), "");
+		Renderer::GetRecordingStats().TextureBinds++;
+		Renderer::Submit([id = m_ColorAttachments[index].RendererID, slot]()
+		{
+			RecordingRendererAPI::Record(RecordedCommandType::BindTexture, id, slot);
+		});
+	}
+
+	void RecordingFramebuffer::Resize(uint32_t width, uint32_t height)
+	{
+		if (width == 0 || height == 0 || width > s_MaxFramebufferSize || height > s_MaxFramebufferSize)
+		{
+			HZ_CORE_WARN("Attempted to rezize framebuffer to {0}, {1}", width, height);
+			return;
+		}
+		if (width == m_Specification.Width && height == m_Specification.Height)
+			return;
+
+		m_Specification.Width = width;
+		m_Specification.Height = height;
+
+		if (m_Specification.Overallocate
+			&& width <= m_StorageWidth && height <= m_StorageHeight
+			&& width * 2 > m_StorageWidth && height * 2 > m_StorageHeight)
+			return;
+
+		UpdateStorageSize();
+	}
+
+	void RecordingFramebuffer::UpdateStorageSize()
+	{
+		if (m_Specification.Overallocate)
+		{
+			m_StorageWidth = std::min(Framebuffer::GetStorageBucket(m_Specification.Width), s_MaxFramebufferSize);
+			m_StorageHeight = std::min(Framebuffer::GetStorageBucket(m_Specification.Height), s_MaxFramebufferSize);
+		}
+		else
+		{
+			m_StorageWidth = m_Specification.Width;
+			m_StorageHeight = m_Specification.Height;
+		}
+	}
+
+	int RecordingFramebuffer::ReadPixel(uint32_t attachmentIndex, int x, int y)
+	{
+		HZ_CORE_ASSERT(Renderer::IsRenderThread(), "ReadPixel would stall a frame behind the render thread, use ReadPixelsAsync");
+		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "");
+
+		const ColorAttachment& attachment = m_ColorAttachments[attachmentIndex];
+		return attachment.Format == FramebufferTextureFormat::RED_INTEGER ? attachment.ClearValue : 0;
+	}
+
+	void RecordingFramebuffer::ReadPixelsAsync(uint32_t attachmentIndex, const FramebufferRect& rect, const ReadPixelsCallback& callback)
+	{
+		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "");
+		HZ_CORE_ASSERT(m_Specification.Samples == 1, "Cannot read back a multisampled framebuffer");
+
+		Renderer::Submit([this, attachmentIndex, rect, callback]()
+		{
+			RT_QueueReadback({ attachmentIndex, rect, callback, nullptr });
+		});
+	}
+
+	void RecordingFramebuffer::ReadPixelsBufferAsync(uint32_t attachmentIndex, const FramebufferRect& rect, const ReadPixelsBufferCallback& callback)
+	{
+		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "");
+		HZ_CORE_ASSERT(m_Specification.Samples == 1, "Cannot read back a multisampled framebuffer");
+
+		Renderer::Submit([this, attachmentIndex, rect, callback]()
+		{
+			RT_QueueReadback({ attachmentIndex, rect, nullptr, callback });
+		});
+	}
+
+	void RecordingFramebuffer::RT_QueueReadback(PendingReadback&& readback)
+	{
+		RecordingRendererAPI::Record(RecordedCommandType::ReadPixels, m_RendererID, readback.AttachmentIndex);
+		if (m_Readbacks.empty())
+			Renderer::RT_AddReadbackSource(this);
+		m_Readbacks.push_back(std::move(readback));
+	}
+
+	void RecordingFramebuffer::PollReadbacks()
+	{
+		Renderer::Submit([this]()
+		{
+			RT_PollReadbacks();
+		});
+	}
+
+	void RecordingFramebuffer::RT_PollReadbacks()
+	{
+		// Callbacks may queue readbacks of their own; those wait for the next poll
+		std::vector<PendingReadback> readbacks;
+		readbacks.swap(m_Readbacks);
+		Renderer::RT_RemoveReadbackSource(this);
+
+		bool multiThreaded = Renderer::GetConfig().Threading == RenderThreadingPolicy::MultiThreaded;
+		for (PendingReadback& readback : readbacks)
+		{
+			if (!readback.Callback && !readback.BufferCallback)
+				continue;
+
+			// Both formats are 4 bytes per pixel
+			const ColorAttachment& attachment = m_ColorAttachments[readback.AttachmentIndex];
+			int value = attachment.Format == FramebufferTextureFormat::RED_INTEGER ? attachment.ClearValue : 0;
+			size_t count = (size_t)readback.Rect.Width * readback.Rect.Height;
+			std::vector<uint8_t> pixels(count * 4);
+			if (value)
+			{
+				for (size_t i = 0; i < count; i++)
+					memcpy(&pixels[i * 4], &value, 4);
+			}
+
+			if (readback.BufferCallback && multiThreaded)
+			{
+				JobSystem::ScheduleOnMainThread([callback = readback.BufferCallback, rect = readback.Rect, pixels = std::move(pixels)]() mutable
+				{
+					callback(std::move(pixels), rect);
+				});
+			}
+			else if (readback.BufferCallback)
+			{
+				readback.BufferCallback(std::move(pixels), readback.Rect);
+			}
+			else if (multiThreaded)
+			{
+				JobSystem::ScheduleOnMainThread([callback = readback.Callback, rect = readback.Rect, pixels = std::move(pixels)]()
+				{
+					callback(pixels.data(), rect);
+				});
+			}
+			else
+			{
+				readback.Callback(pixels.data(), readback.Rect);
+			}
+		}
+	}
+
+	void RecordingFramebuffer::ClearAttachment(uint32_t attachmentIndex, int value)
+	{
+		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "");
+
+		Renderer::Submit([this, attachmentIndex, value]()
+		{
+			m_ColorAttachments[attachmentIndex].ClearValue = value;
+			RecordingRendererAPI::Record(RecordedCommandType::ClearAttachment, m_RendererID, attachmentIndex, (uint32_t)value);
+		});
+	}
+
+	void RecordingFramebuffer::CopyColorAttachment(uint32_t attachmentIndex, const Ref<Framebuffer>& destination, const FramebufferRect& rect)
+	{
+		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "");
+
+		Renderer::Submit([this, attachmentIndex, destination]()
+		{
+			RecordingRendererAPI::Record(RecordedCommandType::CopyAttachment, m_RendererID, attachmentIndex,
+				static_cast<RecordingFramebuffer&>(*destination).GetRendererID());
+		});
+	}
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Hazel/Renderer/Framebuffer.h"
+
+namespace Hazel {
+
+	class RecordingFramebuffer : public Framebuffer
+	{
+	public:
+		RecordingFramebuffer(const FramebufferSpecification& spec);
+		virtual ~RecordingFramebuffer();
+
+		virtual void Bind() override;
+		virtual void Unbind() override;
+		virtual void BindColorAttachment(uint32_t index, uint32_t slot) override;
+
+		virtual void Resize(uint32_t width, uint32_t height) override;
+
+		// Nothing is rendered: integer attachments read back their last ClearAttachment value,
+		// RGBA8 attachments zero
+		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
+		virtual void ReadPixelsAsync(uint32_t attachmentIndex, const FramebufferRect& rect, const ReadPixelsCallback& callback) override;
+		virtual void ReadPixelsBufferAsync(uint32_t attachmentIndex, const FramebufferRect& rect, const ReadPixelsBufferCallback& callback) override;
+		virtual void PollReadbacks() override;
+
+		virtual void ClearAttachment(uint32_t attachmentIndex, int value) override;
+		virtual void CopyColorAttachment(uint32_t attachmentIndex, const Ref<Framebuffer>& destination, const FramebufferRect& rect) override;
+
+		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override { HZ_CORE_ASSERT(index < m_ColorAttachments.size(), ""); return m_ColorAttachments[index].RendererID; }
+
+		virtual const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
+
+		virtual uint32_t GetStorageWidth() const override { return m_StorageWidth; }
+		virtual uint32_t GetStorageHeight() const override { return m_StorageHeight; }
+
+		uint32_t GetRendererID() const { return m_RendererID; }
+	private:
+		void UpdateStorageSize();
+
+		void RT_PollReadbacks();
+	private:
+		struct ColorAttachment
+		{
+			FramebufferTextureFormat Format;
+			uint32_t RendererID;
+			int ClearValue = 0; // Executing side
+		};
+
+		struct PendingReadback
+		{
+			uint32_t AttachmentIndex;
+			FramebufferRect Rect;
+			ReadPixelsCallback Callback;             // One of these
+			ReadPixelsBufferCallback BufferCallback;
+		};
+
+		void RT_QueueReadback(PendingReadback&& readback);
+	private:
+		uint32_t m_RendererID;
+		FramebufferSpecification m_Specification;
+		uint32_t m_StorageWidth = 0, m_StorageHeight = 0;
+
+		std::vector<ColorAttachment> m_ColorAttachments;
+
+		// Executing side; completed on the next poll, as if the GPU were always done
+		std::vector<PendingReadback> m_Readbacks;
+	};
+
+}
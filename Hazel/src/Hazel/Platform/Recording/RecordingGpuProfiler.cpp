@@ -0,0 +1,28 @@
+#include "hzpch.h"
+#include "RecordingGpuProfiler.h"
+#include "RecordingRendererAPI.h"
+
+#include "Hazel/Renderer/Renderer.h"
+
+namespace Hazel {
+
+    void RecordingGpuProfiler::BeginPass(const char* name)
+    {
+        Renderer::Submit([name]()
+        {
+            RecordedCommand command;
+            command.Type = RecordedCommandType::BeginPass;
+            command.Name = name;
+            RecordingRendererAPI::Record(command);
+        });
+    }
+
+    void RecordingGpuProfiler::EndPass()
+    {
+        Renderer::Submit([]()
+        {
+            RecordingRendererAPI::Record(RecordedCommandType::EndPass);
+        });
+    }
+
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Hazel/Renderer/GpuProfiler.h"
+
+namespace Hazel {
+
+    // There is no GPU to time: passes only show up in the command stream, and timings stay empty
+    class RecordingGpuProfiler : public GpuProfiler
+    {
+    public:
+        virtual void BeginFrame() override {}
+        virtual void EndFrame() override {}
+
+        virtual void BeginPass(const char* name) override;
+        virtual void EndPass() override;
+
+        virtual std::vector<PassTiming> GetPassTimings() const override { return {}; }
+        virtual float GetFrameTime() const override { return 0.0f; }
+    };
+
+}
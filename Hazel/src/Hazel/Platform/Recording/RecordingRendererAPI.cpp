@@ -0,0 +1,113 @@
+#include "hzpch.h"
+#include "RecordingRendererAPI.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace Hazel {
+
+    struct RecordingData
+    {
+        // Executing side only
+        std::vector<RecordedCommand> Commands;
+
+        std::mutex LastFrameMutex;
+        std::vector<RecordedCommand> LastFrameCommands;
+
+        std::atomic<uint32_t> NextID{ 1 };
+    };
+
+    static RecordingData s_Data;
+
+    void RecordingRendererAPI::Init()
+    {
+        Record(RecordedCommandType::Init);
+    }
+
+    void RecordingRendererAPI::SetClearColor(const glm::vec4& color)
+    {
+        RecordedCommand command;
+        command.Type = RecordedCommandType::SetClearColor;
+        command.Color = color;
+        Record(command);
+    }
+
+    void RecordingRendererAPI::Clear()
+    {
+        Record(RecordedCommandType::Clear);
+    }
+
+    void RecordingRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    {
+        Record(RecordedCommandType::SetViewport, 0, x, y, width, height);
+    }
+
+    void RecordingRendererAPI::SetDepthTest(bool enabled)
+    {
+        Record(RecordedCommandType::SetDepthTest, 0, enabled);
+    }
+
+    void RecordingRendererAPI::SetDepthWrite(bool enabled)
+    {
+        Record(RecordedCommandType::SetDepthWrite, 0, enabled);
+    }
+
+    void RecordingRendererAPI::SetBlend(bool enabled)
+    {
+        Record(RecordedCommandType::SetBlend, 0, enabled);
+    }
+
+    void RecordingRendererAPI::SetCullFace(bool enabled)
+    {
+        Record(RecordedCommandType::SetCullFace, 0, enabled);
+    }
+
+    void RecordingRendererAPI::DrawIndexed(const std::shared_ptr<VertexArray>& vertexArray)
+    {
+        Record(RecordedCommandType::DrawIndexed, 0, vertexArray->GetIndexBuffer()->GetCount());
+    }
+
+    void RecordingRendererAPI::DrawIndexedInstanced(const std::shared_ptr<VertexArray>& vertexArray, uint32_t instanceCount)
+    {
+        Record(RecordedCommandType::DrawIndexedInstanced, 0, vertexArray->GetIndexBuffer()->GetCount(), instanceCount);
+    }
+
+    void RecordingRendererAPI::WaitForFramesInFlight(uint32_t maxFramesInFlight)
+    {
+        Record(RecordedCommandType::WaitForFramesInFlight, 0, maxFramesInFlight);
+
+        // Swap rather than copy: both vectors keep their capacity, so steady-state frames
+        // record without allocating
+        std::lock_guard<std::mutex> lock(s_Data.LastFrameMutex);
+        s_Data.LastFrameCommands.swap(s_Data.Commands);
+        s_Data.Commands.clear();
+    }
+
+    std::vector<RecordedCommand> RecordingRendererAPI::GetLastFrameCommands()
+    {
+        std::lock_guard<std::mutex> lock(s_Data.LastFrameMutex);
+        return s_Data.LastFrameCommands;
+    }
+
+    void RecordingRendererAPI::Record(const RecordedCommand& command)
+    {
+        s_Data.Commands.push_back(command);
+    }
+
+    void RecordingRendererAPI::Record(RecordedCommandType type, uint32_t resource, uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3)
+    {
+        RecordedCommand& command = s_Data.Commands.emplace_back();
+        command.Type = type;
+        command.Resource = resource;
+        command.Args[0] = arg0;
+        command.Args[1] = arg1;
+        command.Args[2] = arg2;
+        command.Args[3] = arg3;
+    }
+
+    uint32_t RecordingRendererAPI::AllocateID()
+    {
+        return s_Data.NextID.fetch_add(1, std::memory_order_relaxed);
+    }
+
+}
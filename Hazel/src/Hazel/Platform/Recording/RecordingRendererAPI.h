@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Hazel/Renderer/RendererAPI.h"
+
+#include <vector>
+
+namespace Hazel {
+
+    enum class RecordedCommandType : uint8_t
+    {
+        // RendererAPI
+        Init, SetViewport, SetClearColor, Clear, SetDepthTest, SetDepthWrite, SetBlend, SetCullFace,
+        DrawIndexed, DrawIndexedInstanced, WaitForFramesInFlight,
+
+        // Resource state
+        BindShader, SetUniform, BindVertexArray, BindTexture, BindFramebuffer,
+        UploadData, ClearAttachment, CopyAttachment, ReadPixels,
+
+        // GpuProfiler
+        BeginPass, EndPass
+    };
+
+    struct RecordedCommand
+    {
+        RecordedCommandType Type;
+
+        // Object the command applies to: shader, vertex array, texture, framebuffer, buffer.
+        // 0 is the default framebuffer (and unbinding).
+        uint32_t Resource = 0;
+
+        // SetViewport: x, y, width, height. Set*: enabled. DrawIndexed: index count.
+        // DrawIndexedInstanced: index count, instance count.
+        // SetUniform: location, ShaderDataType. BindTexture: slot. UploadData: bytes.
+        // ClearAttachment/ReadPixels: attachment index. CopyAttachment: attachment index, destination.
+        // WaitForFramesInFlight: frames.
+        uint32_t Args[4] = {};
+
+        glm::vec4 Color = glm::vec4(0.0f); // SetClearColor
+        const char* Name = nullptr;        // BeginPass
+    };
+
+    // Backend of RendererAPI::API::None. Nothing reaches a GPU: resources are plain CPU
+    // objects and every render command and resource state change executed is appended to a
+    // command stream, so CPU-side renderer cost can be measured without a driver and the
+    // submitted work checked without GL.
+    class RecordingRendererAPI : public RendererAPI
+    {
+    public:
+        virtual void Init() override;
+        virtual void SetClearColor(const glm::vec4& color) override;
+        virtual void Clear() override;
+
+        virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+        virtual void SetDepthTest(bool enabled) override;
+        virtual void SetDepthWrite(bool enabled) override;
+        virtual void SetBlend(bool enabled) override;
+        virtual void SetCullFace(bool enabled) override;
+
+        virtual void DrawIndexed(const std::shared_ptr<VertexArray>& vertexArray) override;
+        virtual void DrawIndexedInstanced(const std::shared_ptr<VertexArray>& vertexArray, uint32_t instanceCount) override;
+
+        // Ends the frame in the stream
+        virtual void WaitForFramesInFlight(uint32_t maxFramesInFlight) override;
+
+        // Copy of the last frame fully executed: after Renderer::WaitAndRender() the frame just
+        // ended, or with a render thread the one before it
+        static std::vector<RecordedCommand> GetLastFrameCommands();
+
+        // Executing side (render thread if there is one), from inside Renderer::Submit
+        static void Record(const RecordedCommand& command);
+        static void Record(RecordedCommandType type, uint32_t resource = 0,
+                           uint32_t arg0 = 0, uint32_t arg1 = 0, uint32_t arg2 = 0, uint32_t arg3 = 0);
+
+        // Stands in for GL object names; never 0
+        static uint32_t AllocateID();
+    };
+
+}
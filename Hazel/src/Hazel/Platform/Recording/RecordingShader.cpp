@@ -0,0 +1,126 @@
+#include "hzpch.h"
+#include "RecordingShader.h"
+#include "RecordingRendererAPI.h"
+
+#include "Hazel/Core/FrameAllocator.h"
+#include "Hazel/Renderer/Renderer.h"
+
+namespace Hazel {
+
+    RecordingShader::RecordingShader(const std::string& filepath)
+        : m_RendererID(RecordingRendererAPI::AllocateID())
+    {
+        // Same naming as OpenGLShader, so ShaderLibrary lookups behave alike
+        auto lastSlash = filepath.find_last_of("/\\");
+        lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
+        auto lastDot = filepath.rfind('.');
+        auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
+        m_Name = filepath.substr(lastSlash, count);
+    }
+
+    RecordingShader::RecordingShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
+        : m_RendererID(RecordingRendererAPI::AllocateID()), m_Name(name)
+    {
+    }
+
+    void RecordingShader::Bind() const
+    {
+        Renderer::GetRecordingStats().ShaderBinds++;
+        Renderer::Submit([id = m_RendererID]()
+        {
+            RecordingRendererAPI::Record(RecordedCommandType::BindShader, id);
+        });
+    }
+
+    void RecordingShader::Unbind() const
+    {
+        Renderer::Submit([]()
+        {
+            RecordingRendererAPI::Record(RecordedCommandType::BindShader, 0);
+        });
+    }
+
+    void RecordingShader::SetInt(std::string_view name, int value)
+    {
+        UniformValue uniform;
+        uniform.Type = ShaderDataType::Int;
+        uniform.Int = value;
+        Upload(name, uniform);
+    }
+
+    void RecordingShader::SetFloat(std::string_view name, float value)
+    {
+        UniformValue uniform;
+        uniform.Type = ShaderDataType::Float;
+        uniform.Float[0].x = value;
+        Upload(name, uniform);
+    }
+
+    void RecordingShader::SetFloat2(std::string_view name, const glm::vec2& value)
+    {
+        UniformValue uniform;
+        uniform.Type = ShaderDataType::Float2;
+        uniform.Float[0] = glm::vec4(value, 0.0f, 0.0f);
+        Upload(name, uniform);
+    }
+
+    void RecordingShader::SetFloat3(std::string_view name, const glm::vec3& value)
+    {
+        UniformValue uniform;
+        uniform.Type = ShaderDataType::Float3;
+        uniform.Float[0] = glm::vec4(value, 0.0f);
+        Upload(name, uniform);
+    }
+
+    void RecordingShader::SetFloat4(std::string_view name, const glm::vec4& value)
+    {
+        UniformValue uniform;
+        uniform.Type = ShaderDataType::Float4;
+        uniform.Float[0] = value;
+        Upload(name, uniform);
+    }
+
+    void RecordingShader::SetMat3(std::string_view name, const glm::mat3& matrix)
+    {
+        UniformValue uniform;
+        uniform.Type = ShaderDataType::Mat3;
+        uniform.Float = glm::mat4(matrix);
+        Upload(name, uniform);
+    }
+
+    void RecordingShader::SetMat4(std::string_view name, const glm::mat4& matrix)
+    {
+        UniformValue uniform;
+        uniform.Type = ShaderDataType::Mat4;
+        uniform.Float = matrix;
+        Upload(name, uniform);
+    }
+
+    const RecordingShader::UniformValue* RecordingShader::GetUniform(std::string_view name) const
+    {
+        for (const Uniform& uniform : m_Uniforms)
+        {
+            if (uniform.Name == name)
+                return &uniform.Value;
+        }
+        return nullptr;
+    }
+
+    void RecordingShader::Upload(std::string_view name, const UniformValue& value)
+    {
+        Renderer::GetRecordingStats().UniformUploads++;
+        Renderer::Submit([this, name = FrameAllocator::CopyString(name), value]()
+        {
+            // Stands in for glGetUniformLocation
+            uint32_t location = 0;
+            while (location < m_Uniforms.size() && m_Uniforms[location].Name != name)
+                location++;
+            if (location == m_Uniforms.size())
+                m_Uniforms.push_back({ name, UniformValue() });
+
+            m_Uniforms[location].Value = value;
+            RecordingRendererAPI::Record(RecordedCommandType::SetUniform, m_RendererID, location, (uint32_t)value.Type);
+        });
+    }
+
+}
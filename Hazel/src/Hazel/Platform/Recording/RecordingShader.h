@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Hazel/Renderer/Shader.h"
+#include "Hazel/Renderer/Buffer.h"
+
+#include <vector>
+
+namespace Hazel {
+
+    class RecordingShader : public Shader
+    {
+    public:
+        struct UniformValue
+        {
+            ShaderDataType Type = ShaderDataType::None;
+            int Int = 0;
+            glm::mat4 Float = glm::mat4(0.0f); // Vectors in the first column, Mat3 top-left
+        };
+
+        struct Uniform
+        {
+            std::string Name;
+            UniformValue Value;
+        };
+    public:
+        // Sources are not read or compiled
+        RecordingShader(const std::string& filepath);
+        RecordingShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+
+        virtual void Bind() const override;
+        virtual void Unbind() const override;
+
+        virtual const std::string& GetName() const override { return m_Name; }
+
+        virtual void SetInt(std::string_view name, int value) override;
+        virtual void SetFloat(std::string_view name, float value) override;
+        virtual void SetFloat2(std::string_view name, const glm::vec2& value) override;
+        virtual void SetFloat3(std::string_view name, const glm::vec3& value) override;
+        virtual void SetFloat4(std::string_view name, const glm::vec4& value) override;
+        virtual void SetMat3(std::string_view name, const glm::mat3& matrix) override;
+        virtual void SetMat4(std::string_view name, const glm::mat4& matrix) override;
+
+        uint32_t GetRendererID() const { return m_RendererID; }
+
+        // Values as of the last command executed; the index is the location in SetUniform commands
+        const std::vector<Uniform>& GetUniforms() const { return m_Uniforms; }
+        const UniformValue* GetUniform(std::string_view name) const;
+    private:
+        void Upload(std::string_view name, const UniformValue& value);
+    private:
+        uint32_t m_RendererID;
+        std::string m_Name;
+
+        // Executing side. A handful per shader: a linear search beats hashing the name.
+        std::vector<Uniform> m_Uniforms;
+    };
+
+}
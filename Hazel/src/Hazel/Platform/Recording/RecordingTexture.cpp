@@ -0,0 +1,74 @@
+#include "hzpch.h"
+#include "RecordingTexture.h"
+#include "RecordingRendererAPI.h"
+
+#include "Hazel/Renderer/Renderer.h"
+
+#include "stb_image/stb_image.h"
+
+namespace Hazel {
+
+    RecordingTexture2D::RecordingTexture2D(uint32_t width, uint32_t height)
+        : m_RendererID(RecordingRendererAPI::AllocateID()), m_Width(width), m_Height(height)
+    {
+    }
+
+    RecordingTexture2D::RecordingTexture2D(const std::string& path)
+        : m_RendererID(RecordingRendererAPI::AllocateID()), m_Path(path)
+    {
+        int width, height, channels;
+        int success = stbi_info(path.c_str(), &width, &height, &channels);
+        HZ_CORE_ASSERT(success, "Failed to load image!");
+        HZ_CORE_ASSERT(channels == 3 || channels == 4, "Format is not support");
+        m_Width = width;
+        m_Height = height;
+        m_Channels = channels;
+
+        // Counted like the upload the GL backend would do
+        uint32_t size = m_Width * m_Height * m_Channels;
+        Renderer::GetRecordingStats().BufferBytesUploaded += size;
+        Renderer::Submit([id = m_RendererID, size]()
+        {
+            RecordingRendererAPI::Record(RecordedCommandType::UploadData, id, size);
+        });
+    }
+
+    void RecordingTexture2D::SetData(void* data, uint32_t size)
+    {
+        HZ_CORE_ASSERT(size == m_Width * m_Height * m_Channels, "Data must be entire texture!");
+
+        m_Data.assign((uint8_t*)data, (uint8_t*)data + size);
+        Renderer::GetRecordingStats().BufferBytesUploaded += size;
+        Renderer::Submit([id = m_RendererID, size]()
+        {
+            RecordingRendererAPI::Record(RecordedCommandType::UploadData, id, size);
+        });
+    }
+
+    void RecordingTexture2D::SetData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    {
+        HZ_CORE_ASSERT(x + width <= m_Width && y + height <= m_Height, "Region is outside the texture!");
+
+        uint32_t rowSize = width * m_Channels;
+        m_Data.resize((size_t)m_Width * m_Height * m_Channels);
+        for (uint32_t row = 0; row < height; row++)
+            memcpy(&m_Data[((size_t)(y + row) * m_Width + x) * m_Channels], (const uint8_t*)data + (size_t)row * rowSize, rowSize);
+
+        uint32_t size = rowSize * height;
+        Renderer::GetRecordingStats().BufferBytesUploaded += size;
+        Renderer::Submit([id = m_RendererID, size]()
+        {
+            RecordingRendererAPI::Record(RecordedCommandType::UploadData, id, size);
+        });
+    }
+
+    void RecordingTexture2D::Bind(uint32_t slot) const
+    {
+        Renderer::GetRecordingStats().TextureBinds++;
+        Renderer::Submit([id = m_RendererID, slot]()
+        {
+            RecordingRendererAPI::Record(RecordedCommandType::BindTexture, id, slot);
+        });
+    }
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Hazel/Renderer/Texture.h"
+
+#include <vector>
+
+namespace Hazel {
+
+    class RecordingTexture2D : public Texture2D
+    {
+    public:
+        RecordingTexture2D(uint32_t width, uint32_t height);
+        // Only the image header is read
+        RecordingTexture2D(const std::string& path);
+
+        virtual uint32_t GetWidth() const override { return m_Width; }
+        virtual uint32_t GetHeight() const override { return m_Height; }
+
+        virtual void SetData(void* data, uint32_t size) override;
+        virtual void SetData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+
+        virtual void Bind(uint32_t slot = 0) const override;
+
+        uint32_t GetRendererID() const { return m_RendererID; }
+        // Last SetData, empty for textures loaded from a file
+        const std::vector<uint8_t>& GetData() const { return m_Data; }
+    private:
+        uint32_t m_RendererID;
+        std::string m_Path;
+        uint32_t m_Width = 0, m_Height = 0;
+        uint32_t m_Channels = 4;
+        std::vector<uint8_t> m_Data;
+    };
+
+}
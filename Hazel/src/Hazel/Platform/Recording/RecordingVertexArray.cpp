@@ -0,0 +1,42 @@
+#include "hzpch.h"
+#include "RecordingVertexArray.h"
+#include "RecordingRendererAPI.h"
+
+#include "Hazel/Renderer/Renderer.h"
+
+namespace Hazel {
+
+    RecordingVertexArray::RecordingVertexArray()
+        : m_RendererID(RecordingRendererAPI::AllocateID())
+    {
+    }
+
+    void RecordingVertexArray::Bind() const
+    {
+        Renderer::GetRecordingStats().VertexArrayBinds++;
+        Renderer::Submit([id = m_RendererID]()
+        {
+            RecordingRendererAPI::Record(RecordedCommandType::BindVertexArray, id);
+        });
+    }
+
+    void RecordingVertexArray::Unbind() const
+    {
+        Renderer::Submit([]()
+        {
+            RecordingRendererAPI::Record(RecordedCommandType::BindVertexArray, 0);
+        });
+    }
+
+    void RecordingVertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer>& vertexBuffer)
+    {
+        HZ_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout!");
+        m_VertexBuffers.push_back(vertexBuffer);
+    }
+
+    void RecordingVertexArray::SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer)
+    {
+        m_IndexBuffer = indexBuffer;
+    }
+
+}
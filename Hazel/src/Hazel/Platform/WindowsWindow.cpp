@@ -10,15 +10,11 @@
 #include "Hazel/Core/Events/ApplicationEvent.h"
 
 #include "Hazel/Platform/OpenGL/OpenGLContext.h"
+#include "Hazel/Renderer/Renderer.h"
 
 namespace Hazel {
     static bool s_GLFWInitialized = false;
 
-    Window* Window::Create(const WindowProps& props) 
-    {
-        return new WindowsWindow(props);
-    }
-
     WindowsWindow::WindowsWindow(const WindowProps& props) 
     {
         Init(props);
@@ -70,6 +66,28 @@ namespace Hazel {
                 data.EventCallback(event);
             });
 
+        glfwSetWindowIconifyCallback(m_Window, [](GLFWwindow* window, int iconified)
+            {
+                WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+                WindowMinimizeEvent event(iconified == GLFW_TRUE);
+                data.EventCallback(event);
+            });
+
+        glfwSetWindowFocusCallback(m_Window, [](GLFWwindow* window, int focused)
+            {
+                WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+                if (focused)
+                {
+                    WindowFocusEvent event;
+                    data.EventCallback(event);
+                }
+                else
+                {
+                    WindowLostFocusEvent event;
+                    data.EventCallback(event);
+                }
+            });
+
         glfwSetKeyCallback(m_Window, [](GLFWwindow* window, int key, int scancode, int action, int mods)
             {
                 WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
@@ -146,16 +164,31 @@ namespace Hazel {
         m_Context->SwapBuffers();
     }
 
+    void WindowsWindow::PollEvents()
+    {
+        glfwPollEvents();
+    }
+
+    void WindowsWindow::WaitEvents(double timeout)
+    {
+        if (timeout > 0.0)
+            glfwWaitEventsTimeout(timeout);
+        else
+            glfwWaitEvents();
+    }
+
+    void WindowsWindow::PostEmptyEvent()
+    {
+        glfwPostEmptyEvent();
+    }
+
     void WindowsWindow::SetVSync(bool enabled) 
     {
-        if (enabled) 
+        // The swap interval belongs to whichever thread has the context current
+        Renderer::Submit([enabled]()
         {
-            glfwSwapInterval(1);
-        }
-        else 
-        {
-            glfwSwapInterval(0);
-        }
+            glfwSwapInterval(enabled ? 1 : 0);
+        });
         m_Data.VSync = enabled;
     }
 
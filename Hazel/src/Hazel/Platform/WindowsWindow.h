@@ -12,6 +12,9 @@ namespace Hazel {
         virtual ~WindowsWindow();
 
         void OnUpdate() override;
+        void PollEvents() override;
+        void WaitEvents(double timeout) override;
+        void PostEmptyEvent() override;
 
         inline unsigned int GetWidth() const override { return m_Data.Width; }
         inline unsigned int GetHeight() const override { return m_Data.Height; }
@@ -21,6 +24,7 @@ namespace Hazel {
         bool IsVSync() const override;
 
         inline virtual void* GetNativeWindow() const override { return m_Window; }
+        inline virtual GraphicsContext* GetContext() const override { return m_Context; }
     private:
         virtual void Init(const WindowProps& props);
         virtual void Shutdown();
@@ -4,27 +4,40 @@
 #include "Renderer.h"
 
 #include "Hazel/Platform/OpenGL/OpenGLBuffer.h"
+#include "Hazel/Platform/Recording/RecordingBuffer.h"
 
 namespace Hazel {
 
-    VertexBuffer* VertexBuffer::Create(float* vertices, uint32_t size)
+    Ref<VertexBuffer> VertexBuffer::Create(float* vertices, uint32_t size)
     {
         switch (Renderer::GetAPI())
         {
-            case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-            case RendererAPI::API::OpenGL:  return new OpenGLVertexBuffer(vertices, size);
+            case RendererAPI::API::None:    return Renderer::CreateResource<RecordingVertexBuffer>(vertices, size);
+            case RendererAPI::API::OpenGL:  return Renderer::CreateResource<OpenGLVertexBuffer>(vertices, size);
         }
 
         HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
         return nullptr;
     }
 
-    IndexBuffer* IndexBuffer::Create(uint32_t* indices, uint32_t size)
+    Ref<VertexBuffer> VertexBuffer::Create(uint32_t size)
     {
         switch (Renderer::GetAPI())
         {
-            case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-            case RendererAPI::API::OpenGL:  return new OpenGLIndexBuffer(indices, size);
+            case RendererAPI::API::None:    return Renderer::CreateResource<RecordingVertexBuffer>(size);
+            case RendererAPI::API::OpenGL:  return Renderer::CreateResource<OpenGLVertexBuffer>(size);
+        }
+
+        HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+
+    Ref<IndexBuffer> IndexBuffer::Create(uint32_t* indices, uint32_t size)
+    {
+        switch (Renderer::GetAPI())
+        {
+            case RendererAPI::API::None:    return Renderer::CreateResource<RecordingIndexBuffer>(indices, size);
+            case RendererAPI::API::OpenGL:  return Renderer::CreateResource<OpenGLIndexBuffer>(indices, size);
         }
 
         HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
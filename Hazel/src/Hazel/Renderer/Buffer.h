@@ -68,18 +68,26 @@ namespace Hazel
         }
     };
 
+    // How often the attributes of a vertex buffer advance: every vertex, or every instance
+    // of an instanced draw
+    enum class VertexStepRate
+    {
+        PerVertex = 0, PerInstance
+    };
+
     class BufferLayout
     {
     public:
         BufferLayout() {}
 
-        BufferLayout(const std::initializer_list<BufferElement>& elements)
-            : m_Elements(elements)
+        BufferLayout(const std::initializer_list<BufferElement>& elements, VertexStepRate stepRate = VertexStepRate::PerVertex)
+            : m_Elements(elements), m_StepRate(stepRate)
         {
             CalculateOffsetsAndStride();
         }
 
         inline uint32_t GetStride() const { return m_Stride; }
+        inline VertexStepRate GetStepRate() const { return m_StepRate; }
         inline const std::vector<BufferElement>& GetElements() const { return m_Elements; }
 
         std::vector<BufferElement>::iterator begin() { return m_Elements.begin(); }
@@ -101,6 +109,7 @@ namespace Hazel
     private:
         std::vector<BufferElement> m_Elements;
         uint32_t m_Stride = 0;
+        VertexStepRate m_StepRate = VertexStepRate::PerVertex;
     };
 
     class VertexBuffer
@@ -114,8 +123,12 @@ namespace Hazel
         virtual const BufferLayout& GetLayout() const = 0;
         virtual void SetLayout(const BufferLayout& layout) = 0;
 
+        // Replaces the first size bytes; the data is copied, so it may change right after
+        virtual void SetData(const void* data, uint32_t size) = 0;
 
-        static VertexBuffer* Create(float* vertices, uint32_t size);
+        static Ref<VertexBuffer> Create(float* vertices, uint32_t size);
+        // Uninitialized buffer of size bytes for data that changes every frame (SetData)
+        static Ref<VertexBuffer> Create(uint32_t size);
     };
 
     class IndexBuffer
@@ -128,7 +141,7 @@ namespace Hazel
 
         virtual uint32_t GetCount() const = 0;
 
-        static IndexBuffer* Create(uint32_t* indices, uint32_t size);
+        static Ref<IndexBuffer> Create(uint32_t* indices, uint32_t size);
     };
 
 }
\ No newline at end of file
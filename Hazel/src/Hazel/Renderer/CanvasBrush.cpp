@@ -0,0 +1,174 @@
+#include "hzpch.h"
+#include "Hazel/Renderer/CanvasBrush.h"
+
+#include "Hazel/Renderer/RenderCommand.h"
+
+namespace Hazel {
+
+    static const char* s_BrushVertexShader = R"(
+        #version 330 core
+        layout (location = 0) in vec2 aCorner;
+        layout (location = 1) in vec2 aStart; // Per instance from here on
+        layout (location = 2) in vec2 aEnd;
+        layout (location = 3) in float aRadius;
+        layout (location = 4) in float aDensity;
+        layout (location = 5) in vec3 aColor;
+        out vec2 Local;
+        flat out float Length;
+        flat out float Radius;
+        flat out float Density;
+        flat out vec3 Color;
+        uniform mat4 projection;
+        void main() {
+            vec2 delta = aEnd - aStart;
+            float len = length(delta);
+            vec2 dir = len > 0.0 ? delta / len : vec2(1.0, 0.0);
+            vec2 normal = vec2(-dir.y, dir.x);
+            // Bounds of the capsule: [-r, len + r] along the segment, [-r, r] across it
+            Local = vec2(mix(-aRadius, len + aRadius, aCorner.x + 0.5), aCorner.y * 2.0 * aRadius);
+            vec2 pos = aStart + dir * Local.x + normal * Local.y;
+            gl_Position = projection * vec4(pos, 0.0, 1.0);
+            Length = len;
+            Radius = aRadius;
+            Density = aDensity;
+            Color = aColor;
+        }
+    )";
+
+    // A dab falls off radially as a(d) = (1 - d/r)^2. Integrating it along the segment gives a
+    // coverage density D, and the pixel's alpha is 1 - exp(-D). Where two segments join their
+    // integrals add, and alpha-blending 1 - exp(-D) segment by segment equals evaluating the
+    // whole, so the result doesn't depend on where frames cut the stroke.
+    static const char* s_BrushFragmentShader = R"(
+        #version 330 core
+        out vec4 FragColor;
+        in vec2 Local; // From the segment start: x along it, y across it
+        flat in float Length;
+        flat in float Radius;
+        flat in float Density;
+        flat in vec3 Color;
+
+        // Antiderivative of a(sqrt(h^2 + u^2)) in u, h the distance to the segment's line
+        float Integral(float u, float h) {
+            float d = sqrt(h * h + u * u);
+            return u - (u * d + h * h * asinh(u / max(h, 1e-4))) / Radius + (h * h * u + u * u * u / 3.0) / (Radius * Radius);
+        }
+
+        void main() {
+            float alpha;
+            if (Density <= 0.0) {
+                // A single dab
+                float a = max(1.0 - length(Local) / Radius, 0.0);
+                alpha = a * a;
+            } else {
+                float h = abs(Local.y);
+                if (h >= Radius) discard;
+                // The chord of the brush disc over this pixel, clamped to the segment
+                float w = sqrt(Radius * Radius - h * h);
+                float u0 = max(-w, -Local.x);
+                float u1 = min(w, Length - Local.x);
+                if (u1 <= u0) discard;
+                alpha = 1.0 - exp(-Density * (Integral(u1, h) - Integral(u0, h)));
+            }
+            if (alpha < 0.01) discard;
+            FragColor = vec4(Color, alpha);
+        }
+    )";
+
+    CanvasBrush::CanvasBrush(TiledCanvas& canvas)
+        : m_Canvas(canvas)
+    {
+        // Unit quad the vertex shader stretches over each segment's capsule
+        float corners[] = {
+            -0.5f, -0.5f,
+             0.5f, -0.5f,
+             0.5f,  0.5f,
+            -0.5f,  0.5f
+        };
+        Ref<VertexBuffer> cornerVB = VertexBuffer::Create(corners, sizeof(corners));
+        cornerVB->SetLayout({
+            { ShaderDataType::Float2, "a_Corner" }
+        });
+
+        // One instance per segment, refilled for every draw
+        m_SegmentVB = VertexBuffer::Create(s_MaxSegmentsPerDraw * sizeof(TileSegmentData));
+        m_SegmentVB->SetLayout(BufferLayout({
+            { ShaderDataType::Float2, "a_Start" },
+            { ShaderDataType::Float2, "a_End" },
+            { ShaderDataType::Float, "a_Radius" },
+            { ShaderDataType::Float, "a_Density" },
+            { ShaderDataType::Float3, "a_Color" }
+        }, VertexStepRate::PerInstance));
+
+        uint32_t indices[] = { 0, 1, 2, 2, 3, 0 };
+        m_VertexArray = VertexArray::Create();
+        m_VertexArray->AddVertexBuffer(cornerVB);
+        m_VertexArray->AddVertexBuffer(m_SegmentVB);
+        m_VertexArray->SetIndexBuffer(IndexBuffer::Create(indices, 6));
+
+        m_Shader = Shader::Create("CanvasBrush", s_BrushVertexShader, s_BrushFragmentShader);
+
+        m_Segments.reserve(s_MaxSegmentsPerDraw);
+    }
+
+    void CanvasBrush::QueueSegment(const glm::dvec2& start, const glm::dvec2& end, float size, float spacing, const glm::vec3& color)
+    {
+        float density = start == end ? 0.0f : 1.0f / spacing;
+        m_Segments.push_back({ start, end, size * 0.5f, density, color });
+    }
+
+    void CanvasBrush::Flush()
+    {
+        if (m_Segments.empty())
+            return;
+
+        // Bin by the tiles each capsule's bounds cover (a segment across a tile edge goes in
+        // several bins); the stable sort keeps stroke order within a bin. Endpoints become
+        // relative to the tile corner, so floats stay exact however far out the tile is.
+        for (const CanvasSegment& segment : m_Segments)
+        {
+            glm::dvec2 extent(segment.Radius);
+            glm::dvec2 min = glm::min(segment.Start, segment.End) - extent;
+            glm::dvec2 max = glm::max(segment.Start, segment.End) + extent;
+            m_Canvas.ForEachTile(min, max, [&](int tileX, int tileY)
+            {
+                glm::dvec2 origin = m_Canvas.GetTileOrigin(tileX, tileY);
+                glm::dvec2 start = segment.Start - origin, end = segment.End - origin;
+                m_TileSegments.push_back({ TiledCanvas::TileKey(tileX, tileY),
+                    { { (float)start.x, (float)start.y }, { (float)end.x, (float)end.y }, segment.Radius, segment.Density, segment.Color } });
+            });
+        }
+        std::stable_sort(m_TileSegments.begin(), m_TileSegments.end(),
+            [](const TileSegment& a, const TileSegment& b) { return a.Tile < b.Tile; });
+
+        // Per tile: its target bound once, one instanced draw per instance buffer's worth
+        for (size_t next = 0; next < m_TileSegments.size();)
+        {
+            uint64_t tile = m_TileSegments[next].Tile;
+            m_DrawSegments.clear();
+            for (; next < m_TileSegments.size() && m_TileSegments[next].Tile == tile; next++)
+                m_DrawSegments.push_back(m_TileSegments[next].Segment);
+
+            // y down like the canvas coordinates; bringing an evicted tile back draws, so the
+            // brush state is bound after BeginPaint
+            glm::ivec2 coord = TiledCanvas::TileCoord(tile);
+            glm::mat4 projection = m_Canvas.BeginPaint(coord.x, coord.y);
+
+            m_Shader->Bind();
+            m_Shader->SetMat4("projection", projection);
+            m_VertexArray->Bind();
+
+            for (size_t first = 0; first < m_DrawSegments.size(); first += s_MaxSegmentsPerDraw)
+            {
+                uint32_t count = (uint32_t)std::min(m_DrawSegments.size() - first, (size_t)s_MaxSegmentsPerDraw);
+                m_SegmentVB->SetData(&m_DrawSegments[first], count * sizeof(TileSegmentData));
+                RenderCommand::DrawIndexedInstanced(m_VertexArray, count);
+            }
+        }
+
+        m_Canvas.EndPaint();
+        m_TileSegments.clear();
+        m_Segments.clear();
+    }
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Hazel/Core/Base.h"
+#include "Hazel/Renderer/Buffer.h"
+#include "Hazel/Renderer/Shader.h"
+#include "Hazel/Renderer/TiledCanvas.h"
+#include "Hazel/Renderer/VertexArray.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace Hazel {
+
+    // Round brush painting into a TiledCanvas. Strokes are queued as line segments in canvas
+    // coordinates and Flush() draws them as capsules, binned by the tiles they cover: one
+    // instanced draw per tile. Along a segment the coverage is the continuous limit of stamping
+    // a dab every Spacing pixels, so a stroke looks the same however it is cut into segments.
+    class CanvasBrush
+    {
+    public:
+        CanvasBrush(TiledCanvas& canvas);
+
+        CanvasBrush(const CanvasBrush&) = delete;
+        CanvasBrush& operator=(const CanvasBrush&) = delete;
+
+        // size is the brush diameter, spacing the equivalent dab spacing, both in canvas pixels.
+        // start == end stamps a single dab.
+        void QueueSegment(const glm::dvec2& start, const glm::dvec2& end, float size, float spacing, const glm::vec3& color);
+
+        // Draws the queued segments into the canvas; once a frame
+        void Flush();
+    private:
+        // Matches the per-instance layout of m_SegmentVB; endpoints relative to the tile corner
+        struct TileSegmentData
+        {
+            glm::vec2 Start, End;
+            float Radius;
+            float Density; // Dabs per pixel (1 / spacing); 0 for a single dab
+            glm::vec3 Color;
+        };
+
+        struct TileSegment
+        {
+            uint64_t Tile;
+            TileSegmentData Segment;
+        };
+
+        // Canvas coordinates, converted when binned
+        struct CanvasSegment
+        {
+            glm::dvec2 Start, End;
+            float Radius;
+            float Density;
+            glm::vec3 Color;
+        };
+
+        static const uint32_t s_MaxSegmentsPerDraw = 4096;
+    private:
+        TiledCanvas& m_Canvas;
+
+        Ref<VertexArray> m_VertexArray;
+        Ref<VertexBuffer> m_SegmentVB;
+        Ref<Shader> m_Shader;
+
+        std::vector<CanvasSegment> m_Segments;
+        std::vector<TileSegment> m_TileSegments;    // Flush() scratch, sorted by tile
+        std::vector<TileSegmentData> m_DrawSegments; // One tile's segments, contiguous for the upload
+    };
+
+}
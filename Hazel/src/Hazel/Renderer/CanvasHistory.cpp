@@ -0,0 +1,239 @@
+#include "hzpch.h"
+#include "Hazel/Renderer/CanvasHistory.h"
+
+#include "Hazel/Renderer/FramebufferPool.h"
+
+namespace Hazel {
+
+    static uint64_t TargetMemory(const Ref<Framebuffer>& target)
+    {
+        return (uint64_t)target->GetStorageWidth() * target->GetStorageHeight() * 4;
+    }
+
+    CanvasHistory::CanvasHistory(TiledCanvas& canvas, const CanvasHistorySpecification& spec)
+        : m_Canvas(canvas), m_Specification(spec)
+    {
+        m_Canvas.SetSnapshotCallback([this](uint64_t tile, TileContent&& before)
+        {
+            if (!m_InStep)
+            {
+                FramebufferPool::Release(before.Target);
+                return;
+            }
+
+            auto snapshot = std::make_shared<TileSnapshot>();
+            snapshot->Tile = tile;
+            snapshot->Content = std::move(before);
+            m_Steps.back().Snapshots.push_back(snapshot);
+        });
+    }
+
+    CanvasHistory::~CanvasHistory()
+    {
+        m_Canvas.SetSnapshotCallback(nullptr);
+        for (Step& step : m_Steps)
+            ReleaseStep(step);
+    }
+
+    void CanvasHistory::BeginStep()
+    {
+        HZ_CORE_ASSERT(!m_InStep, "Step is already open!");
+
+        while (m_Steps.size() > m_Current)
+        {
+            ReleaseStep(m_Steps.back());
+            m_Steps.pop_back();
+        }
+
+        m_Steps.emplace_back();
+        m_Current = m_Steps.size();
+        m_InStep = true;
+        m_Canvas.BeginStroke();
+    }
+
+    void CanvasHistory::EndStep()
+    {
+        HZ_CORE_ASSERT(m_InStep, "No step is open!");
+
+        m_Canvas.EndStroke();
+        m_InStep = false;
+
+        if (m_Steps.back().Snapshots.empty())
+        {
+            m_Steps.pop_back();
+            m_Current--;
+        }
+
+        Trim();
+    }
+
+    void CanvasHistory::Undo()
+    {
+        HZ_PROFILE_FUNCTION();
+
+        if (!CanUndo())
+            return;
+
+        // Backwards, in case a tile changed more than once within the step
+        auto& snapshots = m_Steps[--m_Current].Snapshots;
+        for (auto it = snapshots.rbegin(); it != snapshots.rend(); ++it)
+            Swap(**it);
+        UpdateStatistics();
+    }
+
+    void CanvasHistory::Redo()
+    {
+        HZ_PROFILE_FUNCTION();
+
+        if (!CanRedo())
+            return;
+
+        for (auto& snapshot : m_Steps[m_Current++].Snapshots)
+            Swap(*snapshot);
+        UpdateStatistics();
+    }
+
+    void CanvasHistory::Clear()
+    {
+        HZ_CORE_ASSERT(!m_InStep, "Cannot clear the history with a step open!");
+
+        for (Step& step : m_Steps)
+            ReleaseStep(step);
+        m_Steps.clear();
+        m_Current = 0;
+
+        UpdateStatistics();
+    }
+
+    void CanvasHistory::Update()
+    {
+        // Compressions in flight complete from the renderer's readback poll
+        Trim();
+    }
+
+    void CanvasHistory::Swap(TileSnapshot& snapshot)
+    {
+        snapshot.Content = m_Canvas.ExchangeTile(snapshot.Tile, std::move(snapshot.Content));
+
+        // A compression in flight read what has just left
+        snapshot.PendingCompression = 0;
+    }
+
+    void CanvasHistory::Compress(const std::shared_ptr<TileSnapshot>& snapshot)
+    {
+        uint64_t id = m_NextCompressionID++;
+        snapshot->PendingCompression = id;
+
+        std::weak_ptr<TileSnapshot> weak = snapshot;
+        m_Canvas.EncodeTileAsync(snapshot->Content.Target, [weak, id](std::vector<uint8_t>&& encoded)
+        {
+            auto snapshot = weak.lock();
+            if (!snapshot || snapshot->PendingCompression != id)
+                return;
+
+            FramebufferPool::Release(snapshot->Content.Target);
+            snapshot->Content.Target = nullptr;
+            snapshot->Content.Encoded = std::move(encoded);
+            snapshot->PendingCompression = 0;
+        });
+    }
+
+    bool CanvasHistory::DropStep()
+    {
+        if (m_Steps.size() <= (m_InStep ? 1u : 0u))
+            return false;
+
+        if (m_Current > 0)
+        {
+            ReleaseStep(m_Steps.front());
+            m_Steps.pop_front();
+            m_Current--;
+        }
+        else
+        {
+            ReleaseStep(m_Steps.back());
+            m_Steps.pop_back();
+        }
+        return true;
+    }
+
+    void CanvasHistory::ReleaseStep(Step& step)
+    {
+        for (auto& snapshot : step.Snapshots)
+        {
+            FramebufferPool::Release(snapshot->Content.Target);
+            snapshot->Content = TileContent();
+            snapshot->PendingCompression = 0;
+        }
+        step.Snapshots.clear();
+    }
+
+    void CanvasHistory::Trim()
+    {
+        UpdateStatistics();
+
+        // Snapshots already being compressed are on their way out of GPU memory
+        uint64_t resident = m_Statistics.GpuMemory;
+        for (Step& step : m_Steps)
+            for (auto& snapshot : step.Snapshots)
+                if (snapshot->PendingCompression)
+                    resident -= TargetMemory(snapshot->Content.Target);
+
+        if (resident > m_Specification.GpuSnapshotBudget)
+        {
+            if (m_Specification.CompressSnapshots)
+            {
+                for (Step& step : m_Steps)
+                {
+                    for (auto& snapshot : step.Snapshots)
+                    {
+                        if (resident <= m_Specification.GpuSnapshotBudget)
+                            break;
+                        if (!snapshot->Content.Target || snapshot->PendingCompression)
+                            continue;
+
+                        resident -= TargetMemory(snapshot->Content.Target);
+                        Compress(snapshot);
+                    }
+                }
+                UpdateStatistics();
+            }
+            else
+            {
+                while (m_Statistics.GpuMemory > m_Specification.GpuSnapshotBudget && DropStep())
+                    UpdateStatistics();
+            }
+        }
+
+        while (m_Statistics.GpuMemory + m_Statistics.CompressedMemory > m_Specification.MemoryBudget && DropStep())
+            UpdateStatistics();
+    }
+
+    void CanvasHistory::UpdateStatistics()
+    {
+        m_Statistics = Statistics();
+        m_Statistics.UndoSteps = (uint32_t)m_Current;
+        m_Statistics.RedoSteps = (uint32_t)(m_Steps.size() - m_Current);
+
+        for (const Step& step : m_Steps)
+        {
+            for (const auto& snapshot : step.Snapshots)
+            {
+                if (snapshot->Content.Target)
+                {
+                    m_Statistics.GpuSnapshots++;
+                    m_Statistics.GpuMemory += TargetMemory(snapshot->Content.Target);
+                }
+                else if (!snapshot->Content.Encoded.empty())
+                {
+                    m_Statistics.CompressedSnapshots++;
+                    m_Statistics.CompressedMemory += snapshot->Content.Encoded.capacity();
+                }
+
+                if (snapshot->PendingCompression)
+                    m_Statistics.PendingCompressions++;
+            }
+        }
+    }
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Hazel/Renderer/TiledCanvas.h"
+
+#include <deque>
+#include <memory>
+
+namespace Hazel {
+
+    struct CanvasHistorySpecification
+    {
+        uint64_t MemoryBudget = 256ull << 20;     // Everything the history holds, GPU and compressed
+        uint64_t GpuSnapshotBudget = 64ull << 20; // Past this the oldest snapshots are compressed
+        bool CompressSnapshots = true;            // Otherwise steps past GpuSnapshotBudget are dropped
+    };
+
+    // Undo/redo for a TiledCanvas on top of its tile copy-on-write: a step keeps, for every tile
+    // it changed, the tile's content from before. Undo and redo swap those with the canvas's, so
+    // they only touch the affected tiles and cost a pointer exchange per tile. Past
+    // GpuSnapshotBudget the oldest snapshots are read back without stalling and encoded on a
+    // worker like evicted canvas tiles; past MemoryBudget the oldest steps are dropped.
+    class CanvasHistory
+    {
+    public:
+        struct Statistics
+        {
+            uint32_t UndoSteps = 0, RedoSteps = 0;
+            uint32_t GpuSnapshots = 0, CompressedSnapshots = 0, PendingCompressions = 0;
+            uint64_t GpuMemory = 0, CompressedMemory = 0;
+        };
+    public:
+        CanvasHistory(TiledCanvas& canvas, const CanvasHistorySpecification& spec = CanvasHistorySpecification());
+        ~CanvasHistory();
+
+        CanvasHistory(const CanvasHistory&) = delete;
+        CanvasHistory& operator=(const CanvasHistory&) = delete;
+
+        // Everything painted in between, strokes or Clear(), is one step. Starting a step drops
+        // the redo steps. Canvas strokes outside a step can't be undone.
+        void BeginStep();
+        void EndStep();
+
+        bool CanUndo() const { return !m_InStep && m_Current > 0; }
+        bool CanRedo() const { return !m_InStep && m_Current < m_Steps.size(); }
+        void Undo();
+        void Redo();
+
+        // Forgets every step
+        void Clear();
+
+        // Keeps to the budgets; once a frame
+        void Update();
+
+        const Statistics& GetStatistics() const { return m_Statistics; }
+    private:
+        struct TileSnapshot
+        {
+            uint64_t Tile = 0;
+            TileContent Content;
+            uint64_t PendingCompression = 0; // ID of the compression in flight, 0 if none
+        };
+
+        struct Step
+        {
+            std::vector<std::shared_ptr<TileSnapshot>> Snapshots;
+        };
+
+        // Puts the snapshot on the canvas and keeps what was there, which turns undo into redo
+        void Swap(TileSnapshot& snapshot);
+        void Compress(const std::shared_ptr<TileSnapshot>& snapshot);
+
+        // The oldest undo step, or with none the furthest redo step; never the open step
+        bool DropStep();
+        void ReleaseStep(Step& step);
+
+        void Trim();
+        void UpdateStatistics();
+    private:
+        TiledCanvas& m_Canvas;
+        CanvasHistorySpecification m_Specification;
+
+        std::deque<Step> m_Steps;
+        size_t m_Current = 0; // Steps before this are undone by Undo, the rest redone by Redo
+        bool m_InStep = false;
+
+        uint64_t m_NextCompressionID = 1;
+
+        Statistics m_Statistics;
+    };
+
+}
@@ -4,15 +4,23 @@
 #include "Hazel/Renderer/Renderer.h"
 
 #include "Hazel/Platform/OpenGL/OpenGLFramebuffer.h"
+#include "Hazel/Platform/Recording/RecordingFramebuffer.h"
 
 namespace Hazel {
+
+	static const uint32_t s_StorageBucketSize = 128;
+
+	uint32_t Framebuffer::GetStorageBucket(uint32_t size)
+	{
+		return ((size + s_StorageBucketSize - 1) / s_StorageBucketSize) * s_StorageBucketSize;
+	}
 	
 	Ref<Framebuffer> Framebuffer::Create(const FramebufferSpecification& spec)
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-			case RendererAPI::API::OpenGL:  return std::make_shared<OpenGLFramebuffer>(spec);
+			case RendererAPI::API::None:    return Renderer::CreateResource<RecordingFramebuffer>(spec);
+			case RendererAPI::API::OpenGL:  return Renderer::CreateResource<OpenGLFramebuffer>(spec);
 		}
 
 		HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
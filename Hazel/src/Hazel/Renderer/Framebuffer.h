@@ -45,6 +45,16 @@ namespace Hazel {
 		uint32_t Samples = 1;
 
 		bool SwapChainTarget = false;
+
+		// Round attachment storage up to the size bucket and keep it across resizes that still fit,
+		// rendering into the (0, 0, Width, Height) sub-rect. Sample with GetStorageWidth/Height UV scale.
+		bool Overallocate = false;
+	};
+
+	struct FramebufferRect
+	{
+		int X = 0, Y = 0;
+		uint32_t Width = 1, Height = 1;
 	};
 
 	class Framebuffer
@@ -55,15 +65,46 @@ namespace Hazel {
 		virtual void Bind() = 0;
 		virtual void Unbind() = 0;
 
+		// Binds a color attachment for sampling, e.g. when compositing an offscreen pass
+		virtual void BindColorAttachment(uint32_t index = 0, uint32_t slot = 0) = 0;
+
 		virtual void Resize(uint32_t width, uint32_t height) = 0;
 		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) = 0;
 
+		// Pixels are int32 for RED_INTEGER and 4 x uint8 for RGBA8 attachments, rows bottom-up.
+		// Only valid for the duration of the callback.
+		using ReadPixelsCallback = std::function<void(const void* pixels, const FramebufferRect& rect)>;
+
+		// Queues a non-blocking readback; the callback runs once the GPU has finished, typically
+		// one or two frames later. Renderer::EndFrame polls every framebuffer with readbacks in
+		// flight, so nothing has to poll by hand. With a render thread the pixels are copied and
+		// the callback runs on the main thread from JobSystem::RunMainThreadJobs().
+		virtual void ReadPixelsAsync(uint32_t attachmentIndex, const FramebufferRect& rect, const ReadPixelsCallback& callback) = 0;
+		// Same, with the callback taking the pixels over: for consumers that keep them past the
+		// callback, instead of copying them once more
+		using ReadPixelsBufferCallback = std::function<void(std::vector<uint8_t>&& pixels, const FramebufferRect& rect)>;
+		virtual void ReadPixelsBufferAsync(uint32_t attachmentIndex, const FramebufferRect& rect, const ReadPixelsBufferCallback& callback) = 0;
+		// Delivers what has completed now rather than at the end of the frame
+		virtual void PollReadbacks() = 0;
+
 		virtual void ClearAttachment(uint32_t attachmentIndex, int value) = 0;
 
+		// Copies rect of a color attachment to the same place in destination's attachment of the
+		// same index, which must have the same format and storage that covers rect. Doesn't draw,
+		// so bound shaders, textures and blend state are left alone.
+		virtual void CopyColorAttachment(uint32_t attachmentIndex, const Ref<Framebuffer>& destination, const FramebufferRect& rect) = 0;
+
+		// Only meaningful on the render thread (inside Renderer::Submit)
 		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const = 0;
 
 		virtual const FramebufferSpecification& GetSpecification() const = 0;
 
+		// Size of the allocated attachment textures, >= the specification size when over-allocating
+		virtual uint32_t GetStorageWidth() const = 0;
+		virtual uint32_t GetStorageHeight() const = 0;
+
+		static uint32_t GetStorageBucket(uint32_t size);
+
 		static Ref<Framebuffer> Create(const FramebufferSpecification& spec);
 	};
 
@@ -0,0 +1,136 @@
+#include "hzpch.h"
+#include "Hazel/Renderer/FramebufferPool.h"
+
+namespace Hazel {
+
+	// Pooled framebuffers that stay unused for this many frames are destroyed
+	static const uint64_t s_MaxIdleFrames = 120;
+
+	struct PoolKey
+	{
+		uint64_t Formats = 0;
+		uint32_t Width = 0, Height = 0;
+		uint32_t Samples = 1;
+
+		bool operator==(const PoolKey& other) const
+		{
+			return Formats == other.Formats && Width == other.Width && Height == other.Height && Samples == other.Samples;
+		}
+	};
+
+	struct PoolKeyHash
+	{
+		size_t operator()(const PoolKey& key) const
+		{
+			size_t hash = std::hash<uint64_t>()(key.Formats);
+			hash ^= std::hash<uint64_t>()(((uint64_t)key.Width << 32) | key.Height) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+			hash ^= std::hash<uint32_t>()(key.Samples) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+			return hash;
+		}
+	};
+
+	struct PooledFramebuffer
+	{
+		Ref<Framebuffer> Target;
+		uint64_t LastUsedFrame = 0;
+	};
+
+	struct FramebufferPoolData
+	{
+		std::unordered_map<PoolKey, std::vector<PooledFramebuffer>, PoolKeyHash> Free;
+		std::vector<Ref<Framebuffer>> Transients;
+		uint64_t FrameIndex = 0;
+	};
+
+	static FramebufferPoolData s_Data;
+
+	// Keyed by storage size: what a request would be allocated, or what a released target holds
+	static PoolKey MakeKey(const FramebufferSpecification& spec, uint32_t storageWidth, uint32_t storageHeight)
+	{
+		PoolKey key;
+		for (size_t i = 0; i < spec.Attachments.Attachments.size(); i++)
+			key.Formats |= (uint64_t)spec.Attachments.Attachments[i].TextureFormat << (i * 4);
+
+		key.Width = storageWidth;
+		key.Height = storageHeight;
+		key.Samples = spec.Samples;
+		return key;
+	}
+
+	Ref<Framebuffer> FramebufferPool::Acquire(const FramebufferSpecification& spec)
+	{
+		HZ_CORE_ASSERT(spec.Attachments.Attachments.size() <= 16, "Too many attachments to pool");
+
+		auto it = s_Data.Free.find(MakeKey(spec, Framebuffer::GetStorageBucket(spec.Width), Framebuffer::GetStorageBucket(spec.Height)));
+		if (it != s_Data.Free.end() && !it->second.empty())
+		{
+			Ref<Framebuffer> framebuffer = it->second.back().Target;
+			it->second.pop_back();
+
+			// Same bucket, so this only narrows the viewport
+			framebuffer->Resize(spec.Width, spec.Height);
+			return framebuffer;
+		}
+
+		FramebufferSpecification pooledSpec = spec;
+		pooledSpec.Overallocate = true;
+		return Framebuffer::Create(pooledSpec);
+	}
+
+	void FramebufferPool::Release(const Ref<Framebuffer>& framebuffer)
+	{
+		if (!framebuffer)
+			return;
+
+		PooledFramebuffer entry;
+		entry.Target = framebuffer;
+		entry.LastUsedFrame = s_Data.FrameIndex;
+		// A target shrunk within its storage keeps the larger storage, so it is filed by that
+		s_Data.Free[MakeKey(framebuffer->GetSpecification(), framebuffer->GetStorageWidth(), framebuffer->GetStorageHeight())].push_back(entry);
+	}
+
+	Ref<Framebuffer> FramebufferPool::AcquireTransient(const FramebufferSpecification& spec)
+	{
+		Ref<Framebuffer> framebuffer = Acquire(spec);
+		s_Data.Transients.push_back(framebuffer);
+		return framebuffer;
+	}
+
+	void FramebufferPool::EndFrame()
+	{
+		for (auto& framebuffer : s_Data.Transients)
+			Release(framebuffer);
+		s_Data.Transients.clear();
+
+		s_Data.FrameIndex++;
+
+		for (auto it = s_Data.Free.begin(); it != s_Data.Free.end(); )
+		{
+			auto& entries = it->second;
+			entries.erase(std::remove_if(entries.begin(), entries.end(), [](const PooledFramebuffer& entry)
+				{
+					return s_Data.FrameIndex - entry.LastUsedFrame > s_MaxIdleFrames;
+				}), entries.end());
+
+			if (entries.empty())
+				it = s_Data.Free.erase(it);
+			else
+				++it;
+		}
+	}
+
+	void FramebufferPool::Clear()
+	{
+		s_Data.Transients.clear();
+		s_Data.Free.clear();
+	}
+
+	uint32_t FramebufferPool::GetPooledCount()
+	{
+		uint32_t count = 0;
+		for (auto& [key, entries] : s_Data.Free)
+			count += (uint32_t)entries.size();
+		return count;
+	}
+
+}
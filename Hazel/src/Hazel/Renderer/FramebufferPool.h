@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Hazel/Renderer/Framebuffer.h"
+
+namespace Hazel {
+
+	// Recycles framebuffers keyed by (attachment formats, storage size bucket, samples).
+	// Pooled framebuffers always over-allocate, so sample them with a UV scale of
+	// Width / GetStorageWidth() (and the same for height).
+	class FramebufferPool
+	{
+	public:
+		// Persistent target, returned explicitly with Release()
+		static Ref<Framebuffer> Acquire(const FramebufferSpecification& spec);
+		static void Release(const Ref<Framebuffer>& framebuffer);
+
+		// Target for a single frame (post/offscreen passes), returned to the pool by EndFrame()
+		static Ref<Framebuffer> AcquireTransient(const FramebufferSpecification& spec);
+
+		static void EndFrame();
+		static void Clear();
+
+		static uint32_t GetPooledCount();
+	};
+
+}
@@ -0,0 +1,23 @@
+#include "hzpch.h"
+#include "Hazel/Renderer/GpuProfiler.h"
+
+#include "Hazel/Renderer/Renderer.h"
+
+#include "Hazel/Platform/OpenGL/OpenGLGpuProfiler.h"
+#include "Hazel/Platform/Recording/RecordingGpuProfiler.h"
+
+namespace Hazel {
+
+    Ref<GpuProfiler> GpuProfiler::Create()
+    {
+        switch (Renderer::GetAPI())
+        {
+            case RendererAPI::API::None:    return Renderer::CreateResource<RecordingGpuProfiler>();
+            case RendererAPI::API::OpenGL:  return Renderer::CreateResource<OpenGLGpuProfiler>();
+        }
+
+        HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Hazel/Core/Base.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Hazel {
+
+    // GPU time per named render pass, measured with timestamp queries. Queries of a frame are
+    // read back a few frames later, once the GPU has finished it, so measuring never stalls
+    // the pipeline. All calls record render commands; query results are published to the
+    // main thread through GetPassTimings()/GetFrameTime(). When an Instrumentor session is
+    // open the passes also show up in the trace, on a "GPU" track.
+    class GpuProfiler
+    {
+    public:
+        struct PassTiming
+        {
+            const char* Name = nullptr;
+            uint32_t Depth = 0;      // Nesting level within the frame
+            float LastMs = 0.0f;
+            float AverageMs = 0.0f;  // Exponential moving average
+        };
+    public:
+        virtual ~GpuProfiler() = default;
+
+        // Called by the renderer around every frame
+        virtual void BeginFrame() = 0;
+        virtual void EndFrame() = 0;
+
+        // name is not copied: pass a string literal. Passes may nest.
+        virtual void BeginPass(const char* name) = 0;
+        virtual void EndPass() = 0;
+
+        // Latest resolved frame, in the order the passes began
+        virtual std::vector<PassTiming> GetPassTimings() const = 0;
+        virtual float GetFrameTime() const = 0;
+
+        static Ref<GpuProfiler> Create();
+    };
+
+    class GpuPassScope
+    {
+    public:
+        GpuPassScope(GpuProfiler& profiler, const char* name)
+            : m_Profiler(profiler)
+        {
+            m_Profiler.BeginPass(name);
+        }
+
+        ~GpuPassScope()
+        {
+            m_Profiler.EndPass();
+        }
+
+        GpuPassScope(const GpuPassScope&) = delete;
+        GpuPassScope& operator=(const GpuPassScope&) = delete;
+    private:
+        GpuProfiler& m_Profiler;
+    };
+
+}
@@ -5,8 +5,14 @@ namespace Hazel {
     class GraphicsContext
     {
     public:
+        virtual ~GraphicsContext() = default;
+
         virtual void Init() = 0;
         virtual void SwapBuffers() = 0;
+
+        // Context ownership moves between the main thread and the render thread
+        virtual void MakeCurrent() = 0;
+        virtual void ReleaseCurrent() = 0;
     };
 
-}
\ No newline at end of file
+}
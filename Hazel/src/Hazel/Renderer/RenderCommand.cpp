@@ -1,10 +1,8 @@
 #include "hzpch.h"
 #include "RenderCommand.h"
 
-#include "Hazel/Platform/OpenGL/OpenGLRendererAPI.h"
-
 namespace Hazel {
 
-    RendererAPI* RenderCommand::s_RendererAPI = new OpenGLRendererAPI;
+    Scope<RendererAPI> RenderCommand::s_RendererAPI;
 
 }
\ No newline at end of file
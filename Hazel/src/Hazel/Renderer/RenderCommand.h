@@ -1,33 +1,80 @@
 #pragma once
 
 #include "RendererAPI.h"
+#include "Renderer.h"
 
 namespace Hazel {
 
+    // Every call is a render command: executed on the render thread when there is one
     class RenderCommand
     {
     public:
+        // Picks the backend for RendererAPI::GetAPI()
         inline static void Init()
         {
-            s_RendererAPI->Init();
+            s_RendererAPI = RendererAPI::Create();
+            Renderer::Submit([]() { s_RendererAPI->Init(); });
+        }
+
+        inline static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+        {
+            Renderer::Submit([=]() { s_RendererAPI->SetViewport(x, y, width, height); });
         }
 
         inline static void SetClearColor(const glm::vec4& color)
         {
-            s_RendererAPI->SetClearColor(color);
+            Renderer::Submit([color]() { s_RendererAPI->SetClearColor(color); });
         }
 
         inline static void Clear()
         {
-            s_RendererAPI->Clear();
+            Renderer::Submit([]() { s_RendererAPI->Clear(); });
+        }
+
+        inline static void SetDepthTest(bool enabled)
+        {
+            Renderer::Submit([enabled]() { s_RendererAPI->SetDepthTest(enabled); });
+        }
+
+        inline static void SetDepthWrite(bool enabled)
+        {
+            Renderer::Submit([enabled]() { s_RendererAPI->SetDepthWrite(enabled); });
+        }
+
+        inline static void SetBlend(bool enabled)
+        {
+            Renderer::Submit([enabled]() { s_RendererAPI->SetBlend(enabled); });
+        }
+
+        inline static void SetCullFace(bool enabled)
+        {
+            Renderer::Submit([enabled]() { s_RendererAPI->SetCullFace(enabled); });
         }
 
         inline static void DrawIndexed(const std::shared_ptr<VertexArray>& vertexArray)
         {
-            s_RendererAPI->DrawIndexed(vertexArray);
+            RendererStatistics& stats = Renderer::GetRecordingStats();
+            stats.DrawCalls++;
+            stats.Indices += vertexArray->GetIndexBuffer()->GetCount();
+
+            Renderer::Submit([vertexArray]() { s_RendererAPI->DrawIndexed(vertexArray); });
+        }
+
+        inline static void DrawIndexedInstanced(const std::shared_ptr<VertexArray>& vertexArray, uint32_t instanceCount)
+        {
+            RendererStatistics& stats = Renderer::GetRecordingStats();
+            stats.DrawCalls++;
+            stats.Indices += (uint64_t)vertexArray->GetIndexBuffer()->GetCount() * instanceCount;
+
+            Renderer::Submit([vertexArray, instanceCount]() { s_RendererAPI->DrawIndexedInstanced(vertexArray, instanceCount); });
+        }
+
+        inline static void WaitForFramesInFlight(uint32_t maxFramesInFlight)
+        {
+            Renderer::Submit([maxFramesInFlight]() { s_RendererAPI->WaitForFramesInFlight(maxFramesInFlight); });
         }
     private:
-        static RendererAPI* s_RendererAPI;
+        static Scope<RendererAPI> s_RendererAPI;
     };
 
 }
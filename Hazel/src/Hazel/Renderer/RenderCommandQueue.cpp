@@ -0,0 +1,87 @@
+#include "hzpch.h"
+#include "RenderCommandQueue.h"
+
+#include <cstddef>
+
+namespace Hazel {
+
+    static const uint32_t s_BlockSize = 1024 * 1024;
+    static const uint32_t s_Alignment = alignof(std::max_align_t);
+
+    struct CommandHeader
+    {
+        RenderCommandQueue::RenderCommandFn Function;
+        uint32_t Size; // Header plus padded payload, i.e. the offset to the next command
+    };
+
+    static uint32_t AlignUp(uint32_t value)
+    {
+        return (value + s_Alignment - 1) & ~(s_Alignment - 1);
+    }
+
+    static const uint32_t s_HeaderSize = AlignUp(sizeof(CommandHeader));
+
+    RenderCommandQueue::RenderCommandQueue()
+    {
+        m_Blocks.push_back({ new uint8_t[s_BlockSize], s_BlockSize, 0 });
+    }
+
+    RenderCommandQueue::~RenderCommandQueue()
+    {
+        // Commands still queued own captured resources, release them
+        Execute();
+
+        for (Block& block : m_Blocks)
+            delete[] block.Data;
+    }
+
+    void* RenderCommandQueue::Allocate(RenderCommandFn func, uint32_t size)
+    {
+        uint32_t commandSize = s_HeaderSize + AlignUp(size);
+
+        Block* block = &m_Blocks[m_CurrentBlock];
+        if (block->Used + commandSize > block->Capacity)
+        {
+            // Move on to the next block, or add one big enough for an oversized capture
+            m_CurrentBlock++;
+            if (m_CurrentBlock == m_Blocks.size() || m_Blocks[m_CurrentBlock].Capacity < commandSize)
+            {
+                uint32_t capacity = std::max(s_BlockSize, commandSize);
+                m_Blocks.insert(m_Blocks.begin() + m_CurrentBlock, { new uint8_t[capacity], capacity, 0 });
+            }
+            block = &m_Blocks[m_CurrentBlock];
+        }
+
+        uint8_t* command = block->Data + block->Used;
+        CommandHeader* header = reinterpret_cast<CommandHeader*>(command);
+        header->Function = func;
+        header->Size = commandSize;
+
+        block->Used += commandSize;
+        m_CommandCount++;
+
+        return command + s_HeaderSize;
+    }
+
+    void RenderCommandQueue::Execute()
+    {
+        HZ_PROFILE_FUNCTION();
+
+        for (uint32_t b = 0; b <= m_CurrentBlock && b < m_Blocks.size(); b++)
+        {
+            Block& block = m_Blocks[b];
+            uint32_t offset = 0;
+            while (offset < block.Used)
+            {
+                CommandHeader* header = reinterpret_cast<CommandHeader*>(block.Data + offset);
+                header->Function(block.Data + offset + s_HeaderSize);
+                offset += header->Size;
+            }
+            block.Used = 0;
+        }
+
+        m_CurrentBlock = 0;
+        m_CommandCount = 0;
+    }
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Hazel {
+
+    // Linear buffer of type-erased render commands, recorded on the main thread and
+    // replayed in order by whoever owns the GL context. Each command is stored inline as
+    // [execute fn][payload size][payload]; the payload is the captured lambda, which the
+    // execute fn runs and destroys. Storage grows in fixed blocks so recorded payloads never
+    // move, and is kept across frames.
+    class RenderCommandQueue
+    {
+    public:
+        typedef void(*RenderCommandFn)(void*);
+
+        RenderCommandQueue();
+        ~RenderCommandQueue();
+
+        RenderCommandQueue(const RenderCommandQueue&) = delete;
+        RenderCommandQueue& operator=(const RenderCommandQueue&) = delete;
+
+        // Returns storage for a payload of the given size, aligned for any capture
+        void* Allocate(RenderCommandFn func, uint32_t size);
+
+        // Runs every recorded command in submission order and resets the queue
+        void Execute();
+
+        uint32_t GetCommandCount() const { return m_CommandCount; }
+    private:
+        struct Block
+        {
+            uint8_t* Data = nullptr;
+            uint32_t Capacity = 0;
+            uint32_t Used = 0;
+        };
+
+        std::vector<Block> m_Blocks;
+        uint32_t m_CurrentBlock = 0;
+        uint32_t m_CommandCount = 0;
+    };
+
+}
@@ -0,0 +1,100 @@
+#include "hzpch.h"
+#include "RenderThread.h"
+
+#include "GraphicsContext.h"
+#include "RenderCommandQueue.h"
+
+namespace Hazel {
+
+    static thread_local bool s_IsRenderThread = false;
+
+    RenderThread::RenderThread(GraphicsContext* context)
+        : m_Context(context)
+    {
+    }
+
+    RenderThread::~RenderThread()
+    {
+        Terminate();
+    }
+
+    void RenderThread::Run()
+    {
+        HZ_CORE_ASSERT(!IsRunning(), "Render thread is already running!");
+
+        m_Running = true;
+        m_Thread = std::thread(&RenderThread::ThreadLoop, this);
+    }
+
+    void RenderThread::Terminate()
+    {
+        if (!IsRunning())
+            return;
+
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Condition.wait(lock, [this]() { return m_PendingQueue == nullptr; });
+            m_Running = false;
+        }
+        m_Condition.notify_all();
+        m_Thread.join();
+
+        m_Context->MakeCurrent();
+    }
+
+    void RenderThread::Kick(RenderCommandQueue* queue)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            HZ_CORE_ASSERT(!m_PendingQueue, "Previous frame has not been executed yet!");
+            m_PendingQueue = queue;
+        }
+        m_Condition.notify_all();
+    }
+
+    void RenderThread::WaitIdle()
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Condition.wait(lock, [this]() { return m_PendingQueue == nullptr; });
+    }
+
+    bool RenderThread::IsCurrentThread()
+    {
+        return s_IsRenderThread;
+    }
+
+    void RenderThread::ThreadLoop()
+    {
+        HZ_PROFILE_THREAD("Render Thread");
+
+        s_IsRenderThread = true;
+        m_Context->MakeCurrent();
+
+        while (true)
+        {
+            RenderCommandQueue* queue = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Condition.wait(lock, [this]() { return m_PendingQueue != nullptr || !m_Running; });
+                if (!m_PendingQueue)
+                    break;
+                queue = m_PendingQueue;
+            }
+
+            {
+                HZ_PROFILE_SCOPE("RenderThread::ExecuteFrame");
+                queue->Execute();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_PendingQueue = nullptr;
+            }
+            m_Condition.notify_all();
+        }
+
+        m_Context->ReleaseCurrent();
+        s_IsRenderThread = false;
+    }
+
+}
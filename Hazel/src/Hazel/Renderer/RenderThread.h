@@ -0,0 +1,45 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Hazel {
+
+    class GraphicsContext;
+    class RenderCommandQueue;
+
+    // Owns the graphics context and replays one recorded frame at a time. The main thread
+    // hands over a queue with Kick() and may record the next frame meanwhile; WaitIdle()
+    // blocks until the kicked queue has been executed.
+    class RenderThread
+    {
+    public:
+        RenderThread(GraphicsContext* context);
+        ~RenderThread();
+
+        // The caller must have released the context; the thread makes it current
+        void Run();
+
+        // Executes the kicked frame, joins and makes the context current on the caller again
+        void Terminate();
+
+        void Kick(RenderCommandQueue* queue);
+        void WaitIdle();
+
+        bool IsRunning() const { return m_Thread.joinable(); }
+
+        static bool IsCurrentThread();
+    private:
+        void ThreadLoop();
+    private:
+        GraphicsContext* m_Context;
+        std::thread m_Thread;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+        RenderCommandQueue* m_PendingQueue = nullptr;
+        bool m_Running = false;
+    };
+
+}
@@ -1,34 +1,226 @@
 #include "hzpch.h"
 #include "Renderer.h"
 #include "RenderCommand.h"
-#include "Hazel/Platform/OpenGL/OpenGLShader.h"
+#include "RenderThread.h"
+#include "GraphicsContext.h"
+#include "Framebuffer.h"
+#include "FramebufferPool.h"
+#include "GpuProfiler.h"
+#include "Hazel/Core/FrameAllocator.h"
+#include "Hazel/Core/JobSystem.h"
 
 namespace Hazel {
 
     Renderer::SceneData* Renderer::s_SceneData = new Renderer::SceneData;
 
+    struct RendererData
+    {
+        RendererConfig Config;
+        bool Recording = false;
+
+        // Main thread records into CommandQueues[SubmissionIndex] while the render thread
+        // executes the other one
+        RenderCommandQueue* CommandQueues[2] = { nullptr, nullptr };
+        uint32_t SubmissionIndex = 0;
+
+        Scope<RenderThread> Thread;
+
+        Ref<GpuProfiler> Profiler;
+
+        RendererStatistics Stats;
+        RendererStatistics LastFrameStats;
+
+        // Executing side
+        std::vector<Framebuffer*> ReadbackSources;
+        std::vector<Framebuffer*> ReadbackPollScratch;
+    };
+
+    static RendererData s_Data;
+
     void Renderer::BeginScene(OrthographicCamera& camera)
     {
         s_SceneData->ViewProjectionMatrix = camera.GetViewProjectionMatrix();
     }
 
-    void Renderer::Init()
+    void Renderer::Init(const RendererConfig& config)
     {
+        s_Data.Config = config;
+
         RenderCommand::Init();
+
+        if (config.Threading == RenderThreadingPolicy::MultiThreaded)
+        {
+            s_Data.CommandQueues[0] = new RenderCommandQueue();
+            s_Data.CommandQueues[1] = new RenderCommandQueue();
+            s_Data.Recording = true;
+        }
+
+        s_Data.Profiler = GpuProfiler::Create();
+    }
+
+    void Renderer::Shutdown()
+    {
+        // Its queries are deleted by a render command, queue that before the last flush
+        s_Data.Profiler.reset();
+
+        if (s_Data.Recording)
+        {
+            // Run what is still queued, then take the context back for the remaining
+            // (immediate) destruction of resources on the main thread
+            if (s_Data.Thread && s_Data.Thread->IsRunning())
+            {
+                s_Data.Thread->WaitIdle();
+                s_Data.Thread->Kick(s_Data.CommandQueues[s_Data.SubmissionIndex]);
+                s_Data.Thread->Terminate();
+            }
+            s_Data.Recording = false;
+
+            for (RenderCommandQueue*& queue : s_Data.CommandQueues)
+            {
+                queue->Execute();
+                delete queue;
+                queue = nullptr;
+            }
+            s_Data.Thread.reset();
+        }
+
+        FramebufferPool::Clear();
+    }
+
+    void Renderer::BeginFrame()
+    {
+        s_Data.Profiler->BeginFrame();
+    }
+
+    void Renderer::EndFrame()
+    {
+        s_Data.Profiler->EndFrame();
+        FramebufferPool::EndFrame();
+        Submit([]() { RT_PollReadbackSources(); });
+
+        s_Data.LastFrameStats = s_Data.Stats;
+        s_Data.Stats = RendererStatistics();
+    }
+
+    void Renderer::StartRenderThread(GraphicsContext* context)
+    {
+        if (s_Data.Config.Threading != RenderThreadingPolicy::MultiThreaded || s_Data.Thread)
+            return;
+
+        context->ReleaseCurrent();
+        s_Data.Thread = std::make_unique<RenderThread>(context);
+        s_Data.Thread->Run();
+
+        HZ_CORE_INFO("Renderer: render thread started, {0} frame(s) in flight", s_Data.Config.MaxFramesInFlight);
+    }
+
+    void Renderer::WaitAndRender()
+    {
+        HZ_PROFILE_FUNCTION();
+
+        RenderCommand::WaitForFramesInFlight(s_Data.Config.MaxFramesInFlight);
+
+        if (!s_Data.Thread)
+        {
+            FrameAllocator::NextFrame();
+            return;
+        }
+
+        // The render thread is at most one frame behind the main thread
+        s_Data.Thread->WaitIdle();
+
+        // Recycles the previous frame's scratch memory while nothing else touches it
+        FrameAllocator::NextFrame();
+
+        s_Data.Thread->Kick(s_Data.CommandQueues[s_Data.SubmissionIndex]);
+        s_Data.SubmissionIndex ^= 1;
     }
 
     void Renderer::EndScene()
     {
     }
 
-    void Renderer::Submit(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray, const glm::mat4& transform)
+    void Renderer::Submit(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray, const glm::mat4& transform, const SetUniformsFn& setUniforms)
     {
+        HZ_PROFILE_SCOPE("Renderer::Submit");
+
         shader->Bind();
-         std::dynamic_pointer_cast<OpenGLShader>(shader)->UploadUniformMat4("u_ViewProjection", s_SceneData->ViewProjectionMatrix);
-        std::dynamic_pointer_cast<OpenGLShader>(shader)->UploadUniformMat4("u_Transform", transform);
+        shader->SetMat4("u_ViewProjection", s_SceneData->ViewProjectionMatrix);
+        shader->SetMat4("u_Transform", transform);
+        if (setUniforms)
+            setUniforms(*shader);
 
         vertexArray->Bind();
         RenderCommand::DrawIndexed(vertexArray);
     }
 
-}
\ No newline at end of file
+    void Renderer::RT_AddReadbackSource(Framebuffer* framebuffer)
+    {
+        auto& sources = s_Data.ReadbackSources;
+        if (std::find(sources.begin(), sources.end(), framebuffer) == sources.end())
+            sources.push_back(framebuffer);
+    }
+
+    void Renderer::RT_RemoveReadbackSource(Framebuffer* framebuffer)
+    {
+        auto& sources = s_Data.ReadbackSources;
+        auto it = std::find(sources.begin(), sources.end(), framebuffer);
+        if (it != sources.end())
+        {
+            *it = sources.back();
+            sources.pop_back();
+        }
+    }
+
+    void Renderer::RT_PollReadbackSources()
+    {
+        // A completed readback's callback can start readbacks or free framebuffers (it runs
+        // right here when single-threaded), so poll a copy and skip what has left the list
+        auto& sources = s_Data.ReadbackSources;
+        auto& polled = s_Data.ReadbackPollScratch;
+        polled.assign(sources.begin(), sources.end());
+        for (Framebuffer* framebuffer : polled)
+        {
+            if (std::find(sources.begin(), sources.end(), framebuffer) != sources.end())
+                framebuffer->PollReadbacks();
+        }
+        polled.clear();
+    }
+
+    bool Renderer::IsRenderThread()
+    {
+        return s_Data.Thread ? RenderThread::IsCurrentThread() : true;
+    }
+
+    const RendererConfig& Renderer::GetConfig()
+    {
+        return s_Data.Config;
+    }
+
+    GpuProfiler& Renderer::GetGpuProfiler()
+    {
+        return *s_Data.Profiler;
+    }
+
+    const RendererStatistics& Renderer::GetStats()
+    {
+        return s_Data.LastFrameStats;
+    }
+
+    RendererStatistics& Renderer::GetRecordingStats()
+    {
+        return s_Data.Stats;
+    }
+
+    bool Renderer::IsRecording()
+    {
+        return s_Data.Recording && !RenderThread::IsCurrentThread();
+    }
+
+    RenderCommandQueue& Renderer::GetRecordingQueue()
+    {
+        HZ_CORE_ASSERT(JobSystem::IsMainThread(), "Render commands must be recorded on the main thread!");
+        return *s_Data.CommandQueues[s_Data.SubmissionIndex];
+    }
+
+}
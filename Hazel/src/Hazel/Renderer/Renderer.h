@@ -1,26 +1,147 @@
 #pragma once
 
+#include "Hazel/Core/Base.h"
+
 #include "RendererAPI.h"
+#include "RenderCommandQueue.h"
 
 #include "OrthographicCamera.h"
 #include "Shader.h"
 
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace Hazel {
 
+    class GraphicsContext;
+    class GpuProfiler;
+    class Framebuffer;
+
+    enum class RenderThreadingPolicy
+    {
+        // GL calls run immediately on the main thread
+        SingleThreaded = 0,
+        // Layers record frame N+1 while a render thread that owns the context executes frame N
+        MultiThreaded
+    };
+
+    struct RendererConfig
+    {
+        RenderThreadingPolicy Threading = RenderThreadingPolicy::SingleThreaded;
+
+        // Frames the GPU may have queued before submission blocks on the oldest one;
+        // lower values trade throughput for input latency
+        uint32_t MaxFramesInFlight = 2;
+    };
+
+    // Work recorded for one frame. Counted when the command is recorded, so single- and
+    // multi-threaded rendering report the same numbers.
+    struct RendererStatistics
+    {
+        uint32_t DrawCalls = 0;
+        uint64_t Indices = 0;
+        uint32_t ShaderBinds = 0;
+        uint32_t VertexArrayBinds = 0;
+        uint32_t TextureBinds = 0;
+        uint32_t UniformUploads = 0;
+        uint64_t BufferBytesUploaded = 0; // Vertex/index buffer and texture data
+        uint32_t FramebufferSwitches = 0;
+
+        uint64_t GetTriangleCount() const { return Indices / 3; }
+    };
+
     class Renderer
     {
     public:
-        static void Init();
+        static void Init(const RendererConfig& config = RendererConfig());
+        static void Shutdown();
+
+        // Bracket the commands of one application frame
+        static void BeginFrame();
+        static void EndFrame();
+
+        // Moves the context to the render thread (multi-threaded policy only); what was
+        // recorded before becomes its first frame
+        static void StartRenderThread(GraphicsContext* context);
+
+        // Ends command recording for the frame: waits for the render thread to finish the
+        // previous one, then hands this one over. Called after the window swap is submitted.
+        static void WaitAndRender();
+
         static void BeginScene(OrthographicCamera& camera);
         static void EndScene();
 
+        // Per-draw uniforms beyond the camera and transform, set after Submit binds the shader
+        using SetUniformsFn = std::function<void(Shader&)>;
+
         static void Submit(const std::shared_ptr<Shader>& shader, 
                            const std::shared_ptr<VertexArray>& vertexArray,
-                           const glm::mat4& transform = glm::mat4(1.0f));
+                           const glm::mat4& transform = glm::mat4(1.0f),
+                           const SetUniformsFn& setUniforms = nullptr);
+
+        // Runs func wherever the context lives: immediately when single-threaded or already on
+        // the render thread, otherwise recorded for the next frame. Capture by value; anything
+        // captured by reference must outlive the frame. Record from the main thread only.
+        template<typename FuncT>
+        static void Submit(FuncT&& func)
+        {
+            using CommandT = std::decay_t<FuncT>;
+
+            if (!IsRecording())
+            {
+                func();
+                return;
+            }
 
+            auto renderCmd = [](void* ptr)
+            {
+                auto pFunc = static_cast<CommandT*>(ptr);
+                (*pFunc)();
+                pFunc->~CommandT();
+            };
+
+            static_assert(alignof(CommandT) <= alignof(std::max_align_t), "Over-aligned render command capture");
+            void* storage = GetRecordingQueue().Allocate(renderCmd, sizeof(CommandT));
+            new (storage) CommandT(std::forward<FuncT>(func));
+        }
+
+        // Wraps a new resource so its destructor (and the GL deletes in it) runs after every
+        // command recorded so far, which may still reference the object
+        template<typename T, typename... Args>
+        static Ref<T> CreateResource(Args&&... args)
+        {
+            return Ref<T>(new T(std::forward<Args>(args)...), [](T* resource)
+            {
+                Submit([resource]() { delete resource; });
+            });
+        }
+
+        static bool IsRenderThread();
+        static const RendererConfig& GetConfig();
+
+        // Per-pass GPU timings; BeginFrame/EndFrame already bracket the frame
+        static GpuProfiler& GetGpuProfiler();
+
+        // Executing side (render thread, or main thread when single-threaded): framebuffers
+        // register while they have readbacks in flight, and EndFrame polls every one of them,
+        // so a readback completes whether or not its framebuffer is used again
+        static void RT_AddReadbackSource(Framebuffer* framebuffer);
+        static void RT_RemoveReadbackSource(Framebuffer* framebuffer);
+
+        // Counters of the last finished frame
+        static const RendererStatistics& GetStats();
+        // Counters of the frame being recorded; render backends add to these
+        static RendererStatistics& GetRecordingStats();
 
         inline static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
+    private:
+        static void RT_PollReadbackSources();
+
+        static bool IsRecording();
+        static RenderCommandQueue& GetRecordingQueue();
     private:
         struct SceneData
         {
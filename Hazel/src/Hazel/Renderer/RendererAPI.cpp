@@ -1,8 +1,23 @@
 #include "hzpch.h"
 #include "RendererAPI.h"
 
+#include "Hazel/Platform/OpenGL/OpenGLRendererAPI.h"
+#include "Hazel/Platform/Recording/RecordingRendererAPI.h"
+
 namespace Hazel {
 
     RendererAPI::API RendererAPI::s_API = RendererAPI::API::OpenGL;
 
+    Scope<RendererAPI> RendererAPI::Create()
+    {
+        switch (s_API)
+        {
+            case RendererAPI::API::None:    return std::make_unique<RecordingRendererAPI>();
+            case RendererAPI::API::OpenGL:  return std::make_unique<OpenGLRendererAPI>();
+        }
+
+        HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <glm/glm.hpp>
 
+#include "Hazel/Core/Base.h"
 #include "VertexArray.h"
 
 namespace Hazel {
@@ -11,16 +12,36 @@ namespace Hazel {
     public:
         enum class API
         {
+            // No GPU: CPU-side objects, render commands go to an inspectable stream
+            // (RecordingRendererAPI)
             None = 0, OpenGL = 1
         };
     public:
+        virtual ~RendererAPI() = default;
+
         virtual void SetClearColor(const glm::vec4& color) = 0;
         virtual void Clear() = 0;
         virtual void Init() = 0;
 
+        virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
+        virtual void SetDepthTest(bool enabled) = 0;
+        virtual void SetDepthWrite(bool enabled) = 0;
+        virtual void SetBlend(bool enabled) = 0;
+        virtual void SetCullFace(bool enabled) = 0;
+
         virtual void DrawIndexed(const std::shared_ptr<VertexArray>& vertexArray) = 0;
+        // Per-instance attributes come from the vertex buffers with VertexStepRate::PerInstance
+        virtual void DrawIndexedInstanced(const std::shared_ptr<VertexArray>& vertexArray, uint32_t instanceCount) = 0;
+
+        // Fences the frame just submitted and blocks until no more than maxFramesInFlight
+        // fenced frames are still pending on the GPU
+        virtual void WaitForFramesInFlight(uint32_t maxFramesInFlight) = 0;
 
         inline static API GetAPI() { return s_API; }
+        // Before Renderer::Init; resources created by one backend can't be used with another
+        inline static void SetAPI(API api) { s_API = api; }
+
+        static Scope<RendererAPI> Create();
     private:
         static API s_API;
     };
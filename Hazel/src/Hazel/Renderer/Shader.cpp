@@ -3,6 +3,7 @@
 
 #include "Renderer.h"
 #include "Hazel/Platform/OpenGL/OpenGLShader.h"
+#include "Hazel/Platform/Recording/RecordingShader.h"
 
 namespace Hazel {
 
@@ -10,8 +11,8 @@ namespace Hazel {
     {
         switch (Renderer::GetAPI())
         {
-        case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-        case RendererAPI::API::OpenGL:  return std::make_shared <OpenGLShader>(filepath);
+        case RendererAPI::API::None:    return Renderer::CreateResource<RecordingShader>(filepath);
+        case RendererAPI::API::OpenGL:  return Renderer::CreateResource<OpenGLShader>(filepath);
         }
 
         HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -23,8 +24,8 @@ namespace Hazel {
     {
         switch (Renderer::GetAPI())
         {
-            case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-            case RendererAPI::API::OpenGL:  return std::make_shared <OpenGLShader>(name, vertexSrc, fragmentSrc);
+            case RendererAPI::API::None:    return Renderer::CreateResource<RecordingShader>(name, vertexSrc, fragmentSrc);
+            case RendererAPI::API::OpenGL:  return Renderer::CreateResource<OpenGLShader>(name, vertexSrc, fragmentSrc);
         }
 
         HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
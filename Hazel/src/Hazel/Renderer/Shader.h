@@ -1,10 +1,13 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include "Hazel/Core/Base.h"
 
+#include <glm/glm.hpp>
+
 namespace Hazel {
 
     class Shader
@@ -17,6 +20,15 @@ namespace Hazel {
 
         virtual const std::string& GetName() const = 0;
 
+        // Recorded like any other render command; applies to this shader, bind it first
+        virtual void SetInt(std::string_view name, int value) = 0;
+        virtual void SetFloat(std::string_view name, float value) = 0;
+        virtual void SetFloat2(std::string_view name, const glm::vec2& value) = 0;
+        virtual void SetFloat3(std::string_view name, const glm::vec3& value) = 0;
+        virtual void SetFloat4(std::string_view name, const glm::vec4& value) = 0;
+        virtual void SetMat3(std::string_view name, const glm::mat3& matrix) = 0;
+        virtual void SetMat4(std::string_view name, const glm::mat4& matrix) = 0;
+
         static Ref<Shader> Create(const std::string& filepath);
         static Ref<Shader> Create(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
     };
@@ -3,6 +3,7 @@
 
 #include "Renderer.h"
 #include "Hazel/Platform/OpenGL/OpenGLTexture.h"
+#include "Hazel/Platform/Recording/RecordingTexture.h"
 
 namespace Hazel {
 
@@ -10,8 +11,8 @@ namespace Hazel {
     {
         switch (Renderer::GetAPI())
         {
-            case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-            case RendererAPI::API::OpenGL:  return std::make_shared<OpenGLTexture2D>(width, height);
+            case RendererAPI::API::None:    return Renderer::CreateResource<RecordingTexture2D>(width, height);
+            case RendererAPI::API::OpenGL:  return Renderer::CreateResource<OpenGLTexture2D>(width, height);
         }
 
         HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -22,8 +23,8 @@ namespace Hazel {
     {
         switch (Renderer::GetAPI())
         {
-            case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-            case RendererAPI::API::OpenGL:  return std::make_shared<OpenGLTexture2D>(path);
+            case RendererAPI::API::None:    return Renderer::CreateResource<RecordingTexture2D>(path);
+            case RendererAPI::API::OpenGL:  return Renderer::CreateResource<OpenGLTexture2D>(path);
         }
 
         HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -15,6 +15,8 @@ namespace Hazel {
         virtual uint32_t GetHeight() const = 0;
 
         virtual void SetData(void* data, uint32_t size) = 0;
+        // Updates the width x height region at (x, y); data holds just that region, rows packed
+        virtual void SetData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
 
         virtual void Bind(uint32_t slot = 0) const = 0;
     };
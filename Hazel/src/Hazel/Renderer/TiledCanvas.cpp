@@ -0,0 +1,761 @@
+#include "hzpch.h"
+#include "Hazel/Renderer/TiledCanvas.h"
+
+#include "Hazel/Core/JobSystem.h"
+#include "Hazel/Renderer/Buffer.h"
+#include "Hazel/Renderer/FramebufferPool.h"
+#include "Hazel/Renderer/RenderCommand.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Hazel {
+
+    static const char* s_CanvasVertexShader = R"(
+        #version 330 core
+        layout (location = 0) in vec2 a_Position; // Unit quad
+        uniform vec4 u_Rect;
+        uniform vec4 u_UVRect;
+        out vec2 v_TexCoord;
+        void main() {
+            gl_Position = vec4(mix(u_Rect.xy, u_Rect.zw, a_Position), 0.0, 1.0);
+            v_TexCoord = mix(u_UVRect.xy, u_UVRect.zw, a_Position);
+        }
+    )";
+
+    static const char* s_CanvasFragmentShader = R"(
+        #version 330 core
+        out vec4 FragColor;
+        in vec2 v_TexCoord;
+        uniform sampler2D u_Texture;
+        uniform int u_Blank;
+        uniform vec4 u_ClearColor;
+        void main() {
+            FragColor = u_Blank != 0 ? u_ClearColor : texture(u_Texture, v_TexCoord);
+        }
+    )";
+
+    // Evicted tiles in view decoded and drawn per Composite(); each goes through the one staging texture
+    static const uint32_t s_MaxDecodesPerFrame = 64;
+
+    static uint64_t TargetMemory(const Ref<Framebuffer>& target)
+    {
+        return (uint64_t)target->GetStorageWidth() * target->GetStorageHeight() * 4;
+    }
+
+    TiledCanvas::TiledCanvas(const TiledCanvasSpecification& spec)
+        : m_Specification(spec), m_Lifetime(std::make_shared<TiledCanvas*>(this))
+    {
+        HZ_CORE_ASSERT(spec.TileSize > 0, "Canvas tiles have no size!");
+
+        m_Shader = Shader::Create("TiledCanvas", s_CanvasVertexShader, s_CanvasFragmentShader);
+
+        float vertices[] = {
+            0.0f, 0.0f,
+            1.0f, 0.0f,
+            1.0f, 1.0f,
+            0.0f, 1.0f
+        };
+        uint32_t indices[] = { 0, 1, 2, 2, 3, 0 };
+
+        m_QuadVA = VertexArray::Create();
+        Ref<VertexBuffer> vertexBuffer = VertexBuffer::Create(vertices, sizeof(vertices));
+        vertexBuffer->SetLayout({
+            { ShaderDataType::Float2, "a_Position" }
+        });
+        m_QuadVA->AddVertexBuffer(vertexBuffer);
+        m_QuadVA->SetIndexBuffer(IndexBuffer::Create(indices, 6));
+    }
+
+    bool TiledCanvas::GetTileRange(const glm::dvec2& min, const glm::dvec2& max, glm::ivec4& range) const
+    {
+        double x0 = min.x, y0 = min.y, x1 = max.x, y1 = max.y;
+        if (m_Specification.Width)
+        {
+            x0 = std::max(x0, 0.0);
+            x1 = std::min(x1, (double)m_Specification.Width);
+        }
+        if (m_Specification.Height)
+        {
+            y0 = std::max(y0, 0.0);
+            y1 = std::min(y1, (double)m_Specification.Height);
+        }
+        if (!(x0 < x1 && y0 < y1))
+            return false;
+
+        double size = (double)m_Specification.TileSize;
+        range = glm::ivec4((int)std::floor(x0 / size), (int)std::floor(y0 / size), (int)std::ceil(x1 / size), (int)std::ceil(y1 / size));
+        return true;
+    }
+
+    glm::mat4 TiledCanvas::BeginPaint(int tileX, int tileY)
+    {
+        HZ_CORE_ASSERT(!m_Specification.Width || (tileX >= 0 && (uint64_t)tileX * m_Specification.TileSize < m_Specification.Width), "Tile is outside the canvas!");
+        HZ_CORE_ASSERT(!m_Specification.Height || (tileY >= 0 && (uint64_t)tileY * m_Specification.TileSize < m_Specification.Height), "Tile is outside the canvas!");
+
+        uint64_t key = TileKey(tileX, tileY);
+        Tile& tile = m_Tiles[key];
+        MakeResident(tile);
+
+        // What an eviction in flight reads back is about to change
+        tile.PendingEviction = 0;
+
+        if (m_InStroke && !tile.InStroke)
+            Snapshot(key, tile);
+
+        bool blank = !tile.Content.Target;
+        if (blank)
+        {
+            tile.Content.Target = AcquireTileTarget();
+            Account(tile.Content, 1);
+        }
+
+        tile.Content.Target->Bind();
+        m_PaintTarget = tile.Content.Target.get();
+        if (blank)
+        {
+            // Pooled targets come back with whatever they held last
+            RenderCommand::SetClearColor(m_Specification.ClearColor);
+            RenderCommand::Clear();
+        }
+
+        tile.LastUsed = m_Frame;
+        MarkDirty(key, tile);
+
+        float size = (float)m_Specification.TileSize;
+        return glm::ortho(0.0f, size, size, 0.0f);
+    }
+
+    void TiledCanvas::EndPaint()
+    {
+        if (m_PaintTarget)
+        {
+            m_PaintTarget->Unbind();
+            m_PaintTarget = nullptr;
+        }
+    }
+
+    void TiledCanvas::WritePixels(const CanvasRect& rect, const void* data)
+    {
+        HZ_PROFILE_FUNCTION();
+
+        uint32_t tileSize = m_Specification.TileSize;
+        if (!m_Staging)
+            m_Staging = Texture2D::Create(tileSize, tileSize);
+
+        std::vector<uint8_t> region;
+        region.reserve((size_t)tileSize * tileSize * 4);
+
+        int rectX1 = rect.X + (int)rect.Width, rectY1 = rect.Y + (int)rect.Height;
+        ForEachTile({ (double)rect.X, (double)rect.Y }, { (double)rectX1, (double)rectY1 }, [&](int tileX, int tileY)
+        {
+            int tileLeft = tileX * (int)tileSize, tileTop = tileY * (int)tileSize;
+            int x0 = std::max(rect.X, tileLeft), x1 = std::min(rectX1, tileLeft + (int)tileSize);
+            int y0 = std::max(rect.Y, tileTop), y1 = std::min(rectY1, tileTop + (int)tileSize);
+            if (m_Specification.Width)
+                x1 = std::min(x1, (int)m_Specification.Width);
+            if (m_Specification.Height)
+                y1 = std::min(y1, (int)m_Specification.Height);
+            uint32_t width = x1 - x0, height = y1 - y0;
+
+            // Bringing the tile back goes through the staging texture, so before filling it
+            BeginPaint(tileX, tileY);
+
+            // Only the part of the rect inside this tile crosses to the GPU
+            region.resize((size_t)width * height * 4);
+            for (uint32_t row = 0; row < height; row++)
+            {
+                const uint8_t* source = (const uint8_t*)data + (((size_t)(y0 - rect.Y + row)) * rect.Width + (x0 - rect.X)) * 4;
+                memcpy(&region[(size_t)row * width * 4], source, (size_t)width * 4);
+            }
+            m_Staging->SetData(region.data(), 0, 0, width, height);
+
+            // Replaces, doesn't blend
+            RenderCommand::SetBlend(false);
+            m_Shader->Bind();
+            m_Shader->SetInt("u_Texture", 0);
+            m_Staging->Bind(0);
+            m_QuadVA->Bind();
+
+            // Staging row 0 is the top row of the region
+            float size = (float)tileSize;
+            glm::vec4 target = {
+                (x0 - tileLeft) / size * 2.0f - 1.0f, 1.0f - (y1 - tileTop) / size * 2.0f,
+                (x1 - tileLeft) / size * 2.0f - 1.0f, 1.0f - (y0 - tileTop) / size * 2.0f
+            };
+            DrawQuad(target, { 0.0f, height / size, width / size, 0.0f }, false);
+        });
+
+        EndPaint();
+        RenderCommand::SetBlend(true);
+    }
+
+    void TiledCanvas::Clear()
+    {
+        for (auto& [key, tile] : m_Tiles)
+        {
+            if (tile.Content.IsBlank())
+                continue;
+
+            Account(tile.Content, -1);
+
+            // The tile goes blank, so its content can be handed over without a copy
+            if (m_InStroke && !tile.InStroke && m_SnapshotCallback)
+                m_SnapshotCallback(key, std::move(tile.Content));
+            else
+                FramebufferPool::Release(tile.Content.Target);
+            tile.Content = TileContent();
+            tile.PendingEviction = 0;
+
+            MarkDirty(key, tile);
+        }
+
+        m_ViewInvalid = true;
+    }
+
+    void TiledCanvas::BeginStroke()
+    {
+        for (uint64_t key : m_StrokeTiles)
+        {
+            auto it = m_Tiles.find(key);
+            if (it != m_Tiles.end())
+                it->second.InStroke = false;
+        }
+        m_StrokeTiles.clear();
+        m_InStroke = true;
+    }
+
+    TileContent TiledCanvas::ExchangeTile(uint64_t tile, TileContent&& content)
+    {
+        HZ_CORE_ASSERT(!m_InStroke, "Tiles cannot be exchanged during a stroke!");
+
+        Tile& entry = m_Tiles[tile];
+        Account(entry.Content, -1);
+        Account(content, 1);
+
+        TileContent previous = std::move(entry.Content);
+        entry.Content = std::move(content);
+        entry.PendingEviction = 0;
+
+        MarkDirty(tile, entry);
+        return previous;
+    }
+
+    Ref<Framebuffer> TiledCanvas::AcquireTileTarget() const
+    {
+        FramebufferSpecification spec;
+        spec.Width = spec.Height = m_Specification.TileSize;
+        spec.Attachments = { FramebufferTextureFormat::RGBA8 };
+        return FramebufferPool::Acquire(spec);
+    }
+
+    void TiledCanvas::EncodeTileAsync(const Ref<Framebuffer>& target, const EncodeCallback& callback) const
+    {
+        uint32_t tileSize = m_Specification.TileSize;
+        FramebufferRect rect;
+        rect.Width = rect.Height = tileSize;
+
+        target->ReadPixelsAsync(0, rect, [tileSize, callback](const void* pixels, const FramebufferRect&)
+        {
+            auto rows = std::make_shared<std::vector<uint32_t>>((const uint32_t*)pixels, (const uint32_t*)pixels + (size_t)tileSize * tileSize);
+            JobSystem::Schedule([rows, tileSize, callback]()
+            {
+                // Rows come back bottom-up
+                std::vector<uint32_t>& pixels = *rows;
+                for (uint32_t y = 0; y < tileSize / 2; y++)
+                    std::swap_ranges(&pixels[(size_t)y * tileSize], &pixels[(size_t)(y + 1) * tileSize], &pixels[(size_t)(tileSize - 1 - y) * tileSize]);
+
+                auto encoded = std::make_shared<std::vector<uint8_t>>(EncodePixels(pixels.data(), pixels.size()));
+                JobSystem::ScheduleOnMainThread([encoded, callback]()
+                {
+                    callback(std::move(*encoded));
+                });
+            });
+        });
+    }
+
+    // A header byte n < 128 is followed by n + 1 literal pixels, n >= 128 by one pixel repeated
+    // n - 126 times. Painted tiles are mostly flat colour, so runs go a long way.
+    std::vector<uint8_t> TiledCanvas::EncodePixels(const uint32_t* pixels, size_t count)
+    {
+        std::vector<uint8_t> encoded;
+        auto put = [&encoded](const uint32_t* first, size_t n)
+        {
+            const uint8_t* bytes = (const uint8_t*)first;
+            encoded.insert(encoded.end(), bytes, bytes + n * 4);
+        };
+
+        size_t i = 0;
+        while (i < count)
+        {
+            size_t run = 1;
+            while (i + run < count && run < 129 && pixels[i + run] == pixels[i])
+                run++;
+
+            if (run >= 2)
+            {
+                encoded.push_back((uint8_t)(run + 126));
+                put(&pixels[i], 1);
+                i += run;
+                continue;
+            }
+
+            // Literals up to where the next run starts
+            size_t first = i;
+            while (i < count && i - first < 128 && !(i + 1 < count && pixels[i + 1] == pixels[i]))
+                i++;
+            encoded.push_back((uint8_t)(i - first - 1));
+            put(&pixels[first], i - first);
+        }
+
+        encoded.shrink_to_fit();
+        return encoded;
+    }
+
+    void TiledCanvas::DecodePixels(const std::vector<uint8_t>& encoded, uint32_t* pixels, size_t count)
+    {
+        size_t read = 0, written = 0;
+        while (read < encoded.size())
+        {
+            uint8_t header = encoded[read++];
+            size_t n = header < 128 ? header + 1 : header - 126;
+            HZ_CORE_ASSERT(written + n <= count, "Tile decodes to more pixels than it has!");
+
+            if (header < 128)
+            {
+                memcpy(&pixels[written], &encoded[read], n * 4);
+                read += n * 4;
+            }
+            else
+            {
+                uint32_t pixel;
+                memcpy(&pixel, &encoded[read], 4);
+                read += 4;
+                std::fill_n(&pixels[written], n, pixel);
+            }
+            written += n;
+        }
+
+        HZ_CORE_ASSERT(written == count, "Tile decodes to fewer pixels than it has!");
+    }
+
+    void TiledCanvas::SetView(const glm::dvec2& origin, double zoom)
+    {
+        HZ_CORE_ASSERT(zoom > 0.0, "View zoom must be positive!");
+
+        if (origin == m_ViewOrigin && zoom == m_ViewZoom)
+            return;
+
+        m_ViewOrigin = origin;
+        m_ViewZoom = zoom;
+        m_ViewInvalid = true;
+    }
+
+    void TiledCanvas::Restore(Tile& tile, const uint32_t* pixels)
+    {
+        uint32_t tileSize = m_Specification.TileSize;
+        if (!m_Staging)
+            m_Staging = Texture2D::Create(tileSize, tileSize);
+        m_Staging->SetData(pixels, 0, 0, tileSize, tileSize);
+
+        Ref<Framebuffer> target = AcquireTileTarget();
+        target->Bind();
+        RenderCommand::SetBlend(false);
+        m_Shader->Bind();
+        m_Shader->SetInt("u_Texture", 0);
+        m_Staging->Bind(0);
+        m_QuadVA->Bind();
+
+        // Staging row 0 is the tile's top row
+        DrawQuad({ -1.0f, -1.0f, 1.0f, 1.0f }, { 0.0f, 1.0f, 1.0f, 0.0f }, false);
+
+        RenderCommand::SetBlend(true);
+        target->Unbind();
+
+        Account(tile.Content, -1);
+        tile.Content.Target = target;
+        std::vector<uint8_t>().swap(tile.Content.Encoded);
+        Account(tile.Content, 1);
+    }
+
+    void TiledCanvas::MakeResident(Tile& tile)
+    {
+        if (tile.Content.Target || tile.Content.Encoded.empty())
+            return;
+
+        std::vector<uint32_t> pixels((size_t)m_Specification.TileSize * m_Specification.TileSize);
+        DecodePixels(tile.Content.Encoded, pixels.data(), pixels.size());
+        Restore(tile, pixels.data());
+    }
+
+    void TiledCanvas::Snapshot(uint64_t key, Tile& tile)
+    {
+        if (!m_SnapshotCallback)
+            return;
+
+        TileContent before;
+        if (tile.Content.Target)
+        {
+            before.Target = tile.Content.Target;
+            tile.Content.Target = AcquireTileTarget();
+            before.Target->CopyColorAttachment(0, tile.Content.Target, { 0, 0, m_Specification.TileSize, m_Specification.TileSize });
+        }
+
+        m_SnapshotCallback(key, std::move(before));
+    }
+
+    void TiledCanvas::MarkDirty(uint64_t key, Tile& tile)
+    {
+        if (!tile.Dirty)
+        {
+            tile.Dirty = true;
+            m_DirtyTiles.push_back(key);
+        }
+
+        if (m_InStroke && !tile.InStroke)
+        {
+            tile.InStroke = true;
+            m_StrokeTiles.push_back(key);
+        }
+    }
+
+    void TiledCanvas::EvictTiles()
+    {
+        uint64_t budget = m_Specification.ResidentMemoryBudget;
+        if (m_Statistics.ResidentMemory <= budget)
+            return;
+
+        // Least recently used first; tiles already on their way out don't count. Tiles in view
+        // can go too: they are composited by now, and the view target keeps their pixels.
+        uint64_t resident = m_Statistics.ResidentMemory;
+        std::vector<std::pair<uint64_t, uint64_t>> candidates; // (LastUsed, key)
+        for (auto& [key, tile] : m_Tiles)
+        {
+            if (!tile.Content.Target)
+                continue;
+
+            if (tile.PendingEviction)
+                resident -= TargetMemory(tile.Content.Target);
+            else
+                candidates.emplace_back(tile.LastUsed, key);
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        for (const auto& [lastUsed, key] : candidates)
+        {
+            if (resident <= budget)
+                break;
+
+            Tile& tile = m_Tiles[key];
+            resident -= TargetMemory(tile.Content.Target);
+
+            uint64_t id = m_NextEvictionID++;
+            tile.PendingEviction = id;
+
+            std::weak_ptr<TiledCanvas*> lifetime = m_Lifetime;
+            EncodeTileAsync(tile.Content.Target, [lifetime, key = key, id](std::vector<uint8_t>&& encoded)
+            {
+                if (auto canvas = lifetime.lock())
+                    (*canvas)->CompleteEviction(key, id, std::move(encoded));
+            });
+        }
+    }
+
+    void TiledCanvas::CompleteEviction(uint64_t key, uint64_t id, std::vector<uint8_t>&& encoded)
+    {
+        auto it = m_Tiles.find(key);
+        if (it == m_Tiles.end() || it->second.PendingEviction != id)
+            return;
+
+        Tile& tile = it->second;
+        Account(tile.Content, -1);
+        FramebufferPool::Release(tile.Content.Target);
+        tile.Content.Target = nullptr;
+        tile.Content.Encoded = std::move(encoded);
+        tile.PendingEviction = 0;
+        Account(tile.Content, 1);
+    }
+
+    void TiledCanvas::Account(const TileContent& content, int sign)
+    {
+        if (content.IsBlank())
+            return;
+
+        m_Statistics.Tiles += sign;
+        if (content.Target)
+        {
+            m_Statistics.ResidentTiles += sign;
+            m_Statistics.ResidentMemory += sign * (int64_t)TargetMemory(content.Target);
+        }
+        else
+        {
+            m_Statistics.EvictedTiles += sign;
+            m_Statistics.EvictedMemory += sign * (int64_t)content.Encoded.capacity();
+        }
+    }
+
+    void TiledCanvas::Composite(uint32_t viewWidth, uint32_t viewHeight)
+    {
+        HZ_PROFILE_FUNCTION();
+
+        m_Statistics.CompositedTiles = 0;
+        m_Statistics.DecodedTiles = 0;
+        m_Statistics.DeferredTiles = 0;
+        if (viewWidth == 0 || viewHeight == 0)
+            return;
+
+        if (!m_ViewTarget)
+        {
+            FramebufferSpecification spec;
+            spec.Width = viewWidth;
+            spec.Height = viewHeight;
+            spec.Attachments = { FramebufferTextureFormat::RGBA8 };
+            // Resized with the window; a live resize drag stays within the storage buckets
+            // instead of reallocating every frame, and Present() samples only the used part
+            spec.Overallocate = true;
+            m_ViewTarget = Framebuffer::Create(spec);
+            m_ViewInvalid = true;
+        }
+        else if (m_ViewTarget->GetSpecification().Width != viewWidth || m_ViewTarget->GetSpecification().Height != viewHeight)
+        {
+            m_ViewTarget->Resize(viewWidth, viewHeight);
+            m_ViewInvalid = true;
+        }
+
+        // Tiles to draw: every non-blank one in view, or the dirty ones in view
+        glm::dvec2 viewMin = m_ViewOrigin, viewMax = ViewToCanvas({ (double)viewWidth, (double)viewHeight });
+        glm::ivec4 range;
+        bool anyInView = GetTileRange(viewMin, viewMax, range);
+        auto inView = [&](uint64_t key)
+        {
+            glm::ivec2 coord = TileCoord(key);
+            return anyInView && coord.x >= range.x && coord.x < range.z && coord.y >= range.y && coord.y < range.w;
+        };
+
+        m_VisibleTiles.clear();
+        if (m_ViewInvalid)
+        {
+            m_DeferredTiles.clear();
+
+            // Looking up the tiles in view or walking the table, whichever is less
+            uint64_t viewTiles = anyInView ? (uint64_t)(range.z - range.x) * (uint64_t)(range.w - range.y) : 0;
+            if (viewTiles <= m_Tiles.size())
+            {
+                ForEachTile(viewMin, viewMax, [this](int tileX, int tileY)
+                {
+                    auto it = m_Tiles.find(TileKey(tileX, tileY));
+                    if (it != m_Tiles.end() && !it->second.Content.IsBlank())
+                        m_VisibleTiles.push_back(it->first);
+                });
+            }
+            else
+            {
+                for (const auto& [key, tile] : m_Tiles)
+                    if (!tile.Content.IsBlank() && inView(key))
+                        m_VisibleTiles.push_back(key);
+            }
+        }
+        else
+        {
+            for (uint64_t key : m_DirtyTiles)
+                if (inView(key))
+                    m_VisibleTiles.push_back(key);
+
+            // Still waiting from earlier frames; dirty ones may be among them
+            for (uint64_t key : m_DeferredTiles)
+                if (m_Tiles.count(key))
+                    m_VisibleTiles.push_back(key);
+            m_DeferredTiles.clear();
+            std::sort(m_VisibleTiles.begin(), m_VisibleTiles.end());
+            m_VisibleTiles.erase(std::unique(m_VisibleTiles.begin(), m_VisibleTiles.end()), m_VisibleTiles.end());
+        }
+
+        // Evicted tiles in view are drawn from their decoded pixels rather than made resident,
+        // which would take the GPU memory the budget just freed. Past the per-frame limit they
+        // wait for the following frames.
+        // The targets are held from here on, and the workers only read the encoded sources,
+        // never the table.
+        m_DecodeTiles.clear();
+        m_DecodeSources.clear();
+        m_VisibleTargets.clear();
+        m_VisibleTiles.erase(std::remove_if(m_VisibleTiles.begin(), m_VisibleTiles.end(), [this](uint64_t key)
+        {
+            auto it = m_Tiles.find(key);
+            if (it == m_Tiles.end())
+                return true;
+
+            Tile& tile = it->second;
+            tile.LastUsed = m_Frame;
+            if (tile.Content.Target || tile.Content.Encoded.empty())
+            {
+                m_VisibleTargets.push_back(tile.Content.Target);
+                return false;
+            }
+
+            if (m_DecodeTiles.size() < s_MaxDecodesPerFrame)
+            {
+                m_DecodeTiles.push_back(key);
+                m_DecodeSources.push_back(&tile.Content.Encoded);
+            }
+            else
+                m_DeferredTiles.push_back(key);
+            return true;
+        }), m_VisibleTiles.end());
+
+        size_t tilePixels = (size_t)m_Specification.TileSize * m_Specification.TileSize;
+        if (!m_DecodeTiles.empty())
+        {
+            m_DecodePixels.resize(m_DecodeTiles.size() * tilePixels);
+            JobSystem::ParallelFor((uint32_t)m_DecodeTiles.size(), 1, [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; i++)
+                    DecodePixels(*m_DecodeSources[i], &m_DecodePixels[i * tilePixels], tilePixels);
+            });
+        }
+        m_Statistics.DecodedTiles = (uint32_t)m_DecodeTiles.size();
+        m_Statistics.DeferredTiles = (uint32_t)m_DeferredTiles.size();
+
+        if (m_ViewInvalid || !m_VisibleTiles.empty() || !m_DecodeTiles.empty())
+        {
+            m_ViewTarget->Bind();
+            RenderCommand::SetBlend(false);
+            m_Shader->Bind();
+            m_Shader->SetInt("u_Texture", 0);
+            m_Shader->SetFloat4("u_ClearColor", m_Specification.ClearColor);
+            m_QuadVA->Bind();
+
+            if (m_ViewInvalid && (m_Specification.Width || m_Specification.Height))
+            {
+                // Blank canvas over the background, where the canvas is
+                RenderCommand::SetClearColor(m_Specification.BackgroundColor);
+                RenderCommand::Clear();
+
+                glm::dvec2 canvasMin = viewMin, canvasMax = viewMax;
+                if (m_Specification.Width)
+                {
+                    canvasMin.x = std::max(canvasMin.x, 0.0);
+                    canvasMax.x = std::min(canvasMax.x, (double)m_Specification.Width);
+                }
+                if (m_Specification.Height)
+                {
+                    canvasMin.y = std::max(canvasMin.y, 0.0);
+                    canvasMax.y = std::min(canvasMax.y, (double)m_Specification.Height);
+                }
+                if (canvasMin.x < canvasMax.x && canvasMin.y < canvasMax.y)
+                    DrawQuad(ToViewRect(canvasMin, canvasMax), glm::vec4(0.0f), true);
+            }
+            else if (m_ViewInvalid)
+            {
+                RenderCommand::SetClearColor(m_Specification.ClearColor);
+                RenderCommand::Clear();
+            }
+
+            for (size_t i = 0; i < m_VisibleTiles.size(); i++)
+                CompositeTile(m_VisibleTiles[i], m_VisibleTargets[i]);
+            for (size_t i = 0; i < m_DecodeTiles.size(); i++)
+                CompositeTile(m_DecodeTiles[i], nullptr, &m_DecodePixels[i * tilePixels]);
+            m_VisibleTargets.clear();
+
+            RenderCommand::SetBlend(true);
+            m_ViewTarget->Unbind();
+        }
+
+        // Tiles that went blank leave the table, unless the stroke still tracks them
+        for (uint64_t key : m_DirtyTiles)
+        {
+            auto it = m_Tiles.find(key);
+            if (it == m_Tiles.end())
+                continue;
+
+            it->second.Dirty = false;
+            if (it->second.Content.IsBlank() && !(m_InStroke && it->second.InStroke))
+                m_Tiles.erase(it);
+        }
+        m_DirtyTiles.clear();
+        m_ViewInvalid = false;
+
+        EvictTiles();
+        m_Frame++;
+    }
+
+    void TiledCanvas::CompositeTile(uint64_t key, const Ref<Framebuffer>& target, const uint32_t* decoded)
+    {
+        uint32_t tileSize = m_Specification.TileSize;
+
+        // The part of the tile that is on the canvas
+        glm::ivec2 coord = TileCoord(key);
+        glm::dvec2 min = GetTileOrigin(coord.x, coord.y), max = min + (double)tileSize;
+        if (m_Specification.Width)
+            max.x = std::min(max.x, (double)m_Specification.Width);
+        if (m_Specification.Height)
+            max.y = std::min(max.y, (double)m_Specification.Height);
+
+        glm::vec4 rect = ToViewRect(min, max);
+        if (decoded)
+        {
+            if (!m_Staging)
+                m_Staging = Texture2D::Create(tileSize, tileSize);
+            m_Staging->SetData(decoded, 0, 0, tileSize, tileSize);
+            m_Staging->Bind(0);
+
+            // Staging row 0 is the tile's top row
+            float width = (float)(max.x - min.x), height = (float)(max.y - min.y);
+            DrawQuad(rect, { 0.0f, height / tileSize, width / tileSize, 0.0f }, false);
+        }
+        else if (target)
+        {
+            // Tile row 0 is at the bottom; its top edge is at v = TileSize / storage height
+            float width = (float)(max.x - min.x), height = (float)(max.y - min.y);
+            float storageWidth = (float)target->GetStorageWidth(), storageHeight = (float)target->GetStorageHeight();
+            glm::vec4 uv = {
+                0.0f, (tileSize - height) / storageHeight,
+                width / storageWidth, tileSize / storageHeight
+            };
+            target->BindColorAttachment(0, 0);
+            DrawQuad(rect, uv, false);
+        }
+        else
+        {
+            DrawQuad(rect, glm::vec4(0.0f), true);
+        }
+
+        m_Statistics.CompositedTiles++;
+    }
+
+    glm::vec4 TiledCanvas::ToViewRect(const glm::dvec2& min, const glm::dvec2& max) const
+    {
+        double scaleX = m_ViewZoom / m_ViewTarget->GetSpecification().Width * 2.0;
+        double scaleY = m_ViewZoom / m_ViewTarget->GetSpecification().Height * 2.0;
+        return {
+            (float)((min.x - m_ViewOrigin.x) * scaleX - 1.0), (float)(1.0 - (max.y - m_ViewOrigin.y) * scaleY),
+            (float)((max.x - m_ViewOrigin.x) * scaleX - 1.0), (float)(1.0 - (min.y - m_ViewOrigin.y) * scaleY)
+        };
+    }
+
+    void TiledCanvas::Present()
+    {
+        if (!m_ViewTarget)
+            return;
+
+        const FramebufferSpecification& spec = m_ViewTarget->GetSpecification();
+        RenderCommand::SetViewport(0, 0, spec.Width, spec.Height);
+        RenderCommand::SetBlend(false);
+
+        m_Shader->Bind();
+        m_Shader->SetInt("u_Texture", 0);
+        m_ViewTarget->BindColorAttachment(0, 0);
+        m_QuadVA->Bind();
+        DrawQuad({ -1.0f, -1.0f, 1.0f, 1.0f },
+            { 0.0f, 0.0f, (float)spec.Width / m_ViewTarget->GetStorageWidth(), (float)spec.Height / m_ViewTarget->GetStorageHeight() }, false);
+
+        RenderCommand::SetBlend(true);
+    }
+
+    void TiledCanvas::DrawQuad(const glm::vec4& rect, const glm::vec4& uvRect, bool blank)
+    {
+        m_Shader->SetFloat4("u_Rect", rect);
+        m_Shader->SetFloat4("u_UVRect", uvRect);
+        m_Shader->SetInt("u_Blank", blank ? 1 : 0);
+        RenderCommand::DrawIndexed(m_QuadVA);
+    }
+
+}
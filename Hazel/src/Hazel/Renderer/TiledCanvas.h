@@ -0,0 +1,221 @@
+#pragma once
+
+#include "Hazel/Core/Base.h"
+#include "Hazel/Renderer/Framebuffer.h"
+#include "Hazel/Renderer/Shader.h"
+#include "Hazel/Renderer/Texture.h"
+#include "Hazel/Renderer/VertexArray.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Hazel {
+
+    struct TiledCanvasSpecification
+    {
+        uint32_t Width = 0, Height = 0; // Canvas size in pixels; 0 leaves that axis unbounded
+        uint32_t TileSize = 256;
+
+        // Tile render targets kept on the GPU. Past it the least recently used tiles are evicted
+        // to host memory, run-length encoded, and brought back when painted again. In view they
+        // are drawn straight from host memory, so the budget holds however far out the view zooms.
+        uint64_t ResidentMemoryBudget = 256ull << 20;
+
+        glm::vec4 ClearColor = { 1.0f, 1.0f, 1.0f, 1.0f };      // What blank tiles read as
+        glm::vec4 BackgroundColor = { 0.1f, 0.1f, 0.1f, 1.0f }; // View area outside a bounded canvas
+    };
+
+    // Canvas pixels, y down like window and mouse coordinates
+    struct CanvasRect
+    {
+        int X = 0, Y = 0;
+        uint32_t Width = 0, Height = 0;
+    };
+
+    // A tile's pixels: a render target, or encoded in host memory. Neither is a blank tile.
+    struct TileContent
+    {
+        Ref<Framebuffer> Target;
+        std::vector<uint8_t> Encoded;
+
+        bool IsBlank() const { return !Target && Encoded.empty(); }
+    };
+
+    // Paint surface split into square tiles, kept in a sparse table keyed by tile coordinates so
+    // the canvas can extend without bound. A tile gets a render target (from the FramebufferPool)
+    // the first time it is painted; blank tiles have no entry and cost nothing. Painting marks
+    // tiles dirty, and Composite() redraws only the dirty tiles into a view-sized target that
+    // Present() puts on screen with one quad, so the cost of a frame follows what was painted
+    // rather than the size of the canvas. Panning or zooming redraws the tiles in view.
+    class TiledCanvas
+    {
+    public:
+        struct Statistics
+        {
+            uint32_t Tiles = 0;            // Non-blank
+            uint32_t ResidentTiles = 0;
+            uint64_t ResidentMemory = 0;   // Bytes of tile render targets
+            uint32_t EvictedTiles = 0;
+            uint64_t EvictedMemory = 0;    // Bytes of encoded tiles in host memory
+            uint32_t CompositedTiles = 0;  // By the last Composite()
+            uint32_t DecodedTiles = 0;     // Drawn from host memory by the last Composite()
+            uint32_t DeferredTiles = 0;    // Evicted tiles in view left for the next Composite()
+        };
+    public:
+        TiledCanvas(const TiledCanvasSpecification& spec);
+
+        TiledCanvas(const TiledCanvas&) = delete;
+        TiledCanvas& operator=(const TiledCanvas&) = delete;
+
+        const TiledCanvasSpecification& GetSpecification() const { return m_Specification; }
+
+        static uint64_t TileKey(int tileX, int tileY) { return ((uint64_t)(uint32_t)tileX << 32) | (uint32_t)tileY; }
+        static glm::ivec2 TileCoord(uint64_t key) { return { (int)(uint32_t)(key >> 32), (int)(uint32_t)key }; }
+
+        // Canvas position of a tile's top-left corner
+        glm::dvec2 GetTileOrigin(int tileX, int tileY) const { return glm::dvec2(tileX, tileY) * (double)m_Specification.TileSize; }
+
+        // Tiles the canvas bounds [min, max) overlap, as [x, z) by [y, w); false if none
+        bool GetTileRange(const glm::dvec2& min, const glm::dvec2& max, glm::ivec4& range) const;
+
+        // Calls func(tileX, tileY) for every tile the canvas bounds [min, max) overlap
+        template<typename F>
+        void ForEachTile(const glm::dvec2& min, const glm::dvec2& max, F&& func) const
+        {
+            glm::ivec4 range;
+            if (!GetTileRange(min, max, range))
+                return;
+
+            for (int y = range.y; y < range.w; y++)
+                for (int x = range.x; x < range.z; x++)
+                    func(x, y);
+        }
+
+        // Binds the tile's render target for drawing, bringing it back from host memory or
+        // allocating it blank as needed, and marks it dirty. Returns the projection from tile
+        // pixels (y down from the tile's corner) onto the tile, so positions stay exact however
+        // far out the tile is. Bringing a tile back draws: bind other drawing state after this.
+        glm::mat4 BeginPaint(int tileX, int tileY);
+        void EndPaint();
+
+        // Replaces the pixels of rect with RGBA8 data (rect.Width * rect.Height * 4 bytes, rows top-down)
+        void WritePixels(const CanvasRect& rect, const void* data);
+
+        // Back to blank; render targets go back to the pool, or to the snapshot callback
+        // for tiles a stroke hasn't touched yet
+        void Clear();
+
+        // Tiles painted between BeginStroke and EndStroke; valid until the next BeginStroke
+        void BeginStroke();
+        void EndStroke() { m_InStroke = false; }
+        const std::vector<uint64_t>& GetStrokeTiles() const { return m_StrokeTiles; }
+
+        // Copy-on-write for undo. Set, the first time a stroke changes a tile, its content from
+        // before the stroke is handed to the callback and the stroke paints on a copy. Only
+        // touched tiles are copied, and a blank tile costs nothing.
+        using SnapshotCallback = std::function<void(uint64_t tile, TileContent&& before)>;
+        void SetSnapshotCallback(const SnapshotCallback& callback) { m_SnapshotCallback = callback; }
+
+        // Puts content in place of the tile's and returns what it replaced; how snapshots are
+        // restored. Encoded content is brought back once the tile is painted. Not during a stroke.
+        TileContent ExchangeTile(uint64_t tile, TileContent&& content);
+
+        // A tile-sized RGBA8 target from the pool, holding whatever it held last
+        Ref<Framebuffer> AcquireTileTarget() const;
+
+        // Reads a tile target back without stalling and encodes it on a worker. The callback
+        // runs on the main thread, typically a few frames later.
+        using EncodeCallback = std::function<void(std::vector<uint8_t>&& encoded)>;
+        void EncodeTileAsync(const Ref<Framebuffer>& target, const EncodeCallback& callback) const;
+
+        // Run-length encoding of RGBA8 tile pixels, rows top-down
+        static std::vector<uint8_t> EncodePixels(const uint32_t* pixels, size_t count);
+        static void DecodePixels(const std::vector<uint8_t>& encoded, uint32_t* pixels, size_t count);
+
+        // The canvas point at the view's top-left corner, and view pixels per canvas pixel
+        void SetView(const glm::dvec2& origin, double zoom);
+        const glm::dvec2& GetViewOrigin() const { return m_ViewOrigin; }
+        double GetViewZoom() const { return m_ViewZoom; }
+        glm::dvec2 ViewToCanvas(const glm::dvec2& view) const { return m_ViewOrigin + view / m_ViewZoom; }
+
+        // Brings the view target up to date: the dirty tiles, or every tile in view after the
+        // view changed. Evicted tiles in view are decoded a limited number a frame; while
+        // Statistics::DeferredTiles isn't 0 the view is still filling in and wants more frames.
+        // Then evicts tiles past the budget, including ones in view: the view target has them.
+        void Composite(uint32_t viewWidth, uint32_t viewHeight);
+        // Draws the view target over the whole default framebuffer
+        void Present();
+
+        const Statistics& GetStatistics() const { return m_Statistics; }
+    private:
+        struct Tile
+        {
+            TileContent Content;
+            uint64_t LastUsed = 0;        // Frame it was last painted or in view, for LRU eviction
+            uint64_t PendingEviction = 0; // ID of the eviction in flight, 0 if none
+            bool Dirty = false;
+            bool InStroke = false;
+        };
+
+        // Uploads an evicted tile's pixels to a fresh target
+        void Restore(Tile& tile, const uint32_t* pixels);
+        void MakeResident(Tile& tile);
+        // Before a stroke first changes a tile
+        void Snapshot(uint64_t key, Tile& tile);
+        void MarkDirty(uint64_t key, Tile& tile);
+
+        void EvictTiles();
+        void CompleteEviction(uint64_t key, uint64_t id, std::vector<uint8_t>&& encoded);
+
+        // Adds (sign 1) or removes (sign -1) content from the statistics
+        void Account(const TileContent& content, int sign);
+
+        // From target, or with decoded, from the tile's pixels in host memory; blank without either
+        void CompositeTile(uint64_t key, const Ref<Framebuffer>& target, const uint32_t* decoded = nullptr);
+        // Canvas bounds to the view target's clip space, as (min.xy, max.xy)
+        glm::vec4 ToViewRect(const glm::dvec2& min, const glm::dvec2& max) const;
+        // Draws the texture in slot 0 (ClearColor if blank) over rect; both rects are (min.xy, max.xy)
+        void DrawQuad(const glm::vec4& rect, const glm::vec4& uvRect, bool blank);
+    private:
+        TiledCanvasSpecification m_Specification;
+        std::unordered_map<uint64_t, Tile> m_Tiles;
+        std::vector<uint64_t> m_DirtyTiles;
+        uint64_t m_Frame = 1; // Composite() count
+
+        Framebuffer* m_PaintTarget = nullptr; // Bound by BeginPaint
+
+        bool m_InStroke = false;
+        std::vector<uint64_t> m_StrokeTiles;
+        SnapshotCallback m_SnapshotCallback;
+
+        uint64_t m_NextEvictionID = 1;
+        std::shared_ptr<TiledCanvas*> m_Lifetime; // Expires with the canvas; evictions in flight check it
+
+        glm::dvec2 m_ViewOrigin = { 0.0, 0.0 };
+        double m_ViewZoom = 1.0;
+        Ref<Framebuffer> m_ViewTarget;
+        bool m_ViewInvalid = true;
+
+        // Composite() scratch. What to draw is resolved up front, so the draws don't depend on
+        // the table staying as it was while the decodes ran.
+        std::vector<uint64_t> m_VisibleTiles;
+        std::vector<Ref<Framebuffer>> m_VisibleTargets;
+        std::vector<uint64_t> m_DecodeTiles;
+        std::vector<const std::vector<uint8_t>*> m_DecodeSources;
+        std::vector<uint32_t> m_DecodePixels;
+        std::vector<uint64_t> m_DeferredTiles; // Evicted tiles in view not yet drawn
+
+        Ref<Texture2D> m_Staging; // Uploads, one tile at a time
+        Ref<Shader> m_Shader;
+        Ref<VertexArray> m_QuadVA;
+
+        Statistics m_Statistics;
+    };
+
+}
@@ -3,15 +3,16 @@
 
 #include "Renderer.h"
 #include "Hazel/Platform/OpenGL/OpenGLVertexArray.h"
+#include "Hazel/Platform/Recording/RecordingVertexArray.h"
 
 namespace Hazel {
 
-    VertexArray* VertexArray::Create()
+    Ref<VertexArray> VertexArray::Create()
     {
         switch (Renderer::GetAPI())
         {
-            case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-            case RendererAPI::API::OpenGL:  return new OpenGLVertexArray();
+            case RendererAPI::API::None:    return Renderer::CreateResource<RecordingVertexArray>();
+            case RendererAPI::API::OpenGL:  return Renderer::CreateResource<OpenGLVertexArray>();
         }
 
         HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -20,7 +20,7 @@ namespace Hazel {
         virtual const std::vector<std::shared_ptr<VertexBuffer>>& GetVertexBuffers() const = 0;
         virtual const std::shared_ptr<IndexBuffer>& GetIndexBuffer() const = 0;
 
-        static VertexArray* Create();
+        static Ref<VertexArray> Create();
     };
 
 }
@@ -0,0 +1,140 @@
+#include "hzpch.h"
+#include "Hazel/Scene/Archetype.h"
+
+#include <cstring>
+
+namespace Hazel {
+
+    // Sized so a chunk of a typical archetype stays within L2
+    static const uint32_t s_TargetChunkBytes = 16 * 1024;
+
+    static std::vector<ComponentInfo>& GetComponentInfos()
+    {
+        static std::vector<ComponentInfo> infos;
+        return infos;
+    }
+
+    uint32_t ComponentRegistry::Register(uint32_t size, uint32_t alignment)
+    {
+        auto& infos = GetComponentInfos();
+        HZ_CORE_ASSERT(infos.size() < MaxComponentTypes, "Too many component types!");
+        HZ_CORE_ASSERT(alignment <= 16, "Component alignment above 16 is not supported");
+        infos.push_back({ size, alignment });
+        return (uint32_t)infos.size() - 1;
+    }
+
+    const ComponentInfo& ComponentRegistry::GetInfo(uint32_t typeID)
+    {
+        return GetComponentInfos()[typeID];
+    }
+
+    static uint32_t AlignUp(uint32_t value, uint32_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    Archetype::Archetype(ComponentMask mask)
+        : m_Mask(mask)
+    {
+        uint32_t rowBytes = sizeof(EntityHandle);
+        for (uint32_t id = 0; id < MaxComponentTypes; id++)
+        {
+            if (Has(id))
+                rowBytes += ComponentRegistry::GetInfo(id).Size;
+        }
+
+        m_ChunkCapacity = std::max(1u, s_TargetChunkBytes / rowBytes);
+
+        uint32_t offset = m_ChunkCapacity * sizeof(EntityHandle);
+        for (uint32_t id = 0; id < MaxComponentTypes; id++)
+        {
+            if (!Has(id))
+                continue;
+
+            const ComponentInfo& info = ComponentRegistry::GetInfo(id);
+            offset = AlignUp(offset, info.Alignment);
+            m_ColumnOffsets[id] = offset;
+            m_ColumnSizes[id] = info.Size;
+            offset += m_ChunkCapacity * info.Size;
+        }
+        m_ChunkBytes = offset;
+    }
+
+    uint32_t Archetype::GetChunkSize(uint32_t chunk) const
+    {
+        uint32_t begin = chunk * m_ChunkCapacity;
+        return begin < m_Count ? std::min(m_ChunkCapacity, m_Count - begin) : 0;
+    }
+
+    EntityHandle* Archetype::GetEntities(uint32_t chunk)
+    {
+        return reinterpret_cast<EntityHandle*>(m_Chunks[chunk].get());
+    }
+
+    void* Archetype::GetColumn(uint32_t chunk, uint32_t typeID)
+    {
+        HZ_CORE_ASSERT(Has(typeID), "Archetype does not contain component");
+        return m_Chunks[chunk].get() + m_ColumnOffsets[typeID];
+    }
+
+    void* Archetype::GetComponent(uint32_t row, uint32_t typeID)
+    {
+        HZ_CORE_ASSERT(Has(typeID), "Archetype does not contain component");
+        return RowAddress(row, typeID);
+    }
+
+    uint8_t* Archetype::RowAddress(uint32_t row, uint32_t typeID)
+    {
+        uint32_t chunk = row / m_ChunkCapacity;
+        uint32_t slot = row % m_ChunkCapacity;
+        return m_Chunks[chunk].get() + m_ColumnOffsets[typeID] + slot * m_ColumnSizes[typeID];
+    }
+
+    uint32_t Archetype::Allocate(EntityHandle entity)
+    {
+        uint32_t row = m_Count++;
+        if (row / m_ChunkCapacity >= m_Chunks.size())
+            m_Chunks.emplace_back(new uint8_t[m_ChunkBytes]);
+
+        GetEntities(row / m_ChunkCapacity)[row % m_ChunkCapacity] = entity;
+        return row;
+    }
+
+    EntityHandle Archetype::RemoveSwap(uint32_t row)
+    {
+        HZ_CORE_ASSERT(row < m_Count, "Row out of range");
+
+        uint32_t last = m_Count - 1;
+        EntityHandle moved;
+        if (row != last)
+        {
+            moved = GetEntities(last / m_ChunkCapacity)[last % m_ChunkCapacity];
+            GetEntities(row / m_ChunkCapacity)[row % m_ChunkCapacity] = moved;
+
+            for (uint32_t id = 0; id < MaxComponentTypes; id++)
+            {
+                if (Has(id))
+                    std::memcpy(RowAddress(row, id), RowAddress(last, id), m_ColumnSizes[id]);
+            }
+        }
+
+        m_Count--;
+
+        // Keep one spare chunk around so entities oscillating at a chunk boundary don't thrash
+        if (m_Chunks.size() > (m_Count + m_ChunkCapacity - 1) / m_ChunkCapacity + 1)
+            m_Chunks.pop_back();
+
+        return moved;
+    }
+
+    void Archetype::CopyShared(Archetype& src, uint32_t srcRow, Archetype& dst, uint32_t dstRow)
+    {
+        ComponentMask shared = src.m_Mask & dst.m_Mask;
+        for (uint32_t id = 0; id < MaxComponentTypes; id++)
+        {
+            if ((shared >> id) & 1u)
+                std::memcpy(dst.RowAddress(dstRow, id), src.RowAddress(srcRow, id), src.m_ColumnSizes[id]);
+        }
+    }
+
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Hazel {
+
+    using ComponentMask = uint32_t;
+    static const uint32_t MaxComponentTypes = 32;
+
+    struct EntityHandle
+    {
+        uint32_t Index = UINT32_MAX;
+        uint32_t Generation = 0;
+
+        bool IsNull() const { return Index == UINT32_MAX; }
+        bool operator==(const EntityHandle& other) const { return Index == other.Index && Generation == other.Generation; }
+        bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+    };
+
+    struct ComponentInfo
+    {
+        uint32_t Size = 0;
+        uint32_t Alignment = 0;
+    };
+
+    class ComponentRegistry
+    {
+    public:
+        template<typename T>
+        static uint32_t GetTypeID()
+        {
+            static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value,
+                "Components are memcpy'd between archetype chunks");
+            static const uint32_t id = Register(sizeof(T), alignof(T));
+            return id;
+        }
+
+        template<typename... Ts>
+        static ComponentMask GetMask()
+        {
+            ComponentMask mask = 0;
+            ((mask |= 1u << GetTypeID<Ts>()), ...);
+            return mask;
+        }
+
+        static const ComponentInfo& GetInfo(uint32_t typeID);
+    private:
+        static uint32_t Register(uint32_t size, uint32_t alignment);
+    };
+
+    // Entities sharing one component set, stored as fixed-size chunks of SoA columns:
+    // [EntityHandle x capacity][Component A x capacity][Component B x capacity]...
+    class Archetype
+    {
+    public:
+        Archetype(ComponentMask mask);
+
+        ComponentMask GetMask() const { return m_Mask; }
+        bool Has(uint32_t typeID) const { return (m_Mask >> typeID) & 1u; }
+
+        uint32_t GetCount() const { return m_Count; }
+        uint32_t GetChunkCapacity() const { return m_ChunkCapacity; }
+        uint32_t GetChunkCount() const { return (uint32_t)m_Chunks.size(); }
+        uint32_t GetChunkSize(uint32_t chunk) const;
+
+        EntityHandle* GetEntities(uint32_t chunk);
+        void* GetColumn(uint32_t chunk, uint32_t typeID);
+        void* GetComponent(uint32_t row, uint32_t typeID);
+
+        // Appends an uninitialised row, returns its index
+        uint32_t Allocate(EntityHandle entity);
+
+        // Removes a row by moving the last row into it. Returns the entity that now lives
+        // in that row, or a null handle if the removed row was the last one.
+        EntityHandle RemoveSwap(uint32_t row);
+
+        // Copies every component both archetypes have from srcRow into dstRow
+        static void CopyShared(Archetype& src, uint32_t srcRow, Archetype& dst, uint32_t dstRow);
+    private:
+        uint8_t* RowAddress(uint32_t row, uint32_t typeID);
+    private:
+        ComponentMask m_Mask;
+        uint32_t m_ChunkCapacity = 0;
+        uint32_t m_Count = 0;
+
+        uint32_t m_ColumnOffsets[MaxComponentTypes] = {};
+        uint32_t m_ColumnSizes[MaxComponentTypes] = {};
+        uint32_t m_ChunkBytes = 0;
+
+        std::vector<std::unique_ptr<uint8_t[]>> m_Chunks;
+    };
+
+}
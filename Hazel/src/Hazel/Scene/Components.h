@@ -0,0 +1,61 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Hazel {
+
+    // Components live in archetype chunks and are moved with memcpy, so they must stay
+    // trivially copyable: reference GPU resources through Scene handles, not Ref<>s.
+
+    struct TransformComponent
+    {
+        glm::vec3 Translation = { 0.0f, 0.0f, 0.0f };
+        glm::vec3 Rotation = { 0.0f, 0.0f, 0.0f }; // Euler angles, radians
+        glm::vec3 Scale = { 1.0f, 1.0f, 1.0f };
+
+        glm::mat4 World = glm::mat4(1.0f);         // Written by Scene::OnUpdate
+
+        glm::mat4 GetLocalTransform() const
+        {
+            glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), Rotation.x, { 1.0f, 0.0f, 0.0f })
+                * glm::rotate(glm::mat4(1.0f), Rotation.y, { 0.0f, 1.0f, 0.0f })
+                * glm::rotate(glm::mat4(1.0f), Rotation.z, { 0.0f, 0.0f, 1.0f });
+
+            return glm::translate(glm::mat4(1.0f), Translation) * rotation * glm::scale(glm::mat4(1.0f), Scale);
+        }
+    };
+
+    // Present on entities that take part in the transform hierarchy; managed by Scene::SetParent
+    struct HierarchyComponent
+    {
+        uint32_t Node = UINT32_MAX; // TransformHierarchy::NodeID
+    };
+
+    using MeshHandle = uint32_t;
+    using ShaderHandle = uint32_t;
+
+    struct MeshRendererComponent
+    {
+        MeshHandle Mesh = 0;     // Scene::RegisterMesh
+        ShaderHandle Shader = 0; // Scene::RegisterShader
+    };
+
+    struct BoundsComponent
+    {
+        glm::vec3 LocalMin = { -0.5f, -0.5f, -0.5f };
+        glm::vec3 LocalMax = { 0.5f, 0.5f, 0.5f };
+
+        glm::vec3 WorldMin = { 0.0f, 0.0f, 0.0f }; // Written by Scene::OnUpdate
+        glm::vec3 WorldMax = { 0.0f, 0.0f, 0.0f };
+    };
+
+    struct ClipStateComponent
+    {
+        glm::vec4 Plane = { 1.0f, 0.0f, 0.0f, 0.0f }; // Ax + By + Cz + D = 0
+        bool Enabled = true;
+        bool ShowCrossSection = true;
+        glm::vec3 CrossSectionColor = { 1.0f, 0.8f, 0.2f };
+    };
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Hazel/Scene/Scene.h"
+
+namespace Hazel {
+
+    // Convenience wrapper pairing a handle with its scene. Chunks store only the handle.
+    class Entity
+    {
+    public:
+        Entity() = default;
+        Entity(EntityHandle handle, Scene* scene)
+            : m_Handle(handle), m_Scene(scene) {}
+
+        template<typename T, typename... Args>
+        T& AddComponent(Args&&... args) { return m_Scene->AddComponent<T>(m_Handle, std::forward<Args>(args)...); }
+
+        template<typename T>
+        void RemoveComponent() { m_Scene->RemoveComponent<T>(m_Handle); }
+
+        template<typename T>
+        T& GetComponent() { return m_Scene->GetComponent<T>(m_Handle); }
+
+        template<typename T>
+        bool HasComponent() const { return m_Scene->HasComponent<T>(m_Handle); }
+
+        void SetParent(EntityHandle parent) { m_Scene->SetParent(m_Handle, parent); }
+        void MarkTransformDirty() { m_Scene->MarkTransformDirty(m_Handle); }
+
+        EntityHandle GetHandle() const { return m_Handle; }
+        operator EntityHandle() const { return m_Handle; }
+        operator bool() const { return m_Scene && m_Scene->IsValid(m_Handle); }
+    private:
+        EntityHandle m_Handle;
+        Scene* m_Scene = nullptr;
+    };
+
+}
@@ -0,0 +1,238 @@
+#include "hzpch.h"
+#include "Hazel/Scene/Scene.h"
+#include "Hazel/Scene/Entity.h"
+
+#include "Hazel/Core/JobSystem.h"
+
+#include "Hazel/Renderer/Renderer.h"
+
+namespace Hazel {
+
+    Scene::Scene()
+    {
+        GetOrCreateArchetype(0);
+    }
+
+    Scene::~Scene()
+    {
+    }
+
+    Entity Scene::CreateEntity()
+    {
+        uint32_t index;
+        if (!m_FreeIndices.empty())
+        {
+            index = m_FreeIndices.back();
+            m_FreeIndices.pop_back();
+        }
+        else
+        {
+            index = (uint32_t)m_Records.size();
+            m_Records.emplace_back();
+        }
+
+        EntityHandle handle = { index, m_Records[index].Generation };
+        Archetype* empty = GetOrCreateArchetype(0);
+        m_Records[index].Arch = empty;
+        m_Records[index].Row = empty->Allocate(handle);
+        m_EntityCount++;
+
+        return { handle, this };
+    }
+
+    void Scene::DestroyEntity(EntityHandle entity)
+    {
+        HZ_CORE_ASSERT(IsValid(entity), "Invalid entity!");
+
+        // Children of a destroyed node are reattached to its parent
+        if (HasComponent<HierarchyComponent>(entity))
+            m_Hierarchy.DestroyNode(GetComponent<HierarchyComponent>(entity).Node);
+
+        EntityRecord& record = m_Records[entity.Index];
+        EntityHandle moved = record.Arch->RemoveSwap(record.Row);
+        if (!moved.IsNull())
+            m_Records[moved.Index].Row = record.Row;
+
+        record.Arch = nullptr;
+        record.Generation++;
+        m_FreeIndices.push_back(entity.Index);
+        m_EntityCount--;
+    }
+
+    bool Scene::IsValid(EntityHandle entity) const
+    {
+        return entity.Index < m_Records.size()
+            && m_Records[entity.Index].Arch
+            && m_Records[entity.Index].Generation == entity.Generation;
+    }
+
+    Archetype* Scene::GetOrCreateArchetype(ComponentMask mask)
+    {
+        auto it = m_Archetypes.find(mask);
+        if (it != m_Archetypes.end())
+            return it->second.get();
+
+        Archetype* archetype = new Archetype(mask);
+        m_Archetypes[mask] = Scope<Archetype>(archetype);
+        m_ArchetypeList.push_back(archetype);
+        return archetype;
+    }
+
+    uint32_t Scene::MoveToArchetype(EntityHandle entity, ComponentMask mask)
+    {
+        EntityRecord& record = m_Records[entity.Index];
+        Archetype* src = record.Arch;
+        Archetype* dst = GetOrCreateArchetype(mask);
+
+        uint32_t row = dst->Allocate(entity);
+        Archetype::CopyShared(*src, record.Row, *dst, row);
+
+        EntityHandle moved = src->RemoveSwap(record.Row);
+        if (!moved.IsNull())
+            m_Records[moved.Index].Row = record.Row;
+
+        record.Arch = dst;
+        record.Row = row;
+        return row;
+    }
+
+    TransformHierarchy::NodeID Scene::GetOrCreateNode(EntityHandle entity)
+    {
+        if (HasComponent<HierarchyComponent>(entity))
+            return GetComponent<HierarchyComponent>(entity).Node;
+
+        HZ_CORE_ASSERT(HasComponent<TransformComponent>(entity), "Entity needs a TransformComponent to join the hierarchy!");
+        TransformHierarchy::NodeID node = m_Hierarchy.CreateNode(TransformHierarchy::NullNode, GetComponent<TransformComponent>(entity).GetLocalTransform());
+        AddComponent<HierarchyComponent>(entity).Node = node;
+
+        if (node >= m_NodeEntities.size())
+            m_NodeEntities.resize(node + 1);
+        m_NodeEntities[node] = entity;
+        return node;
+    }
+
+    void Scene::SetParent(EntityHandle child, EntityHandle parent)
+    {
+        TransformHierarchy::NodeID childNode = GetOrCreateNode(child);
+        TransformHierarchy::NodeID parentNode = parent.IsNull() ? TransformHierarchy::NullNode : GetOrCreateNode(parent);
+        m_Hierarchy.SetParent(childNode, parentNode);
+    }
+
+    void Scene::MarkTransformDirty(EntityHandle entity)
+    {
+        if (HasComponent<HierarchyComponent>(entity))
+            m_Hierarchy.SetLocalTransform(GetComponent<HierarchyComponent>(entity).Node, GetComponent<TransformComponent>(entity).GetLocalTransform());
+    }
+
+    MeshHandle Scene::RegisterMesh(const Ref<VertexArray>& vertexArray)
+    {
+        m_Meshes.push_back(vertexArray);
+        return (MeshHandle)m_Meshes.size() - 1;
+    }
+
+    ShaderHandle Scene::RegisterShader(const Ref<Shader>& shader)
+    {
+        m_Shaders.push_back(shader);
+        return (ShaderHandle)m_Shaders.size() - 1;
+    }
+
+    void Scene::OnUpdate(Timestep ts)
+    {
+        // One job per chunk: chunks never share rows
+        auto transformChunks = Query<TransformComponent>(ComponentRegistry::GetMask<HierarchyComponent>());
+        JobSystem::ParallelFor((uint32_t)transformChunks.size(), 1, [&transformChunks](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t c = begin; c < end; c++)
+            {
+                TransformComponent* transforms = transformChunks[c].Get<TransformComponent>();
+                for (uint32_t i = 0; i < transformChunks[c].Count; i++)
+                    transforms[i].World = transforms[i].GetLocalTransform();
+            }
+        });
+
+        // Hierarchy entities: only dirty subtrees are recomputed and copied back
+        m_Hierarchy.Update();
+        for (const TransformHierarchy::Range& range : m_Hierarchy.GetUpdatedRanges())
+        {
+            for (uint32_t i = range.Begin; i < range.End; i++)
+            {
+                TransformHierarchy::NodeID node = m_Hierarchy.GetNodeAt(i);
+                GetComponent<TransformComponent>(m_NodeEntities[node]).World = m_Hierarchy.GetWorldTransform(node);
+            }
+        }
+
+        auto boundsChunks = Query<TransformComponent, BoundsComponent>();
+        JobSystem::ParallelFor((uint32_t)boundsChunks.size(), 1, [&boundsChunks](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t c = begin; c < end; c++)
+            {
+                TransformComponent* transforms = boundsChunks[c].Get<TransformComponent>();
+                BoundsComponent* bounds = boundsChunks[c].Get<BoundsComponent>();
+                for (uint32_t i = 0; i < boundsChunks[c].Count; i++)
+                {
+                    // Arvo's method: transform the center, project the extents with |M|
+                    const glm::mat4& m = transforms[i].World;
+                    glm::vec3 center = (bounds[i].LocalMin + bounds[i].LocalMax) * 0.5f;
+                    glm::vec3 extent = (bounds[i].LocalMax - bounds[i].LocalMin) * 0.5f;
+
+                    glm::vec3 worldCenter = glm::vec3(m * glm::vec4(center, 1.0f));
+                    glm::vec3 worldExtent;
+                    for (int axis = 0; axis < 3; axis++)
+                    {
+                        worldExtent[axis] = std::abs(m[0][axis]) * extent.x
+                            + std::abs(m[1][axis]) * extent.y
+                            + std::abs(m[2][axis]) * extent.z;
+                    }
+
+                    bounds[i].WorldMin = worldCenter - worldExtent;
+                    bounds[i].WorldMax = worldCenter + worldExtent;
+                }
+            }
+        });
+    }
+
+    void Scene::OnRender()
+    {
+        uint32_t transformID = ComponentRegistry::GetTypeID<TransformComponent>();
+        uint32_t meshRendererID = ComponentRegistry::GetTypeID<MeshRendererComponent>();
+        uint32_t clipStateID = ComponentRegistry::GetTypeID<ClipStateComponent>();
+
+        for (Archetype* archetype : m_ArchetypeList)
+        {
+            if (!archetype->Has(transformID) || !archetype->Has(meshRendererID))
+                continue;
+
+            bool hasClipState = archetype->Has(clipStateID);
+            for (uint32_t c = 0; c < archetype->GetChunkCount(); c++)
+            {
+                uint32_t count = archetype->GetChunkSize(c);
+                auto* transforms = static_cast<TransformComponent*>(archetype->GetColumn(c, transformID));
+                auto* meshRenderers = static_cast<MeshRendererComponent*>(archetype->GetColumn(c, meshRendererID));
+                auto* clipStates = hasClipState ? static_cast<ClipStateComponent*>(archetype->GetColumn(c, clipStateID)) : nullptr;
+
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    const Ref<Shader>& shader = m_Shaders[meshRenderers[i].Shader];
+                    const glm::mat4& world = transforms[i].World;
+                    if (!clipStates)
+                    {
+                        Renderer::Submit(shader, m_Meshes[meshRenderers[i].Mesh], world);
+                        continue;
+                    }
+
+                    // Set after Submit's bind, so the shader is bound once per draw
+                    const ClipStateComponent& clip = clipStates[i];
+                    Renderer::Submit(shader, m_Meshes[meshRenderers[i].Mesh], world, [&world, &clip](Shader& s)
+                    {
+                        s.SetMat4("u_Model", world);
+                        s.SetFloat4("u_ClipPlane", clip.Plane);
+                        s.SetInt("u_EnableClipping", clip.Enabled ? 1 : 0);
+                        s.SetInt("u_ShowCrossSection", clip.ShowCrossSection ? 1 : 0);
+                        s.SetFloat3("u_CrossSectionColor", clip.CrossSectionColor);
+                    });
+                }
+            }
+        }
+    }
+
+}
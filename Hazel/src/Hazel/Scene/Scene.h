@@ -0,0 +1,161 @@
+#pragma once
+
+#include "Hazel/Core/Base.h"
+#include "Hazel/Core/Timestep.h"
+#include "Hazel/Scene/Archetype.h"
+#include "Hazel/Scene/Components.h"
+#include "Hazel/Scene/TransformHierarchy.h"
+
+#include "Hazel/Renderer/Shader.h"
+#include "Hazel/Renderer/VertexArray.h"
+
+#include <tuple>
+#include <unordered_map>
+
+namespace Hazel {
+
+    class Entity;
+
+    // A contiguous run of entities from one archetype chunk, with one array per requested component
+    template<typename... Ts>
+    struct SceneChunk
+    {
+        uint32_t Count = 0;
+        const EntityHandle* Entities = nullptr;
+        std::tuple<Ts*...> Columns;
+
+        template<typename T>
+        T* Get() const { return std::get<T*>(Columns); }
+    };
+
+    class Scene
+    {
+    public:
+        Scene();
+        ~Scene();
+
+        Entity CreateEntity();
+        void DestroyEntity(EntityHandle entity);
+        bool IsValid(EntityHandle entity) const;
+
+        uint32_t GetEntityCount() const { return m_EntityCount; }
+
+        template<typename T, typename... Args>
+        T& AddComponent(EntityHandle entity, Args&&... args)
+        {
+            uint32_t typeID = ComponentRegistry::GetTypeID<T>();
+            HZ_CORE_ASSERT(!HasComponent<T>(entity), "Entity already has component!");
+
+            uint32_t row = MoveToArchetype(entity, m_Records[entity.Index].Arch->GetMask() | (1u << typeID));
+            return *new (m_Records[entity.Index].Arch->GetComponent(row, typeID)) T(std::forward<Args>(args)...);
+        }
+
+        template<typename T>
+        void RemoveComponent(EntityHandle entity)
+        {
+            uint32_t typeID = ComponentRegistry::GetTypeID<T>();
+            HZ_CORE_ASSERT(HasComponent<T>(entity), "Entity does not have component!");
+
+            MoveToArchetype(entity, m_Records[entity.Index].Arch->GetMask() & ~(1u << typeID));
+        }
+
+        template<typename T>
+        T& GetComponent(EntityHandle entity)
+        {
+            HZ_CORE_ASSERT(HasComponent<T>(entity), "Entity does not have component!");
+            const EntityRecord& record = m_Records[entity.Index];
+            return *static_cast<T*>(record.Arch->GetComponent(record.Row, ComponentRegistry::GetTypeID<T>()));
+        }
+
+        template<typename T>
+        bool HasComponent(EntityHandle entity) const
+        {
+            HZ_CORE_ASSERT(IsValid(entity), "Invalid entity!");
+            return m_Records[entity.Index].Arch->Has(ComponentRegistry::GetTypeID<T>());
+        }
+
+        // Chunks are independent, so systems may process the returned views in parallel.
+        // Archetypes containing any component in exclude are skipped.
+        template<typename... Ts>
+        std::vector<SceneChunk<Ts...>> Query(ComponentMask exclude = 0)
+        {
+            ComponentMask mask = ComponentRegistry::GetMask<Ts...>();
+
+            std::vector<SceneChunk<Ts...>> chunks;
+            for (Archetype* archetype : m_ArchetypeList)
+            {
+                if ((archetype->GetMask() & mask) != mask || (archetype->GetMask() & exclude))
+                    continue;
+
+                for (uint32_t c = 0; c < archetype->GetChunkCount(); c++)
+                {
+                    SceneChunk<Ts...> chunk;
+                    chunk.Count = archetype->GetChunkSize(c);
+                    if (chunk.Count == 0)
+                        continue;
+                    chunk.Entities = archetype->GetEntities(c);
+                    chunk.Columns = std::make_tuple(static_cast<Ts*>(archetype->GetColumn(c, ComponentRegistry::GetTypeID<Ts>()))...);
+                    chunks.push_back(chunk);
+                }
+            }
+            return chunks;
+        }
+
+        // fn(EntityHandle, Ts&...)
+        template<typename... Ts, typename Fn>
+        void ForEach(Fn&& fn)
+        {
+            for (auto& chunk : Query<Ts...>())
+            {
+                for (uint32_t i = 0; i < chunk.Count; i++)
+                    fn(chunk.Entities[i], chunk.template Get<Ts>()[i]...);
+            }
+        }
+
+        // Parents child under parent (a null handle detaches it). Both entities need a
+        // TransformComponent and join the transform hierarchy.
+        void SetParent(EntityHandle child, EntityHandle parent);
+
+        // Call after editing the TransformComponent of an entity in the hierarchy; entities
+        // outside it are recomputed every frame anyway
+        void MarkTransformDirty(EntityHandle entity);
+
+        TransformHierarchy& GetTransformHierarchy() { return m_Hierarchy; }
+
+        MeshHandle RegisterMesh(const Ref<VertexArray>& vertexArray);
+        ShaderHandle RegisterShader(const Ref<Shader>& shader);
+
+        // Recomputes world transforms and world-space bounds
+        void OnUpdate(Timestep ts);
+
+        // Submits every MeshRenderer; call between Renderer::BeginScene and EndScene
+        void OnRender();
+    private:
+        struct EntityRecord
+        {
+            Archetype* Arch = nullptr;
+            uint32_t Row = 0;
+            uint32_t Generation = 0;
+        };
+
+        Archetype* GetOrCreateArchetype(ComponentMask mask);
+        uint32_t MoveToArchetype(EntityHandle entity, ComponentMask mask);
+        TransformHierarchy::NodeID GetOrCreateNode(EntityHandle entity);
+    private:
+        std::unordered_map<ComponentMask, Scope<Archetype>> m_Archetypes;
+        std::vector<Archetype*> m_ArchetypeList;
+
+        std::vector<EntityRecord> m_Records;
+        std::vector<uint32_t> m_FreeIndices;
+        uint32_t m_EntityCount = 0;
+
+        TransformHierarchy m_Hierarchy;
+        std::vector<EntityHandle> m_NodeEntities;
+
+        std::vector<Ref<VertexArray>> m_Meshes;
+        std::vector<Ref<Shader>> m_Shaders;
+
+        friend class Entity;
+    };
+
+}
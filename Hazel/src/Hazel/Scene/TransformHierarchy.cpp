@@ -0,0 +1,314 @@
+#include "hzpch.h"
+#include "Hazel/Scene/TransformHierarchy.h"
+
+#include "Hazel/Core/JobSystem.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define HZ_TRANSFORM_SSE 1
+    #include <xmmintrin.h>
+#else
+    #define HZ_TRANSFORM_SSE 0
+#endif
+
+namespace Hazel {
+
+    // Subtrees smaller than this are recomputed as one batch instead of being split further
+    static const uint32_t s_BatchGrain = 1024;
+
+    static const uint32_t s_NullIndex = UINT32_MAX;
+
+    // out = a * b, column-major. out must not alias a or b.
+    static void MultiplyMat4(const glm::mat4& a, const glm::mat4& b, glm::mat4& out)
+    {
+#if HZ_TRANSFORM_SSE
+        const float* pa = &a[0][0];
+        const float* pb = &b[0][0];
+        float* po = &out[0][0];
+
+        __m128 a0 = _mm_loadu_ps(pa + 0);
+        __m128 a1 = _mm_loadu_ps(pa + 4);
+        __m128 a2 = _mm_loadu_ps(pa + 8);
+        __m128 a3 = _mm_loadu_ps(pa + 12);
+
+        for (int column = 0; column < 4; column++)
+        {
+            const float* bc = pb + column * 4;
+            __m128 r = _mm_mul_ps(a0, _mm_set1_ps(bc[0]));
+            r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(bc[1])));
+            r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(bc[2])));
+            r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(bc[3])));
+            _mm_storeu_ps(po + column * 4, r);
+        }
+#else
+        out = a * b;
+#endif
+    }
+
+    // inverse(transpose(mat3(m))) via cofactors: the columns of the cofactor matrix are
+    // cross products of the columns of m
+    static glm::mat3 ComputeNormalMatrix(const glm::mat4& m)
+    {
+        glm::vec3 c0 = glm::vec3(m[0]);
+        glm::vec3 c1 = glm::vec3(m[1]);
+        glm::vec3 c2 = glm::vec3(m[2]);
+
+        glm::vec3 r0 = glm::cross(c1, c2);
+        glm::vec3 r1 = glm::cross(c2, c0);
+        glm::vec3 r2 = glm::cross(c0, c1);
+
+        float det = glm::dot(c0, r0);
+        float invDet = det != 0.0f ? 1.0f / det : 0.0f;
+        return glm::mat3(r0 * invDet, r1 * invDet, r2 * invDet);
+    }
+
+    TransformHierarchy::NodeID TransformHierarchy::CreateNode(NodeID parent, const glm::mat4& local)
+    {
+        HZ_CORE_ASSERT(parent == NullNode || IsValid(parent), "Invalid parent node!");
+
+        NodeID node;
+        if (!m_FreeNodes.empty())
+        {
+            node = m_FreeNodes.back();
+            m_FreeNodes.pop_back();
+        }
+        else
+        {
+            node = (NodeID)m_NodeToIndex.size();
+            m_NodeToIndex.push_back(s_NullIndex);
+            m_NodeDirty.push_back(0);
+        }
+
+        uint32_t parentIndex = parent == NullNode ? s_NullIndex : m_NodeToIndex[parent];
+        uint32_t position = parent == NullNode ? GetNodeCount() : m_SubtreeEnd[parentIndex];
+        InsertBlock(position, parentIndex, 1);
+
+        m_Parent[position] = parentIndex;
+        m_SubtreeEnd[position] = position + 1;
+        m_IndexToNode[position] = node;
+        m_Local[position] = local;
+        m_NodeToIndex[node] = position;
+
+        MarkDirty(node);
+        return node;
+    }
+
+    void TransformHierarchy::DestroyNode(NodeID node)
+    {
+        HZ_CORE_ASSERT(IsValid(node), "Invalid node!");
+
+        uint32_t index = m_NodeToIndex[node];
+        uint32_t parentIndex = m_Parent[index];
+        for (uint32_t child = index + 1; child < m_SubtreeEnd[index]; child = m_SubtreeEnd[child])
+        {
+            m_Parent[child] = parentIndex;
+            MarkDirty(m_IndexToNode[child]);
+        }
+
+        EraseBlock(index, 1);
+
+        m_NodeToIndex[node] = s_NullIndex;
+        m_NodeDirty[node] = 0;
+        m_FreeNodes.push_back(node);
+    }
+
+    void TransformHierarchy::SetParent(NodeID node, NodeID newParent)
+    {
+        HZ_CORE_ASSERT(IsValid(node), "Invalid node!");
+        HZ_CORE_ASSERT(newParent == NullNode || IsValid(newParent), "Invalid parent node!");
+
+        uint32_t index = m_NodeToIndex[node];
+        uint32_t count = m_SubtreeEnd[index] - index;
+        if (newParent != NullNode)
+        {
+            uint32_t parentIndex = m_NodeToIndex[newParent];
+            HZ_CORE_ASSERT(parentIndex < index || parentIndex >= index + count, "Cannot parent a node to its own descendant!");
+            if (m_Parent[index] == parentIndex)
+                return;
+        }
+
+        // Lift the subtree out with indices relative to its root, then splice it back in
+        // at the end of the new parent's subtree
+        std::vector<uint32_t> parents(count), subtreeEnds(count);
+        std::vector<NodeID> nodes(m_IndexToNode.begin() + index, m_IndexToNode.begin() + index + count);
+        std::vector<glm::mat4> locals(m_Local.begin() + index, m_Local.begin() + index + count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            parents[i] = i == 0 ? s_NullIndex : m_Parent[index + i] - index;
+            subtreeEnds[i] = m_SubtreeEnd[index + i] - index;
+        }
+
+        EraseBlock(index, count);
+
+        uint32_t parentIndex = newParent == NullNode ? s_NullIndex : m_NodeToIndex[newParent];
+        uint32_t position = newParent == NullNode ? GetNodeCount() : m_SubtreeEnd[parentIndex];
+        InsertBlock(position, parentIndex, count);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            m_Parent[position + i] = i == 0 ? parentIndex : parents[i] + position;
+            m_SubtreeEnd[position + i] = subtreeEnds[i] + position;
+            m_IndexToNode[position + i] = nodes[i];
+            m_Local[position + i] = locals[i];
+            m_NodeToIndex[nodes[i]] = position + i;
+        }
+
+        MarkDirty(node);
+    }
+
+    TransformHierarchy::NodeID TransformHierarchy::GetParent(NodeID node) const
+    {
+        uint32_t parentIndex = m_Parent[m_NodeToIndex[node]];
+        return parentIndex == s_NullIndex ? NullNode : m_IndexToNode[parentIndex];
+    }
+
+    void TransformHierarchy::SetLocalTransform(NodeID node, const glm::mat4& local)
+    {
+        HZ_CORE_ASSERT(IsValid(node), "Invalid node!");
+        m_Local[m_NodeToIndex[node]] = local;
+        MarkDirty(node);
+    }
+
+    void TransformHierarchy::MarkDirty(NodeID node)
+    {
+        if (m_NodeDirty[node])
+            return;
+
+        m_NodeDirty[node] = 1;
+        m_DirtyNodes.push_back(node);
+    }
+
+    // Structural edits shift the arrays, so they cost O(n); transform edits never do
+    void TransformHierarchy::InsertBlock(uint32_t position, uint32_t parentIndex, uint32_t count)
+    {
+        m_Parent.insert(m_Parent.begin() + position, count, s_NullIndex);
+        m_SubtreeEnd.insert(m_SubtreeEnd.begin() + position, count, 0);
+        m_IndexToNode.insert(m_IndexToNode.begin() + position, count, NullNode);
+        m_Local.insert(m_Local.begin() + position, count, glm::mat4(1.0f));
+        m_World.insert(m_World.begin() + position, count, glm::mat4(1.0f));
+        m_Normal.insert(m_Normal.begin() + position, count, glm::mat3(1.0f));
+
+        for (uint32_t i = position + count; i < GetNodeCount(); i++)
+        {
+            m_NodeToIndex[m_IndexToNode[i]] = i;
+            m_SubtreeEnd[i] += count;
+            if (m_Parent[i] != s_NullIndex && m_Parent[i] >= position)
+                m_Parent[i] += count;
+        }
+
+        for (uint32_t ancestor = parentIndex; ancestor != s_NullIndex; ancestor = m_Parent[ancestor])
+            m_SubtreeEnd[ancestor] += count;
+    }
+
+    void TransformHierarchy::EraseBlock(uint32_t position, uint32_t count)
+    {
+        for (uint32_t ancestor = m_Parent[position]; ancestor != s_NullIndex; ancestor = m_Parent[ancestor])
+            m_SubtreeEnd[ancestor] -= count;
+
+        m_Parent.erase(m_Parent.begin() + position, m_Parent.begin() + position + count);
+        m_SubtreeEnd.erase(m_SubtreeEnd.begin() + position, m_SubtreeEnd.begin() + position + count);
+        m_IndexToNode.erase(m_IndexToNode.begin() + position, m_IndexToNode.begin() + position + count);
+        m_Local.erase(m_Local.begin() + position, m_Local.begin() + position + count);
+        m_World.erase(m_World.begin() + position, m_World.begin() + position + count);
+        m_Normal.erase(m_Normal.begin() + position, m_Normal.begin() + position + count);
+
+        for (uint32_t i = position; i < GetNodeCount(); i++)
+        {
+            m_NodeToIndex[m_IndexToNode[i]] = i;
+            m_SubtreeEnd[i] -= count;
+            if (m_Parent[i] != s_NullIndex && m_Parent[i] >= position + count)
+                m_Parent[i] -= count;
+        }
+    }
+
+    void TransformHierarchy::Update()
+    {
+        m_UpdatedRanges.clear();
+        if (m_DirtyNodes.empty())
+            return;
+
+        m_DirtyIndices.clear();
+        for (NodeID node : m_DirtyNodes)
+        {
+            if (!IsValid(node))
+                continue;
+
+            m_NodeDirty[node] = 0;
+            m_DirtyIndices.push_back(m_NodeToIndex[node]);
+        }
+        m_DirtyNodes.clear();
+
+        // Sorted dirty roots: anything inside an earlier root's subtree is already covered
+        std::sort(m_DirtyIndices.begin(), m_DirtyIndices.end());
+        uint32_t coveredEnd = 0;
+        for (uint32_t index : m_DirtyIndices)
+        {
+            if (index < coveredEnd)
+                continue;
+
+            m_UpdatedRanges.push_back({ index, m_SubtreeEnd[index] });
+            coveredEnd = m_SubtreeEnd[index];
+        }
+
+        m_Batches.clear();
+        for (const Range& range : m_UpdatedRanges)
+            SplitRange(range.Begin, range.End);
+
+        // Batches only read world matrices outside themselves that are already final,
+        // so they are independent of each other
+        JobSystem::ParallelFor((uint32_t)m_Batches.size(), 1, [this](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; i++)
+                ProcessRange(m_Batches[i].Begin, m_Batches[i].End);
+        });
+    }
+
+    // Breaks a large subtree into independent batches: the root is computed immediately,
+    // then runs of sibling subtrees are grouped up to the grain size
+    void TransformHierarchy::SplitRange(uint32_t begin, uint32_t end)
+    {
+        if (end - begin <= s_BatchGrain)
+        {
+            m_Batches.push_back({ begin, end });
+            return;
+        }
+
+        ProcessRange(begin, begin + 1);
+
+        uint32_t batchBegin = begin + 1;
+        for (uint32_t child = begin + 1; child < end; child = m_SubtreeEnd[child])
+        {
+            uint32_t childEnd = m_SubtreeEnd[child];
+            if (childEnd - child > s_BatchGrain)
+            {
+                if (batchBegin < child)
+                    m_Batches.push_back({ batchBegin, child });
+                SplitRange(child, childEnd);
+                batchBegin = childEnd;
+            }
+            else if (childEnd - batchBegin > s_BatchGrain)
+            {
+                if (batchBegin < child)
+                    m_Batches.push_back({ batchBegin, child });
+                batchBegin = child;
+            }
+        }
+
+        if (batchBegin < end)
+            m_Batches.push_back({ batchBegin, end });
+    }
+
+    void TransformHierarchy::ProcessRange(uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            uint32_t parent = m_Parent[i];
+            if (parent == s_NullIndex)
+                m_World[i] = m_Local[i];
+            else
+                MultiplyMat4(m_World[parent], m_Local[i], m_World[i]);
+
+            m_Normal[i] = ComputeNormalMatrix(m_World[i]);
+        }
+    }
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Hazel {
+
+    // Parent/child transform tree for assemblies. Nodes are stored as SoA arrays in
+    // preorder (every parent before its children, every subtree contiguous), so a dirty
+    // node's subtree is a single index range [index, SubtreeEnd) that can be recomputed
+    // front to back without revisiting the rest of the tree.
+    class TransformHierarchy
+    {
+    public:
+        using NodeID = uint32_t;
+        static constexpr NodeID NullNode = UINT32_MAX;
+
+        struct Range
+        {
+            uint32_t Begin = 0;
+            uint32_t End = 0;
+        };
+    public:
+        // Appends the node as the last child of parent (or as a new root)
+        NodeID CreateNode(NodeID parent = NullNode, const glm::mat4& local = glm::mat4(1.0f));
+
+        // Removes a single node; its children are reattached to its parent
+        void DestroyNode(NodeID node);
+
+        // Moves node and its whole subtree under newParent (NullNode makes it a root)
+        void SetParent(NodeID node, NodeID newParent);
+        NodeID GetParent(NodeID node) const;
+
+        void SetLocalTransform(NodeID node, const glm::mat4& local);
+        const glm::mat4& GetLocalTransform(NodeID node) const { return m_Local[m_NodeToIndex[node]]; }
+
+        // Valid after Update()
+        const glm::mat4& GetWorldTransform(NodeID node) const { return m_World[m_NodeToIndex[node]]; }
+        const glm::mat3& GetNormalMatrix(NodeID node) const { return m_Normal[m_NodeToIndex[node]]; }
+
+        // Recomputes world and normal matrices for every dirty subtree
+        void Update();
+
+        // Index ranges rewritten by the last Update(); map back with GetNodeAt
+        const std::vector<Range>& GetUpdatedRanges() const { return m_UpdatedRanges; }
+        NodeID GetNodeAt(uint32_t index) const { return m_IndexToNode[index]; }
+
+        uint32_t GetNodeCount() const { return (uint32_t)m_IndexToNode.size(); }
+        bool IsValid(NodeID node) const { return node < m_NodeToIndex.size() && m_NodeToIndex[node] != UINT32_MAX; }
+    private:
+        void MarkDirty(NodeID node);
+        void InsertBlock(uint32_t position, uint32_t parentIndex, uint32_t count);
+        void EraseBlock(uint32_t position, uint32_t count);
+
+        void SplitRange(uint32_t begin, uint32_t end);
+        void ProcessRange(uint32_t begin, uint32_t end);
+    private:
+        // Indexed by preorder position
+        std::vector<uint32_t> m_Parent;      // Parent index, or UINT32_MAX for roots
+        std::vector<uint32_t> m_SubtreeEnd;  // One past the last descendant
+        std::vector<NodeID> m_IndexToNode;
+        std::vector<glm::mat4> m_Local;
+        std::vector<glm::mat4> m_World;
+        std::vector<glm::mat3> m_Normal;
+
+        // Indexed by NodeID, stable across reordering
+        std::vector<uint32_t> m_NodeToIndex;
+        std::vector<uint8_t> m_NodeDirty;
+        std::vector<NodeID> m_FreeNodes;
+
+        std::vector<NodeID> m_DirtyNodes;
+        std::vector<uint32_t> m_DirtyIndices;
+        std::vector<Range> m_UpdatedRanges;
+        std::vector<Range> m_Batches;
+    };
+
+}
@@ -1,12 +1,16 @@
 #include <Hazel.h>
-#include <Hazel/Platform/OpenGL/OpenGLShader.h> // For UploadUniform
 #include <Hazel/Renderer/Framebuffer.h>
+#include <Hazel/Renderer/TiledCanvas.h>
+#include <Hazel/Renderer/CanvasHistory.h>
+#include <Hazel/Renderer/CanvasBrush.h>
 #include <imgui.h>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
-#include <glad/glad.h> // Native OpenGL calls
+
+#include <algorithm>
+#include <cstdlib>
 
 class ExampleLayer : public Hazel::Layer
 {
@@ -14,7 +18,7 @@ public:
     ExampleLayer()
         : Layer("Example"), m_Camera(-1.6f, 1.6f, -0.9f, 0.9f), m_CameraPosition(0.0f)
     {
-        m_VertexArray.reset(Hazel::VertexArray::Create());
+        m_VertexArray = Hazel::VertexArray::Create();
 
         float vertices[3 * 7] = {
             -0.5f, -0.5f, 0.0f, 0.8f, 0.2f, 0.8f, 1.0f,
@@ -23,7 +27,7 @@ public:
         };
 
         Hazel::Ref<Hazel::VertexBuffer> vertexBuffer;
-        vertexBuffer.reset(Hazel::VertexBuffer::Create(vertices, sizeof(vertices)));
+        vertexBuffer = Hazel::VertexBuffer::Create(vertices, sizeof(vertices));
         Hazel::BufferLayout layout = {
             { Hazel::ShaderDataType::Float3, "a_Position" },
             { Hazel::ShaderDataType::Float4, "a_Color" }
@@ -33,10 +37,10 @@ public:
 
         uint32_t indices[3] = { 0, 1, 2 };
         Hazel::Ref<Hazel::IndexBuffer> indexBuffer;
-        indexBuffer.reset(Hazel::IndexBuffer::Create(indices, sizeof(indices) / sizeof(uint32_t)));
+        indexBuffer = Hazel::IndexBuffer::Create(indices, sizeof(indices) / sizeof(uint32_t));
         m_VertexArray->SetIndexBuffer(indexBuffer);
 
-        m_SquareVA.reset(Hazel::VertexArray::Create());
+        m_SquareVA = Hazel::VertexArray::Create();
 
         float squareVertices[5 * 4] = {
             -0.5f, -0.5f, 0.0f,  0.0f, 0.0f,
@@ -46,7 +50,7 @@ public:
         };
 
         Hazel::Ref<Hazel::VertexBuffer> squareVB;
-        squareVB.reset(Hazel::VertexBuffer::Create(squareVertices, sizeof(squareVertices)));
+        squareVB = Hazel::VertexBuffer::Create(squareVertices, sizeof(squareVertices));
         squareVB->SetLayout({
             { Hazel::ShaderDataType::Float3, "a_Position" }, 
             { Hazel::ShaderDataType::Float2, "a_TexCoord" }
@@ -55,7 +59,7 @@ public:
 
         uint32_t squareIndices[6] = { 0, 1, 2, 2, 3, 0 };
         Hazel::Ref<Hazel::IndexBuffer> squareIB;
-        squareIB.reset(Hazel::IndexBuffer::Create(squareIndices, sizeof(squareIndices) / sizeof(uint32_t)));
+        squareIB = Hazel::IndexBuffer::Create(squareIndices, sizeof(squareIndices) / sizeof(uint32_t));
         m_SquareVA->SetIndexBuffer(squareIB);
 
         std::string vertexSrc = R"(
@@ -133,8 +137,23 @@ public:
         m_Texture = Hazel::Texture2D::Create("checkerBoard.png");
         m_ChernoLogoTexture = Hazel::Texture2D::Create("ChernoLogo.png");
 
-        std::dynamic_pointer_cast<Hazel::OpenGLShader>(textureShader)->Bind();
-        std::dynamic_pointer_cast<Hazel::OpenGLShader>(textureShader)->UploadUniformInt("u_Texture", 0);
+        textureShader->Bind();
+        textureShader->SetInt("u_Texture", 0);
+
+        // 方块网格交给 Scene 管理
+        Hazel::MeshHandle squareMesh = m_Scene.RegisterMesh(m_SquareVA);
+        Hazel::ShaderHandle flatColorShader = m_Scene.RegisterShader(m_FlatColorShader);
+        for (int y = 0; y < 20; y++)
+        {
+            for (int x = 0; x < 20; x++)
+            {
+                Hazel::Entity square = m_Scene.CreateEntity();
+                auto& transform = square.AddComponent<Hazel::TransformComponent>();
+                transform.Translation = { x * 0.11f, y * 0.11f, 0.0f };
+                transform.Scale = glm::vec3(0.1f);
+                square.AddComponent<Hazel::MeshRendererComponent>(Hazel::MeshRendererComponent{ squareMesh, flatColorShader });
+            }
+        }
     }
 
     void OnUpdate(Hazel::Timestep ts) override
@@ -154,28 +173,26 @@ public:
         if (Hazel::Input::IsKeyPressed(HZ_KEY_D))
             m_CameraRotation -= m_CameraRotationSpeed * ts;
 
+        // 按住期间持续移动, 按需渲染模式下需要主动请求下一帧
+        if (Hazel::Input::IsKeyPressed(HZ_KEY_LEFT) || Hazel::Input::IsKeyPressed(HZ_KEY_RIGHT)
+            || Hazel::Input::IsKeyPressed(HZ_KEY_UP) || Hazel::Input::IsKeyPressed(HZ_KEY_DOWN)
+            || Hazel::Input::IsKeyPressed(HZ_KEY_A) || Hazel::Input::IsKeyPressed(HZ_KEY_D))
+            Hazel::Application::Get().RequestRedraw();
+
         Hazel::RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
         Hazel::RenderCommand::Clear();
 
         m_Camera.SetPosition(m_CameraPosition);
         m_Camera.SetRotation(m_CameraRotation);
 
-        Hazel::Renderer::BeginScene(m_Camera);
+        m_Scene.OnUpdate(ts);
 
-        glm::mat4 scale = glm::scale(glm::mat4(1.0f), glm::vec3(0.1f));
+        Hazel::Renderer::BeginScene(m_Camera);
 
-        std::dynamic_pointer_cast<Hazel::OpenGLShader>(m_FlatColorShader)->Bind();
-        std::dynamic_pointer_cast<Hazel::OpenGLShader>(m_FlatColorShader)->UploadUniformFloat3("u_Color", m_SquareColor);
+        m_FlatColorShader->Bind();
+        m_FlatColorShader->SetFloat3("u_Color", m_SquareColor);
 
-        for (int y = 0; y < 20; y++)
-        {
-            for (int x = 0; x < 20; x++)
-            {
-                glm::vec3 pos(x * 0.11f, y * 0.11f, 0.0f);
-                glm::mat4 transform = glm::translate(glm::mat4(1.0f), pos) * scale;
-                Hazel::Renderer::Submit(m_FlatColorShader, m_SquareVA, transform);
-            }
-        }
+        m_Scene.OnRender();
 
         auto textureShader = m_ShaderLibrary.Get("Texture");
 
@@ -213,6 +230,8 @@ private:
     Hazel::Ref<Hazel::Texture2D> m_Texture;
     Hazel::Ref<Hazel::Texture2D> m_ChernoLogoTexture;
 
+    Hazel::Scene m_Scene;
+
     Hazel::OrthographicCamera m_Camera;
     glm::vec3 m_CameraPosition;
     float m_CameraMoveSpeed = 5.0f;
@@ -226,173 +245,91 @@ private:
 class BrushLayer : public Hazel::Layer
 {
 public:
-    BrushLayer() : Layer("Brush") {}
+    BrushLayer() : Layer("Brush")
+    {
+        // 笔刷只关心最新的光标位置和窗口尺寸, 高回报率鼠标的中间采样合并掉
+        SetCoalescedEvents(Hazel::EventTypeBit(Hazel::EventType::MouseMoved) | Hazel::EventTypeBit(Hazel::EventType::WindowResize));
+    }
 
     virtual void OnAttach() override
     {
-        // 1. 初始化 Framebuffer (画布)
-        uint32_t width = Hazel::Application::Get().GetWindow().GetWidth();
-        uint32_t height = Hazel::Application::Get().GetWindow().GetHeight();
-
-        Hazel::FramebufferSpecification fbSpec;
-        fbSpec.Width = width;
-        fbSpec.Height = height;
-        fbSpec.Attachments = { Hazel::FramebufferTextureFormat::RGBA8 };
-        m_Framebuffer = Hazel::Framebuffer::Create(fbSpec);
-
-        // 初始化画布为白色
-        m_Framebuffer->Bind();
-        Hazel::RenderCommand::SetClearColor({ 1.0f, 1.0f, 1.0f, 1.0f });
-        Hazel::RenderCommand::Clear();
-        m_Framebuffer->Unbind();
-
-        // 2. 生成软笔刷纹理
-        CreateBrushTexture(128);
-
-        // 3. 创建几何体 (Quad)
-        // 笔刷 Quad (-0.5 ~ 0.5)
-        m_BrushVA.reset(Hazel::VertexArray::Create());
-        float brushVertices[] = {
-            -0.5f, -0.5f, 0.0f, 0.0f, 0.0f,
-             0.5f, -0.5f, 0.0f, 1.0f, 0.0f,
-             0.5f,  0.5f, 0.0f, 1.0f, 1.0f,
-            -0.5f,  0.5f, 0.0f, 0.0f, 1.0f
-        };
-        Hazel::Ref<Hazel::VertexBuffer> brushVB;
-        brushVB.reset(Hazel::VertexBuffer::Create(brushVertices, sizeof(brushVertices)));
-        brushVB->SetLayout({
-            { Hazel::ShaderDataType::Float3, "a_Position" },
-            { Hazel::ShaderDataType::Float2, "a_TexCoord" }
-        });
-        m_BrushVA->AddVertexBuffer(brushVB);
-        
-        uint32_t indices[] = { 0, 1, 2, 2, 3, 0 };
-        Hazel::Ref<Hazel::IndexBuffer> ib;
-        ib.reset(Hazel::IndexBuffer::Create(indices, 6));
-        m_BrushVA->SetIndexBuffer(ib);
-
-        // 屏幕 Quad (NDC -1 ~ 1)
-        m_ScreenVA.reset(Hazel::VertexArray::Create());
-        float screenVertices[] = {
-            -1.0f, -1.0f, 0.0f, 0.0f, 0.0f,
-             1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-             1.0f,  1.0f, 0.0f, 1.0f, 1.0f,
-            -1.0f,  1.0f, 0.0f, 0.0f, 1.0f
-        };
-        Hazel::Ref<Hazel::VertexBuffer> screenVB;
-        screenVB.reset(Hazel::VertexBuffer::Create(screenVertices, sizeof(screenVertices)));
-        screenVB->SetLayout({
-            { Hazel::ShaderDataType::Float3, "a_Position" },
-            { Hazel::ShaderDataType::Float2, "a_TexCoord" }
-        });
-        m_ScreenVA->AddVertexBuffer(screenVB);
-        m_ScreenVA->SetIndexBuffer(ib);
-
-        // 4. 创建 Shaders
-        std::string brushVs = R"(
-            #version 330 core
-            layout (location = 0) in vec3 aPos;
-            layout (location = 1) in vec2 aTexCoord;
-            out vec2 TexCoord;
-            uniform mat4 projection;
-            uniform vec2 offset;
-            uniform float size;
-            void main() {
-                vec2 pos = aPos.xy * size + offset;
-                gl_Position = projection * vec4(pos, 0.0, 1.0);
-                TexCoord = aTexCoord;
-            }
-        )";
-
-        std::string brushFs = R"(
-            #version 330 core
-            out vec4 FragColor;
-            in vec2 TexCoord;
-            uniform sampler2D brushTexture;
-            uniform vec3 color;
-            void main() {
-                float alpha = texture(brushTexture, TexCoord).a; // 使用 Alpha 通道
-                if(alpha < 0.01) discard;
-                FragColor = vec4(color, alpha); 
-            }
-        )";
-
-        m_BrushShader = Hazel::Shader::Create("Brush", brushVs, brushFs);
-
-        std::string screenVs = R"(
-            #version 330 core
-            layout (location = 0) in vec3 aPos;
-            layout (location = 1) in vec2 aTexCoord;
-            out vec2 TexCoord;
-            void main() {
-                gl_Position = vec4(aPos, 1.0); 
-                TexCoord = aTexCoord;
-            }
-        )";
-
-        std::string screenFs = R"(
-            #version 330 core
-            out vec4 FragColor;
-            in vec2 TexCoord;
-            uniform sampler2D screenTexture;
-            void main() {
-                FragColor = texture(screenTexture, TexCoord);
-            }
-        )";
-
-        m_ScreenShader = Hazel::Shader::Create("Screen", screenVs, screenFs);
+        // 1. 初始化分块画布: 不设宽高即为无限画布, 瓦片在第一次被画到时才分配, 空白区域不占显存;
+        //    显存里的瓦片超出预算后, 最久未用的压缩换出到内存, 需要时再换回
+        Hazel::TiledCanvasSpecification canvasSpec;
+        canvasSpec.ResidentMemoryBudget = 128ull << 20;
+        m_Canvas = std::make_unique<Hazel::TiledCanvas>(canvasSpec);
+        // 撤销历史: 每一笔只保存被它改到的瓦片 (写时复制), 旧快照超出显存预算后压缩到内存
+        m_History = std::make_unique<Hazel::CanvasHistory>(*m_Canvas);
+
+        // 笔刷: 每帧收集的线段按瓦片分桶, 以胶囊形状实例化绘制到画布
+        m_Brush = std::make_unique<Hazel::CanvasBrush>(*m_Canvas);
     }
 
     virtual void OnUpdate(Hazel::Timestep ts) override
     {
         // 1. 输入处理
-        if (Hazel::Input::IsMouseButtonPressed(0)) // Left Click
+        auto [x, y] = Hazel::Input::GetMousePosition();
+
+        // 中键拖动平移视图
+        if (Hazel::Input::IsMouseButtonPressed(2)) // Middle Click
         {
-            auto [x, y] = Hazel::Input::GetMousePosition();
-            
+            if (m_IsPanning)
+                m_Canvas->SetView(m_Canvas->GetViewOrigin() - glm::dvec2(x - m_PanLastX, y - m_PanLastY) / m_Canvas->GetViewZoom(), m_Canvas->GetViewZoom());
+            m_IsPanning = true;
+            m_PanLastX = x;
+            m_PanLastY = y;
+        }
+        else
+        {
+            m_IsPanning = false;
+        }
+
+        // 在 ImGui 面板上按下 (如撤销/重做按钮) 不算落笔, 否则会开始新的一步把重做记录清掉;
+        // 已经开始的笔画拖过面板时继续
+        bool leftDown = Hazel::Input::IsMouseButtonPressed(0) && (m_IsDrawing || !ImGui::GetIO().WantCaptureMouse);
+        if (leftDown) // Left Click
+        {
+            // 笔刷在画布坐标里插值, 与视图的平移缩放无关
+            glm::dvec2 position = m_Canvas->ViewToCanvas({ x, y });
+
             if (!m_IsDrawing)
             {
                 m_IsDrawing = true;
-                m_LastX = x;
-                m_LastY = y;
-                PaintStroke(x, y); // 点击的第一下
+                m_History->BeginStep();
+                m_LastPosition = position;
+                QueueSegment(position, position); // 点击的第一下
             }
             else
             {
-                // 插值绘制
-                double dx = x - m_LastX;
-                double dy = y - m_LastY;
-                double dist = std::sqrt(dx * dx + dy * dy);
-
-                if (dist >= m_BrushSpacing)
+                // 两帧之间窗口送来的每个光标采样都连成线段, 快速画弧时不会变成折线
+                for (const Hazel::CursorSample& sample : Hazel::Application::Get().GetInputHistory().GetCursorSamples())
                 {
-                    double dirX = dx / dist;
-                    double dirY = dy / dist;
-
-                    for (double step = 0; step <= dist; step += m_BrushSpacing)
-                    {
-                        PaintStroke(m_LastX + dirX * step, m_LastY + dirY * step);
-                    }
-                    m_LastX = x;
-                    m_LastY = y;
+                    glm::dvec2 samplePosition = m_Canvas->ViewToCanvas({ sample.X, sample.Y });
+                    if (samplePosition == m_LastPosition)
+                        continue;
+                    QueueSegment(m_LastPosition, samplePosition);
+                    m_LastPosition = samplePosition;
                 }
             }
         }
-        else
+        else if (m_IsDrawing)
         {
             m_IsDrawing = false;
+            m_History->EndStep();
         }
 
-        // 2. 渲染最终画面 (将 FBO 贴到屏幕)
-        Hazel::RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
-        Hazel::RenderCommand::Clear();
+        // 本帧收集的线段按瓦片实例化绘制到画布
+        m_Brush->Flush();
+        m_History->Update();
 
-        std::dynamic_pointer_cast<Hazel::OpenGLShader>(m_ScreenShader)->Bind();
-        // 绑定 FBO 的颜色附件 texture 到 slot 0
-        glBindTextureUnit(0, m_Framebuffer->GetColorAttachmentRendererID());
-        
-        m_ScreenVA->Bind();
-        Hazel::RenderCommand::DrawIndexed(m_ScreenVA);
+        // 2. 渲染最终画面: 只重新合成脏瓦片, 再整体贴到屏幕
+        auto& window = Hazel::Application::Get().GetWindow();
+        m_Canvas->Composite(window.GetWidth(), window.GetHeight());
+        m_Canvas->Present();
+
+        // 缩小视图时换出的瓦片每帧只解码一部分, 按需渲染模式下要继续请求帧直到画面补全
+        if (m_Canvas->GetStatistics().DeferredTiles > 0)
+            Hazel::Application::Get().RequestRedraw();
     }
 
     virtual void OnImGuiRender() override
@@ -400,86 +337,95 @@ public:
         ImGui::Begin("Brush Settings");
         ImGui::SliderFloat("Size", &m_BrushSize, 1.0f, 100.0f);
         ImGui::ColorEdit3("Color", glm::value_ptr(m_BrushColor));
-        ImGui::SliderFloat("Spacing", &m_BrushSpacing, 1.0f, 50.0f);
-        if (ImGui::Button("Clear Canvas"))
+        ImGui::SliderFloat("Spacing", &m_BrushSpacing, 1.0f, 50.0f); // 等效的盖章间距, 越大笔画越淡
+        if (ImGui::Button("Clear Canvas") && !m_IsDrawing)
         {
-            m_Framebuffer->Bind();
-            Hazel::RenderCommand::SetClearColor({ 1, 1, 1, 1 });
-            Hazel::RenderCommand::Clear();
-            m_Framebuffer->Unbind();
+            // 清空也作为一步, 可以撤销
+            m_History->BeginStep();
+            m_Canvas->Clear();
+            m_History->EndStep();
         }
+
+        ImGui::BeginDisabled(!m_History->CanUndo());
+        if (ImGui::Button("Undo (Ctrl+Z)"))
+            m_History->Undo();
+        ImGui::EndDisabled();
+        ImGui::SameLine();
+        ImGui::BeginDisabled(!m_History->CanRedo());
+        if (ImGui::Button("Redo (Ctrl+Y)"))
+            m_History->Redo();
+        ImGui::EndDisabled();
+
+        ImGui::Text("Zoom: %.0f%% (wheel to zoom, middle drag to pan)", m_Canvas->GetViewZoom() * 100.0);
+        if (ImGui::Button("Reset View"))
+            m_Canvas->SetView({ 0.0, 0.0 }, 1.0);
+
+        const auto& stats = m_Canvas->GetStatistics();
+        ImGui::Separator();
+        ImGui::Text("Tiles: %u", stats.Tiles);
+        ImGui::Text("Resident: %u (%.1f MB)", stats.ResidentTiles, stats.ResidentMemory / (1024.0 * 1024.0));
+        ImGui::Text("Evicted: %u (%.1f MB)", stats.EvictedTiles, stats.EvictedMemory / (1024.0 * 1024.0));
+        ImGui::Text("Composited: %u tiles, decoded: %u, deferred: %u", stats.CompositedTiles, stats.DecodedTiles, stats.DeferredTiles);
+        ImGui::Text("Last stroke: %zu tiles", m_Canvas->GetStrokeTiles().size());
+
+        const auto& history = m_History->GetStatistics();
+        ImGui::Text("History: %u undo / %u redo", history.UndoSteps, history.RedoSteps);
+        ImGui::Text("Snapshots: %u GPU (%.1f MB), %u compressed (%.1f MB), %u pending",
+            history.GpuSnapshots, history.GpuMemory / (1024.0 * 1024.0),
+            history.CompressedSnapshots, history.CompressedMemory / (1024.0 * 1024.0), history.PendingCompressions);
         ImGui::End();
     }
 
-    void OnEvent(Hazel::Event& event) override {}
-
-private:
-    void CreateBrushTexture(uint32_t size)
+    void OnEvent(Hazel::Event& event) override
     {
-        std::vector<unsigned char> data(size * size * 4);
-        float center = size / 2.0f;
-        float radius = size / 2.0f;
-
-        for (int y = 0; y < size; y++) {
-            for (int x = 0; x < size; x++) {
-                float dist = std::sqrt(std::pow(x - center, 2) + std::pow(y - center, 2));
-                float alpha = 0.0f;
-                if (dist < radius) {
-                    float t = dist / radius;
-                    alpha = 1.0f - t;
-                    alpha = alpha * alpha; 
-                }
-                
-                int index = (y * size + x) * 4;
-                data[index + 0] = 255; // R
-                data[index + 1] = 255; // G
-                data[index + 2] = 255; // B
-                data[index + 3] = (unsigned char)(alpha * 255); // A
-            }
-        }
-        
-        m_BrushTexture = Hazel::Texture2D::Create(size, size);
-        m_BrushTexture->SetData(data.data(), data.size() * sizeof(unsigned char));
+        Hazel::EventDispatcher dispatcher(event);
+        dispatcher.Dispatch<Hazel::MouseScrolledEvent>([this](Hazel::MouseScrolledEvent& e)
+        {
+            // 以光标为中心缩放: 缩放前后光标下是同一个画布点
+            auto [x, y] = Hazel::Input::GetMousePosition();
+            glm::dvec2 cursor(x, y);
+            glm::dvec2 anchor = m_Canvas->ViewToCanvas(cursor);
+            double zoom = std::clamp(m_Canvas->GetViewZoom() * std::pow(1.1, (double)e.GetYOffset()), s_MinZoom, s_MaxZoom);
+            m_Canvas->SetView(anchor - cursor / zoom, zoom);
+            return true;
+        });
+        dispatcher.Dispatch<Hazel::KeyPressedEvent>([this](Hazel::KeyPressedEvent& e)
+        {
+            bool control = Hazel::Input::IsKeyPressed(static_cast<int>(HZ_KEY_LEFT_CONTROL)) || Hazel::Input::IsKeyPressed(static_cast<int>(HZ_KEY_RIGHT_CONTROL));
+            bool shift = Hazel::Input::IsKeyPressed(static_cast<int>(HZ_KEY_LEFT_SHIFT)) || Hazel::Input::IsKeyPressed(static_cast<int>(HZ_KEY_RIGHT_SHIFT));
+            if (!control || m_IsDrawing)
+                return false;
+
+            // Ctrl+Z 撤销, Ctrl+Y / Ctrl+Shift+Z 重做; 按住时按重复频率连续撤销
+            if (e.GetKeyCode() == HZ_KEY_Z && !shift)
+                m_History->Undo();
+            else if (e.GetKeyCode() == HZ_KEY_Y || e.GetKeyCode() == HZ_KEY_Z)
+                m_History->Redo();
+            else
+                return false;
+            return true;
+        });
     }
 
-    void PaintStroke(float x, float y)
+private:
+    // 起点与终点相同时是单独一点, 盖一个章
+    void QueueSegment(const glm::dvec2& start, const glm::dvec2& end)
     {
-        m_Framebuffer->Bind();
-        // 注意：Input::GetMousePosition 返回的是窗口坐标，y轴向下。OpenGL 纹理坐标y轴向上。
-        // 但我们投影矩阵如果是 ortho(0, w, h, 0)，那么坐标系就和鼠标一致了。
-        
-        uint32_t width = m_Framebuffer->GetSpecification().Width;
-        uint32_t height = m_Framebuffer->GetSpecification().Height;
-
-        // 设置 Viewport 匹配 FBO
-        glViewport(0, 0, width, height);
-
-        // 使用 Shader
-        auto shader = std::dynamic_pointer_cast<Hazel::OpenGLShader>(m_BrushShader);
-        shader->Bind();
-        
-        glm::mat4 projection = glm::ortho(0.0f, (float)width, (float)height, 0.0f);
-        shader->UploadUniformMat4("projection", projection);
-        shader->UploadUniformFloat2("offset", { x, y });
-        shader->UploadUniformFloat("size", m_BrushSize);
-        shader->UploadUniformFloat3("color", m_BrushColor);
-        shader->UploadUniformInt("brushTexture", 0);
-
-        m_BrushTexture->Bind(0);
-        m_BrushVA->Bind();
-        Hazel::RenderCommand::DrawIndexed(m_BrushVA);
-
-        m_Framebuffer->Unbind();
+        m_Brush->QueueSegment(start, end, m_BrushSize, m_BrushSpacing, m_BrushColor);
     }
 
 private:
-    Hazel::Ref<Hazel::Framebuffer> m_Framebuffer;
-    Hazel::Ref<Hazel::VertexArray> m_BrushVA, m_ScreenVA;
-    Hazel::Ref<Hazel::Shader> m_BrushShader, m_ScreenShader;
-    Hazel::Ref<Hazel::Texture2D> m_BrushTexture;
+    static constexpr double s_MinZoom = 1.0 / 16.0, s_MaxZoom = 16.0;
+
+    std::unique_ptr<Hazel::TiledCanvas> m_Canvas;
+    std::unique_ptr<Hazel::CanvasHistory> m_History; // 在画布之前析构
+    std::unique_ptr<Hazel::CanvasBrush> m_Brush;
 
     bool m_IsDrawing = false;
-    double m_LastX = 0, m_LastY = 0;
+    glm::dvec2 m_LastPosition = { 0.0, 0.0 }; // 画布坐标
+
+    bool m_IsPanning = false;
+    float m_PanLastX = 0.0f, m_PanLastY = 0.0f;
     
     float m_BrushSize = 25.0f;
     float m_BrushSpacing = 2.0f;
@@ -513,7 +459,7 @@ public:
         m_Camera.LookAt(glm::vec3(0.0f));
         
         // 启用深度测试
-        glEnable(GL_DEPTH_TEST);
+        Hazel::RenderCommand::SetDepthTest(true);
     }
 
     virtual void OnUpdate(Hazel::Timestep ts) override
@@ -524,30 +470,32 @@ public:
         // 清除缓冲
         Hazel::RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
         Hazel::RenderCommand::Clear();
-        glClear(GL_DEPTH_BUFFER_BIT);
         
         // 计算剖切平面方程 (Ax + By + Cz + D = 0)
         glm::vec4 clipPlane = glm::vec4(m_ClipPlaneNormal, m_ClipPlaneDistance);
         
-        // 渲染立方体
-        auto shader = std::dynamic_pointer_cast<Hazel::OpenGLShader>(m_CrossSectionShader);
-        shader->Bind();
-        
-        // 上传 uniforms
-        shader->UploadUniformMat4("u_ViewProjection", m_Camera.GetViewProjectionMatrix());
-        shader->UploadUniformMat4("u_Transform", glm::mat4(1.0f));
-        shader->UploadUniformMat4("u_Model", glm::mat4(1.0f));
-        shader->UploadUniformFloat4("u_ClipPlane", clipPlane);
-        shader->UploadUniformFloat3("u_Color", m_CubeColor);
-        shader->UploadUniformFloat3("u_LightPos", glm::vec3(5.0f, 5.0f, 5.0f));
-        shader->UploadUniformFloat3("u_ViewPos", m_CameraPosition);
-        shader->UploadUniformInt("u_EnableClipping", m_EnableClipping ? 1 : 0);
-        shader->UploadUniformInt("u_ShowCrossSection", m_ShowCrossSection ? 1 : 0);
-        shader->UploadUniformFloat3("u_CrossSectionColor", m_CrossSectionColor);
-        
-        // 绘制立方体
-        m_CubeVA->Bind();
-        Hazel::RenderCommand::DrawIndexed(m_CubeVA);
+        // 渲染立方体 (GPU 计时: 剖切 discard 的开销)
+        {
+            Hazel::GpuPassScope cubePass(Hazel::Renderer::GetGpuProfiler(), "CrossSection Cube");
+            const auto& shader = m_CrossSectionShader;
+            shader->Bind();
+            
+            // 上传 uniforms
+            shader->SetMat4("u_ViewProjection", m_Camera.GetViewProjectionMatrix());
+            shader->SetMat4("u_Transform", glm::mat4(1.0f));
+            shader->SetMat4("u_Model", glm::mat4(1.0f));
+            shader->SetFloat4("u_ClipPlane", clipPlane);
+            shader->SetFloat3("u_Color", m_CubeColor);
+            shader->SetFloat3("u_LightPos", glm::vec3(5.0f, 5.0f, 5.0f));
+            shader->SetFloat3("u_ViewPos", m_CameraPosition);
+            shader->SetInt("u_EnableClipping", m_EnableClipping ? 1 : 0);
+            shader->SetInt("u_ShowCrossSection", m_ShowCrossSection ? 1 : 0);
+            shader->SetFloat3("u_CrossSectionColor", m_CrossSectionColor);
+            
+            // 绘制立方体
+            m_CubeVA->Bind();
+            Hazel::RenderCommand::DrawIndexed(m_CubeVA);
+        }
         
         // 如果显示剖切平面，绘制半透明平面
         if (m_ShowClipPlane)
@@ -610,6 +558,15 @@ public:
         ImGui::Text("滚轮缩放");
         ImGui::SliderFloat("旋转速度", &m_CameraRotateSpeed, 0.1f, 5.0f);
         
+        ImGui::Spacing();
+        ImGui::Separator();
+        const auto& frameStats = Hazel::FrameAllocator::GetLastFrameStatistics();
+        ImGui::Text("帧内存: %zu 字节", frameStats.BytesAllocated);
+        if (Hazel::AllocationTracker::IsEnabled())
+            ImGui::Text("堆分配: %llu 次/帧", (unsigned long long)frameStats.HeapAllocations);
+        else
+            ImGui::Text("堆分配统计未启用 (HZ_TRACK_HEAP_ALLOCATIONS)");
+        
         ImGui::End();
     }
 
@@ -668,10 +625,10 @@ private:
             20, 21, 22, 22, 23, 20   // 下面
         };
         
-        m_CubeVA.reset(Hazel::VertexArray::Create());
+        m_CubeVA = Hazel::VertexArray::Create();
         
         Hazel::Ref<Hazel::VertexBuffer> cubeVB;
-        cubeVB.reset(Hazel::VertexBuffer::Create(cubeVertices, sizeof(cubeVertices)));
+        cubeVB = Hazel::VertexBuffer::Create(cubeVertices, sizeof(cubeVertices));
         cubeVB->SetLayout({
             { Hazel::ShaderDataType::Float3, "a_Position" },
             { Hazel::ShaderDataType::Float3, "a_Normal" },
@@ -680,7 +637,7 @@ private:
         m_CubeVA->AddVertexBuffer(cubeVB);
         
         Hazel::Ref<Hazel::IndexBuffer> cubeIB;
-        cubeIB.reset(Hazel::IndexBuffer::Create(cubeIndices, sizeof(cubeIndices) / sizeof(uint32_t)));
+        cubeIB = Hazel::IndexBuffer::Create(cubeIndices, sizeof(cubeIndices) / sizeof(uint32_t));
         m_CubeVA->SetIndexBuffer(cubeIB);
     }
     
@@ -696,10 +653,10 @@ private:
         
         uint32_t planeIndices[] = { 0, 1, 2, 2, 3, 0 };
         
-        m_ClipPlaneVA.reset(Hazel::VertexArray::Create());
+        m_ClipPlaneVA = Hazel::VertexArray::Create();
         
         Hazel::Ref<Hazel::VertexBuffer> planeVB;
-        planeVB.reset(Hazel::VertexBuffer::Create(planeVertices, sizeof(planeVertices)));
+        planeVB = Hazel::VertexBuffer::Create(planeVertices, sizeof(planeVertices));
         planeVB->SetLayout({
             { Hazel::ShaderDataType::Float3, "a_Position" },
             { Hazel::ShaderDataType::Float3, "a_Normal" },
@@ -708,45 +665,47 @@ private:
         m_ClipPlaneVA->AddVertexBuffer(planeVB);
         
         Hazel::Ref<Hazel::IndexBuffer> planeIB;
-        planeIB.reset(Hazel::IndexBuffer::Create(planeIndices, 6));
+        planeIB = Hazel::IndexBuffer::Create(planeIndices, 6);
         m_ClipPlaneVA->SetIndexBuffer(planeIB);
     }
     
     void RenderClipPlane()
     {
+        // GPU 计时: 半透明剖切面混合的开销
+        Hazel::GpuPassScope planePass(Hazel::Renderer::GetGpuProfiler(), "Clip Plane Blend");
+
         // 启用混合以显示半透明平面
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glDisable(GL_CULL_FACE);
+        Hazel::RenderCommand::SetBlend(true);
+        Hazel::RenderCommand::SetCullFace(false);
         
-        auto shader = std::dynamic_pointer_cast<Hazel::OpenGLShader>(m_CrossSectionShader);
+        const auto& shader = m_CrossSectionShader;
         shader->Bind();
         
         // 计算剖切平面的变换矩阵
         glm::mat4 planeTransform = CalculatePlaneTransform();
         
-        shader->UploadUniformMat4("u_ViewProjection", m_Camera.GetViewProjectionMatrix());
-        shader->UploadUniformMat4("u_Transform", planeTransform);
-        shader->UploadUniformMat4("u_Model", planeTransform);
-        shader->UploadUniformFloat4("u_ClipPlane", glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
-        shader->UploadUniformFloat3("u_Color", glm::vec3(1.0f, 1.0f, 0.0f));
-        shader->UploadUniformFloat3("u_LightPos", glm::vec3(5.0f, 5.0f, 5.0f));
-        shader->UploadUniformFloat3("u_ViewPos", m_CameraPosition);
-        shader->UploadUniformInt("u_EnableClipping", 0);
-        shader->UploadUniformInt("u_ShowCrossSection", 0);
-        shader->UploadUniformFloat3("u_CrossSectionColor", m_CrossSectionColor);
+        shader->SetMat4("u_ViewProjection", m_Camera.GetViewProjectionMatrix());
+        shader->SetMat4("u_Transform", planeTransform);
+        shader->SetMat4("u_Model", planeTransform);
+        shader->SetFloat4("u_ClipPlane", glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+        shader->SetFloat3("u_Color", glm::vec3(1.0f, 1.0f, 0.0f));
+        shader->SetFloat3("u_LightPos", glm::vec3(5.0f, 5.0f, 5.0f));
+        shader->SetFloat3("u_ViewPos", m_CameraPosition);
+        shader->SetInt("u_EnableClipping", 0);
+        shader->SetInt("u_ShowCrossSection", 0);
+        shader->SetFloat3("u_CrossSectionColor", m_CrossSectionColor);
         
         // 修改片段着色器输出的 alpha 值（需要在着色器中处理，或者直接设置固定alpha）
         m_ClipPlaneVA->Bind();
         
         // 临时修改颜色使其半透明
-        glEnable(GL_DEPTH_TEST);
-        glDepthMask(GL_FALSE); // 不写入深度
+        Hazel::RenderCommand::SetDepthTest(true);
+        Hazel::RenderCommand::SetDepthWrite(false); // 不写入深度
         Hazel::RenderCommand::DrawIndexed(m_ClipPlaneVA);
-        glDepthMask(GL_TRUE);
+        Hazel::RenderCommand::SetDepthWrite(true);
         
-        glDisable(GL_BLEND);
-        glEnable(GL_CULL_FACE);
+        Hazel::RenderCommand::SetBlend(false);
+        Hazel::RenderCommand::SetCullFace(true);
     }
     
     glm::mat4 CalculatePlaneTransform()
@@ -801,13 +760,19 @@ private:
                 
                 m_LastMouseX = x;
                 m_LastMouseY = y;
-                
-                UpdateCameraPosition();
             }
+
+            // 这一帧录制完, 下一帧渲染, 再下一次交换才显示, 大约在两帧之后. 按光标采样的速度
+            // 预测那时的光标位置先转过去, 预测量不累计到角度里, 下一帧按真实位置重新算
+            const auto& timing = Hazel::Application::Get().GetFrameTiming();
+            float predictedX = x, predictedY = y;
+            Hazel::Application::Get().GetInputHistory().PredictCursor(timing.Time + 2.0 * timing.SmoothedDeltaTime, predictedX, predictedY);
+            UpdateCameraPosition((predictedX - x) * m_CameraRotateSpeed * 0.1f, -(predictedY - y) * m_CameraRotateSpeed * 0.1f);
         }
-        else
+        else if (m_IsRotating)
         {
             m_IsRotating = false;
+            UpdateCameraPosition(); // 去掉最后一帧的预测量
         }
         
         // 滚轮缩放（需要在 Event 中处理，这里简化为键盘）
@@ -816,20 +781,24 @@ private:
             m_CameraDistance -= 2.0f * ts;
             if (m_CameraDistance < 1.0f) m_CameraDistance = 1.0f;
             UpdateCameraPosition();
+            // 按住期间持续缩放, 按需渲染模式下需要主动请求下一帧
+            Hazel::Application::Get().RequestRedraw();
         }
         if (Hazel::Input::IsKeyPressed(static_cast<int>(HZ_KEY_E)))
         {
             m_CameraDistance += 2.0f * ts;
             if (m_CameraDistance > 20.0f) m_CameraDistance = 20.0f;
             UpdateCameraPosition();
+            Hazel::Application::Get().RequestRedraw();
         }
     }
     
-    void UpdateCameraPosition()
+    // 偏移量只用于这一帧的显示, 不改变 m_CameraYaw / m_CameraPitch
+    void UpdateCameraPosition(float yawOffset = 0.0f, float pitchOffset = 0.0f)
     {
         // 球坐标转换为笛卡尔坐标
-        float yawRad = glm::radians(m_CameraYaw);
-        float pitchRad = glm::radians(m_CameraPitch);
+        float yawRad = glm::radians(m_CameraYaw + yawOffset);
+        float pitchRad = glm::radians(std::clamp(m_CameraPitch + pitchOffset, -89.0f, 89.0f));
         
         m_CameraPosition.x = m_CameraDistance * cos(pitchRad) * cos(yawRad);
         m_CameraPosition.y = m_CameraDistance * sin(pitchRad);
@@ -867,14 +836,32 @@ private:
     glm::vec3 m_CrossSectionColor = glm::vec3(1.0f, 0.8f, 0.2f);
 };
 
+static Hazel::ApplicationSpecification CreateSandboxSpecification()
+{
+    Hazel::ApplicationSpecification spec;
+    spec.Name = "Sandbox";
+    // 渲染线程执行第 N 帧的同时，主线程录制第 N+1 帧
+    spec.Rendering.Threading = Hazel::RenderThreadingPolicy::MultiThreaded;
+    spec.Rendering.MaxFramesInFlight = 2;
+    // 画面无变化时不渲染, 只在输入/动画/异步加载完成时重绘; 窗口失焦时限制到 10 fps
+    spec.RenderOnDemand = true;
+    spec.BackgroundFrameRate = 10.0;
+    return spec;
+}
+
 class Sandbox : public Hazel::Application
 {
 public:
     Sandbox()
+        : Hazel::Application(CreateSandboxSpecification())
     {
         // PushLayer(new ExampleLayer());
         // PushLayer(new BrushLayer());
         PushLayer(new CrossSectionLayer());
+        // 设置了环境变量 SANDBOX_FRAME_STATS (CSV 路径) 时, 退出时把逐帧统计写入该文件,
+        // 便于对比渲染路径的改动; 默认只在界面上显示
+        const char* statsFilepath = std::getenv("SANDBOX_FRAME_STATS");
+        PushOverLayer(new Hazel::ProfilerLayer(statsFilepath ? statsFilepath : ""));
     }
 
     ~Sandbox()
@@ -0,0 +1,606 @@
+// Offline cross-section renderer: cuts a mesh with each plane in turn and writes one PNG per
+// section, so section images of a part no longer have to be captured from the Sandbox by hand.
+//
+//   HazelSection <mesh.obj|mesh.stl> [--out dir] [--size WxH]
+//                [--plane nx,ny,nz,d]... [--planes file] [--sweep x|y|z|nx,ny,nz N]
+//                [--camera x,y,z] [--target x,y,z] [--level N]
+//                [--context native|egl|osmesa] [--threaded]
+//
+// A plane keeps the side where dot(n, p) + d >= 0, in model units. A planes file holds one
+// "nx ny nz d" per line; --sweep spreads N planes with that normal evenly across the mesh.
+//
+// Runs as a headless Application, one section per frame into an offscreen framebuffer. The
+// readback goes through the framebuffer's PBO ring, so the GPU stays a few sections ahead of
+// the copies, and PNG encoding runs on the JobSystem workers while later sections render.
+
+#include "Hazel/Core/Application.h"
+#include "Hazel/Core/JobSystem.h"
+#include "Hazel/Core/Layer.h"
+#include "Hazel/Core/Log.h"
+#include "Hazel/Renderer/Framebuffer.h"
+#include "Hazel/Renderer/PerspectiveCamera.h"
+#include "Hazel/Renderer/RenderCommand.h"
+#include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/Shader.h"
+#include "Hazel/Renderer/VertexArray.h"
+
+#include "PngWriter.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef HZ_SECTION_ASSET_DIR
+    #define HZ_SECTION_ASSET_DIR "assets"
+#endif
+
+using namespace Hazel;
+
+struct SectionOptions
+{
+    std::string MeshPath;
+    std::string OutputDir = "sections";
+    uint32_t Width = 1920, Height = 1080;
+
+    // (normal, d) in model units
+    std::vector<glm::vec4> Planes;
+    std::string PlanesPath;
+    glm::vec3 SweepNormal = glm::vec3(0.0f);
+    uint32_t SweepCount = 0;
+
+    bool HasCamera = false, HasTarget = false;
+    glm::vec3 CameraPosition = glm::vec3(0.0f), CameraTarget = glm::vec3(0.0f);
+
+    int CompressionLevel = 1;
+    HeadlessContextAPI ContextAPI = HeadlessContextAPI::Auto;
+    bool Threaded = false;
+};
+
+// ---- Mesh ------------------------------------------------------------------
+
+// Flat shaded triangle soup in the CrossSection.glsl layout (position, normal, texcoord)
+struct Mesh
+{
+    std::vector<float> Vertices;
+    glm::vec3 Min = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 Max = glm::vec3(-std::numeric_limits<float>::max());
+
+    uint32_t GetVertexCount() const { return (uint32_t)(Vertices.size() / 8); }
+};
+
+static void AddTriangle(Mesh& mesh, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+{
+    glm::vec3 normal = glm::cross(b - a, c - a);
+    float length = glm::length(normal);
+    normal = length > 0.0f ? normal / length : glm::vec3(0.0f, 0.0f, 1.0f);
+
+    for (const glm::vec3& p : { a, b, c })
+    {
+        mesh.Vertices.insert(mesh.Vertices.end(), { p.x, p.y, p.z, normal.x, normal.y, normal.z, 0.0f, 0.0f });
+        mesh.Min = glm::min(mesh.Min, p);
+        mesh.Max = glm::max(mesh.Max, p);
+    }
+}
+
+// Positions and faces only; polygons are fanned into triangles
+static bool LoadObj(const std::string& path, Mesh& mesh)
+{
+    std::ifstream in(path);
+    if (!in)
+        return false;
+
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> face;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.compare(0, 2, "v ") == 0)
+        {
+            glm::vec3& p = positions.emplace_back(0.0f);
+            std::sscanf(line.c_str() + 2, "%f %f %f", &p.x, &p.y, &p.z);
+        }
+        else if (line.compare(0, 2, "f ") == 0)
+        {
+            face.clear();
+            std::istringstream tokens(line.substr(2));
+            std::string token;
+            while (tokens >> token)
+            {
+                // v, v/vt, v//vn or v/vt/vn; negative indices count back from the last vertex
+                long index = std::atol(token.c_str());
+                long resolved = index < 0 ? (long)positions.size() + index : index - 1;
+                if (index == 0 || resolved < 0 || resolved >= (long)positions.size())
+                {
+                    HZ_ERROR("HazelSection: '{0}' has a face with an invalid vertex index", path);
+                    return false;
+                }
+                face.push_back((uint32_t)resolved);
+            }
+
+            for (size_t i = 2; i < face.size(); i++)
+                AddTriangle(mesh, positions[face[0]], positions[face[i - 1]], positions[face[i]]);
+        }
+    }
+    return true;
+}
+
+// Binary or ASCII; facet normals are recomputed from the winding
+static bool LoadStl(const std::string& path, Mesh& mesh)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        return false;
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    // ASCII files also start with "solid", the size is the reliable test
+    uint32_t triangleCount = 0;
+    if (data.size() >= 84)
+        std::memcpy(&triangleCount, &data[80], sizeof(uint32_t));
+    if (data.size() >= 84 && data.size() == 84 + (size_t)triangleCount * 50)
+    {
+        for (uint32_t i = 0; i < triangleCount; i++)
+        {
+            float v[9];
+            std::memcpy(v, &data[84 + (size_t)i * 50 + 12], sizeof(v));
+            AddTriangle(mesh, { v[0], v[1], v[2] }, { v[3], v[4], v[5] }, { v[6], v[7], v[8] });
+        }
+        return true;
+    }
+
+    std::istringstream tokens(std::string(data.begin(), data.end()));
+    std::string token;
+    glm::vec3 corners[3];
+    uint32_t corner = 0;
+    while (tokens >> token)
+    {
+        if (token != "vertex")
+            continue;
+
+        glm::vec3& p = corners[corner++];
+        tokens >> p.x >> p.y >> p.z;
+        if (corner == 3)
+        {
+            AddTriangle(mesh, corners[0], corners[1], corners[2]);
+            corner = 0;
+        }
+    }
+    return true;
+}
+
+static bool LoadMesh(const std::string& path, Mesh& mesh)
+{
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+
+    if (extension != ".obj" && extension != ".stl")
+    {
+        HZ_ERROR("HazelSection: '{0}' is not an .obj or .stl file", path);
+        return false;
+    }
+
+    if (!(extension == ".obj" ? LoadObj(path, mesh) : LoadStl(path, mesh)))
+    {
+        HZ_ERROR("HazelSection: could not read '{0}'", path);
+        return false;
+    }
+    if (mesh.Vertices.empty())
+    {
+        HZ_ERROR("HazelSection: '{0}' has no triangles", path);
+        return false;
+    }
+    return true;
+}
+
+// ---- Planes ----------------------------------------------------------------
+
+static bool ParseFloats(std::string text, float* values, int count)
+{
+    std::replace(text.begin(), text.end(), ',', ' ');
+    std::istringstream in(text);
+    for (int i = 0; i < count; i++)
+    {
+        if (!(in >> values[i]))
+            return false;
+    }
+    return true;
+}
+
+static bool NormalizePlane(glm::vec4& plane)
+{
+    float length = glm::length(glm::vec3(plane));
+    if (length == 0.0f)
+        return false;
+    plane /= length;
+    return true;
+}
+
+static bool LoadPlanes(const std::string& path, std::vector<glm::vec4>& planes)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        HZ_ERROR("HazelSection: could not read '{0}'", path);
+        return false;
+    }
+
+    std::string line;
+    for (uint32_t lineNumber = 1; std::getline(in, line); lineNumber++)
+    {
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#')
+            continue;
+
+        glm::vec4 plane;
+        if (!ParseFloats(line, &plane.x, 4) || !NormalizePlane(plane))
+        {
+            HZ_ERROR("HazelSection: {0}:{1}: expected \"nx ny nz d\" with a non-zero normal", path, lineNumber);
+            return false;
+        }
+        planes.push_back(plane);
+    }
+    return true;
+}
+
+// Planes at the centers of count equal slabs between the extreme corners of the bounds
+static void AddSweep(const Mesh& mesh, const glm::vec3& normal, uint32_t count, std::vector<glm::vec4>& planes)
+{
+    glm::vec3 n = glm::normalize(normal);
+    float lo = std::numeric_limits<float>::max(), hi = -std::numeric_limits<float>::max();
+    for (int corner = 0; corner < 8; corner++)
+    {
+        glm::vec3 p = { corner & 1 ? mesh.Max.x : mesh.Min.x, corner & 2 ? mesh.Max.y : mesh.Min.y, corner & 4 ? mesh.Max.z : mesh.Min.z };
+        lo = std::min(lo, glm::dot(n, p));
+        hi = std::max(hi, glm::dot(n, p));
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        float offset = lo + (hi - lo) * (i + 0.5f) / count;
+        planes.push_back(glm::vec4(n, -offset));
+    }
+}
+
+// ---- Renderer --------------------------------------------------------------
+
+class SectionRenderLayer : public Layer
+{
+public:
+    SectionRenderLayer(const SectionOptions& options, Mesh&& mesh, std::vector<glm::vec4>&& planes)
+        : Layer("SectionRender"), m_Options(options), m_Mesh(std::move(mesh)), m_Planes(std::move(planes)),
+          m_Camera(45.0f, (float)options.Width / (float)options.Height, 0.1f, 100.0f)
+    {
+    }
+
+    virtual void OnAttach() override
+    {
+        // Drawn scaled into the unit sphere, so the shader's cut-edge band and the default camera
+        // suit any model size. Planes and camera positions are converted from model units.
+        m_Center = (m_Mesh.Min + m_Mesh.Max) * 0.5f;
+        float radius = std::max(glm::length(m_Mesh.Max - m_Mesh.Min) * 0.5f, 1e-6f);
+        m_Scale = 1.0f / radius;
+        m_Model = glm::scale(glm::mat4(1.0f), glm::vec3(m_Scale)) * glm::translate(glm::mat4(1.0f), -m_Center);
+
+        m_CameraPosition = m_Options.HasCamera ? ToUnitSpace(m_Options.CameraPosition) : glm::normalize(glm::vec3(1.0f, 0.8f, 1.2f)) * 2.8f;
+        glm::vec3 target = m_Options.HasTarget ? ToUnitSpace(m_Options.CameraTarget) : glm::vec3(0.0f);
+        float distance = glm::length(m_CameraPosition - target);
+        m_Camera.SetProjection(45.0f, (float)m_Options.Width / (float)m_Options.Height, std::max(distance - 1.0f, 0.0f) * 0.5f + 0.01f, distance + 2.0f);
+        m_Camera.SetPosition(m_CameraPosition);
+        m_Camera.LookAt(target);
+
+        uint32_t vertexCount = m_Mesh.GetVertexCount();
+        std::vector<uint32_t> indices(vertexCount);
+        for (uint32_t i = 0; i < vertexCount; i++)
+            indices[i] = i;
+
+        m_MeshVA = VertexArray::Create();
+        Ref<VertexBuffer> vertexBuffer = VertexBuffer::Create(m_Mesh.Vertices.data(), (uint32_t)(m_Mesh.Vertices.size() * sizeof(float)));
+        vertexBuffer->SetLayout({
+            { ShaderDataType::Float3, "a_Position" },
+            { ShaderDataType::Float3, "a_Normal" },
+            { ShaderDataType::Float2, "a_TexCoord" }
+        });
+        m_MeshVA->AddVertexBuffer(vertexBuffer);
+        m_MeshVA->SetIndexBuffer(IndexBuffer::Create(indices.data(), vertexCount));
+
+        m_Shader = Shader::Create(HZ_SECTION_ASSET_DIR "/shaders/CrossSection.glsl");
+
+        FramebufferSpecification fbSpec;
+        fbSpec.Width = m_Options.Width;
+        fbSpec.Height = m_Options.Height;
+        fbSpec.Attachments = { FramebufferTextureFormat::RGBA8, FramebufferTextureFormat::Depth };
+        m_Framebuffer = Framebuffer::Create(fbSpec);
+
+        // The cut opens the mesh: its inside has to show
+        RenderCommand::SetDepthTest(true);
+        RenderCommand::SetCullFace(false);
+
+        // Every image in flight holds a full frame of pixels until it is written
+        m_MaxImagesInFlight = JobSystem::GetThreadCount() * 2 + 2;
+
+        HZ_INFO("HazelSection: {0} triangles, {1} sections at {2}x{3} into '{4}'",
+                vertexCount / 3, m_Planes.size(), m_Options.Width, m_Options.Height, m_Options.OutputDir);
+        m_StartTime = std::chrono::steady_clock::now();
+    }
+
+    virtual void OnUpdate(Timestep ts) override
+    {
+        if (m_Finished)
+            return;
+
+        // Encoding fell behind: help the workers until there is room for one more frame,
+        // rather than draining every encode and leaving the GPU idle meanwhile. Images still
+        // being read back aren't queued yet; they need the frame to go on.
+        while (m_ImagesInFlight.load(std::memory_order_acquire) >= m_MaxImagesInFlight && !m_EncodeCounter.IsDone())
+        {
+            if (!JobSystem::RunPendingJob())
+                std::this_thread::yield();
+        }
+
+        if (m_NextSection < m_Planes.size())
+            RenderSection(m_NextSection++);
+
+        if (m_ImagesWritten.load(std::memory_order_acquire) == m_Planes.size())
+            Finish();
+    }
+
+    uint32_t GetFailedCount() const { return m_Failed.load(); }
+private:
+    glm::vec3 ToUnitSpace(const glm::vec3& p) const { return (p - m_Center) * m_Scale; }
+
+    void RenderSection(uint32_t index)
+    {
+        // p = (q - center) * scale: dot(n, q) + d = 0 becomes dot(n, p) + (dot(n, center) + d) * scale = 0
+        const glm::vec4& plane = m_Planes[index];
+        glm::vec4 clipPlane = glm::vec4(glm::vec3(plane), (glm::dot(glm::vec3(plane), m_Center) + plane.w) * m_Scale);
+
+        m_Framebuffer->Bind();
+        RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
+        RenderCommand::Clear();
+
+        m_Shader->Bind();
+        m_Shader->SetMat4("u_ViewProjection", m_Camera.GetViewProjectionMatrix());
+        m_Shader->SetMat4("u_Transform", m_Model);
+        m_Shader->SetMat4("u_Model", m_Model);
+        m_Shader->SetFloat3("u_LightPos", glm::vec3(5.0f, 5.0f, 5.0f));
+        m_Shader->SetFloat3("u_ViewPos", m_CameraPosition);
+        m_Shader->SetFloat4("u_ClipPlane", clipPlane);
+        m_Shader->SetFloat3("u_Color", glm::vec3(0.3f, 0.6f, 0.9f));
+        m_Shader->SetInt("u_EnableClipping", 1);
+        m_Shader->SetInt("u_ShowCrossSection", 1);
+        m_Shader->SetFloat3("u_CrossSectionColor", glm::vec3(1.0f, 0.8f, 0.2f));
+
+        m_MeshVA->Bind();
+        RenderCommand::DrawIndexed(m_MeshVA);
+
+        m_ImagesInFlight.fetch_add(1, std::memory_order_relaxed);
+        FramebufferRect rect;
+        rect.Width = m_Options.Width;
+        rect.Height = m_Options.Height;
+        m_Framebuffer->ReadPixelsBufferAsync(0, rect, [this, index](std::vector<uint8_t>&& pixels, const FramebufferRect& rect)
+        {
+            QueueEncode(index, std::move(pixels), rect);
+        });
+
+        m_Framebuffer->Unbind();
+    }
+
+    // Main thread, from the readback callback; the encode job takes the pixels over
+    void QueueEncode(uint32_t index, std::vector<uint8_t>&& pixels, const FramebufferRect& rect)
+    {
+        auto image = std::make_shared<std::vector<uint8_t>>(std::move(pixels));
+
+        JobSystem::Schedule([this, index, rect, image]()
+        {
+            char name[32];
+            std::snprintf(name, sizeof(name), "section_%04u.png", index);
+            std::string path = (std::filesystem::path(m_Options.OutputDir) / name).string();
+
+            PngWriter::Options pngOptions;
+            pngOptions.FlipVertically = true;
+            pngOptions.DropAlpha = true;
+            pngOptions.CompressionLevel = m_Options.CompressionLevel;
+            if (!PngWriter::Write(path, image->data(), rect.Width, rect.Height, 4, pngOptions))
+            {
+                HZ_ERROR("HazelSection: could not write '{0}'", path);
+                m_Failed.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            m_ImagesInFlight.fetch_sub(1, std::memory_order_relaxed);
+            m_ImagesWritten.fetch_add(1, std::memory_order_release);
+        }, &m_EncodeCounter);
+    }
+
+    void Finish()
+    {
+        JobSystem::Wait(m_EncodeCounter);
+        m_Finished = true;
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_StartTime).count();
+        HZ_INFO("HazelSection: {0} sections in {1:.2f}s ({2:.0f} per minute), {3} failed",
+                m_Planes.size(), seconds, seconds > 0.0 ? m_Planes.size() * 60.0 / seconds : 0.0, m_Failed.load());
+
+        Application::Get().Close();
+    }
+private:
+    const SectionOptions& m_Options;
+    Mesh m_Mesh;
+    std::vector<glm::vec4> m_Planes;
+
+    glm::vec3 m_Center = glm::vec3(0.0f);
+    float m_Scale = 1.0f;
+    glm::mat4 m_Model = glm::mat4(1.0f);
+
+    PerspectiveCamera m_Camera;
+    glm::vec3 m_CameraPosition = glm::vec3(0.0f);
+
+    Ref<Shader> m_Shader;
+    Ref<VertexArray> m_MeshVA;
+    Ref<Framebuffer> m_Framebuffer;
+
+    uint32_t m_NextSection = 0;
+    uint32_t m_MaxImagesInFlight = 0;
+    // Rendered but not yet written; counted from the readback request
+    std::atomic<uint32_t> m_ImagesInFlight{ 0 };
+    std::atomic<uint32_t> m_ImagesWritten{ 0 };
+    std::atomic<uint32_t> m_Failed{ 0 };
+    JobCounter m_EncodeCounter;
+
+    std::chrono::steady_clock::time_point m_StartTime;
+    bool m_Finished = false;
+};
+
+// ---- Command line ----------------------------------------------------------
+
+static bool ParseOptions(int argc, char** argv, SectionOptions& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        auto takesValue = [&]() { if (!value) return false; i++; return true; };
+
+        if (std::strcmp(arg, "--out") == 0 && takesValue())
+            options.OutputDir = value;
+        else if (std::strcmp(arg, "--size") == 0 && takesValue())
+        {
+            if (std::sscanf(value, "%ux%u", &options.Width, &options.Height) != 2 || !options.Width || !options.Height)
+                return false;
+        }
+        else if (std::strcmp(arg, "--plane") == 0 && takesValue())
+        {
+            glm::vec4 plane;
+            if (!ParseFloats(value, &plane.x, 4) || !NormalizePlane(plane))
+                return false;
+            options.Planes.push_back(plane);
+        }
+        else if (std::strcmp(arg, "--planes") == 0 && takesValue())
+            options.PlanesPath = value;
+        else if (std::strcmp(arg, "--sweep") == 0 && takesValue())
+        {
+            if (std::strcmp(value, "x") == 0)
+                options.SweepNormal = { 1.0f, 0.0f, 0.0f };
+            else if (std::strcmp(value, "y") == 0)
+                options.SweepNormal = { 0.0f, 1.0f, 0.0f };
+            else if (std::strcmp(value, "z") == 0)
+                options.SweepNormal = { 0.0f, 0.0f, 1.0f };
+            else if (!ParseFloats(value, &options.SweepNormal.x, 3) || glm::length(options.SweepNormal) == 0.0f)
+                return false;
+
+            const char* count = i + 1 < argc ? argv[++i] : nullptr;
+            if (!count || std::atoi(count) <= 0)
+                return false;
+            options.SweepCount = (uint32_t)std::atoi(count);
+        }
+        else if (std::strcmp(arg, "--camera") == 0 && takesValue())
+        {
+            if (!ParseFloats(value, &options.CameraPosition.x, 3))
+                return false;
+            options.HasCamera = true;
+        }
+        else if (std::strcmp(arg, "--target") == 0 && takesValue())
+        {
+            if (!ParseFloats(value, &options.CameraTarget.x, 3))
+                return false;
+            options.HasTarget = true;
+        }
+        else if (std::strcmp(arg, "--level") == 0 && takesValue())
+            options.CompressionLevel = std::clamp(std::atoi(value), 1, 9);
+        else if (std::strcmp(arg, "--context") == 0 && takesValue())
+        {
+            if (std::strcmp(value, "native") == 0)
+                options.ContextAPI = HeadlessContextAPI::Native;
+            else if (std::strcmp(value, "egl") == 0)
+                options.ContextAPI = HeadlessContextAPI::EGL;
+            else if (std::strcmp(value, "osmesa") == 0)
+                options.ContextAPI = HeadlessContextAPI::OSMesa;
+            else
+                return false;
+        }
+        else if (std::strcmp(arg, "--threaded") == 0)
+            options.Threaded = true;
+        else if (arg[0] != '-' && options.MeshPath.empty())
+            options.MeshPath = arg;
+        else
+            return false;
+    }
+    return !options.MeshPath.empty();
+}
+
+static int Run(int argc, char** argv)
+{
+    SectionOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        printf("usage: HazelSection <mesh.obj|mesh.stl> [--out dir] [--size WxH]\n"
+               "                    [--plane nx,ny,nz,d]... [--planes file] [--sweep x|y|z|nx,ny,nz N]\n"
+               "                    [--camera x,y,z] [--target x,y,z] [--level N]\n"
+               "                    [--context native|egl|osmesa] [--threaded]\n");
+        return 1;
+    }
+
+    Mesh mesh;
+    if (!LoadMesh(options.MeshPath, mesh))
+        return 1;
+
+    std::vector<glm::vec4> planes = options.Planes;
+    if (!options.PlanesPath.empty() && !LoadPlanes(options.PlanesPath, planes))
+        return 1;
+    if (options.SweepCount)
+        AddSweep(mesh, options.SweepNormal, options.SweepCount, planes);
+    if (planes.empty())
+    {
+        HZ_ERROR("HazelSection: no planes, use --plane, --planes or --sweep");
+        return 1;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(options.OutputDir, error);
+    if (error)
+    {
+        HZ_ERROR("HazelSection: could not create '{0}': {1}", options.OutputDir, error.message());
+        return 1;
+    }
+
+    ApplicationSpecification specification;
+    specification.Name = "HazelSection";
+    specification.WindowWidth = options.Width;
+    specification.WindowHeight = options.Height;
+    specification.Headless = true;
+    specification.ContextAPI = options.ContextAPI;
+    specification.Rendering.Threading = options.Threaded ? RenderThreadingPolicy::MultiThreaded : RenderThreadingPolicy::SingleThreaded;
+
+    uint32_t failed = 0;
+    {
+        Application app(specification);
+        SectionRenderLayer* layer = new SectionRenderLayer(options, std::move(mesh), std::move(planes));
+        app.PushLayer(layer);
+        app.Run();
+        failed = layer->GetFailedCount();
+    }
+
+    return failed == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv)
+{
+    Log::Init();
+    int result = Run(argc, argv);
+    // Async logging: flushes the tail of the queue, the errors of a failed run included
+    Log::Shutdown();
+    return result;
+}
@@ -0,0 +1,141 @@
+#include "PngWriter.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+
+#ifdef HZ_HAVE_ZLIB
+    #include <zlib.h>
+#endif
+
+namespace PngWriter {
+
+    static const uint8_t s_Signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+
+    static uint32_t UpdateCrc(uint32_t crc, const uint8_t* data, size_t size)
+    {
+        static const std::array<uint32_t, 256> table = []()
+        {
+            std::array<uint32_t, 256> result;
+            for (uint32_t n = 0; n < 256; n++)
+            {
+                uint32_t c = n;
+                for (int k = 0; k < 8; k++)
+                    c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+                result[n] = c;
+            }
+            return result;
+        }();
+
+        for (size_t i = 0; i < size; i++)
+            crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+        return crc;
+    }
+
+    static void PutU32(std::vector<uint8_t>& out, uint32_t value)
+    {
+        out.insert(out.end(), { (uint8_t)(value >> 24), (uint8_t)(value >> 16), (uint8_t)(value >> 8), (uint8_t)value });
+    }
+
+    static void WriteChunk(std::vector<uint8_t>& out, const char* type, const uint8_t* data, size_t size)
+    {
+        PutU32(out, (uint32_t)size);
+        size_t start = out.size();
+        out.insert(out.end(), type, type + 4);
+        out.insert(out.end(), data, data + size);
+        PutU32(out, UpdateCrc(0xffffffffu, out.data() + start, size + 4) ^ 0xffffffffu);
+    }
+
+    static void Deflate(const std::vector<uint8_t>& data, int level, std::vector<uint8_t>& out)
+    {
+#ifdef HZ_HAVE_ZLIB
+        uLongf size = compressBound((uLong)data.size());
+        out.resize(size);
+        compress2(out.data(), &size, data.data(), (uLong)data.size(), level);
+        out.resize(size);
+#else
+        // zlib stream of stored blocks
+        out.clear();
+        out.reserve(data.size() + data.size() / 65535 * 5 + 16);
+        out.insert(out.end(), { 0x78, 0x01 });
+
+        size_t offset = 0;
+        do
+        {
+            uint16_t blockSize = (uint16_t)std::min<size_t>(data.size() - offset, 65535);
+            bool last = offset + blockSize == data.size();
+            out.insert(out.end(), { (uint8_t)(last ? 1 : 0),
+                                    (uint8_t)blockSize, (uint8_t)(blockSize >> 8),
+                                    (uint8_t)~blockSize, (uint8_t)(~blockSize >> 8) });
+            out.insert(out.end(), data.begin() + offset, data.begin() + offset + blockSize);
+            offset += blockSize;
+        } while (offset < data.size());
+
+        uint32_t a = 1, b = 0;
+        for (uint8_t byte : data)
+        {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+        PutU32(out, (b << 16) | a);
+#endif
+    }
+
+    void Encode(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+                const Options& options, std::vector<uint8_t>& out)
+    {
+        uint32_t outChannels = options.DropAlpha && channels == 4 ? 3 : channels;
+        size_t rowSize = (size_t)width * outChannels;
+
+        // Every scanline gets the Sub filter: cheap, and flat shaded renders turn into long
+        // runs of zeros
+        std::vector<uint8_t> filtered((rowSize + 1) * height);
+        for (uint32_t y = 0; y < height; y++)
+        {
+            const uint8_t* src = pixels + (size_t)(options.FlipVertically ? height - 1 - y : y) * width * channels;
+            uint8_t* dst = &filtered[(rowSize + 1) * y];
+            *dst++ = 1;
+
+            uint8_t previous[4] = {};
+            for (uint32_t x = 0; x < width; x++, src += channels)
+            {
+                for (uint32_t c = 0; c < outChannels; c++)
+                {
+                    *dst++ = (uint8_t)(src[c] - previous[c]);
+                    previous[c] = src[c];
+                }
+            }
+        }
+
+        std::vector<uint8_t> compressed;
+        Deflate(filtered, options.CompressionLevel, compressed);
+
+        uint8_t header[13] = {};
+        header[0] = (uint8_t)(width >> 24); header[1] = (uint8_t)(width >> 16); header[2] = (uint8_t)(width >> 8); header[3] = (uint8_t)width;
+        header[4] = (uint8_t)(height >> 24); header[5] = (uint8_t)(height >> 16); header[6] = (uint8_t)(height >> 8); header[7] = (uint8_t)height;
+        header[8] = 8;                            // Bit depth
+        header[9] = outChannels == 4 ? 6 : 2;     // RGBA / RGB
+
+        out.clear();
+        out.reserve(sizeof(s_Signature) + compressed.size() + 64);
+        out.insert(out.end(), s_Signature, s_Signature + sizeof(s_Signature));
+        WriteChunk(out, "IHDR", header, sizeof(header));
+        WriteChunk(out, "IDAT", compressed.data(), compressed.size());
+        WriteChunk(out, "IEND", nullptr, 0);
+    }
+
+    bool Write(const std::string& path, const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+               const Options& options)
+    {
+        std::vector<uint8_t> encoded;
+        Encode(pixels, width, height, channels, options, encoded);
+
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file)
+            return false;
+
+        bool written = std::fwrite(encoded.data(), 1, encoded.size(), file) == encoded.size();
+        return std::fclose(file) == 0 && written;
+    }
+
+}
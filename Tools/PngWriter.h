@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Minimal encoder for 8-bit RGB/RGBA PNGs. Image data is deflated with zlib when it was found
+// at configure time (HZ_HAVE_ZLIB) and stored uncompressed otherwise, which is still a valid
+// PNG, just a large one.
+namespace PngWriter {
+
+    struct Options
+    {
+        // Framebuffer readbacks come bottom-up
+        bool FlipVertically = false;
+        // Write RGB from RGBA pixels
+        bool DropAlpha = false;
+        // zlib level, 1 (fastest) to 9; encoding time dominates batch renders, not disk
+        int CompressionLevel = 1;
+    };
+
+    // channels: 3 or 4
+    void Encode(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+                const Options& options, std::vector<uint8_t>& out);
+
+    bool Write(const std::string& path, const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+               const Options& options = Options());
+
+}